@@ -492,7 +492,7 @@ namespace libargvcodec
 
     /// <summary>Returns the list of configured prefixes.</summary>
     /// <returns>Returns the list of configured prefixes.</returns>
-    const StringList & getOptionPrefixes();
+    const StringList & getOptionPrefixes() const;
 
     /// <summary>Add the given prefix to the list of configured prefixes.</summary>
     /// <param name="iValue">A new argument option prefix. ie "-", "--" or "/"</param>
@@ -511,6 +511,7 @@ namespace libargvcodec
 
     void rebuildArgv();
     char** mArgv;
+    size_t mArgvCapacity;
     bool isValid(int iIndex) const;
     static std::string equalize(const std::string & iValue);
     static std::string equalize(const char * iValue);
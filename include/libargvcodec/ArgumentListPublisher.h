@@ -0,0 +1,72 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef ARGUMENTLISTPUBLISHER_H
+#define ARGUMENTLISTPUBLISHER_H
+
+#include "FrozenArgumentList.h"
+#include <memory>
+
+namespace libargvcodec
+{
+
+  typedef std::shared_ptr<const FrozenArgumentList> FrozenArgumentListPtr;
+
+  /// <summary>
+  /// Publishes FrozenArgumentList snapshots to multiple reader threads.
+  /// Writers build a new snapshot and replace the current one atomically. Readers get the current snapshot
+  /// and keep it alive for as long as they need it, even if a newer snapshot is published in the meantime.
+  /// </summary>
+  class LIBARGVCODEC_EXPORT ArgumentListPublisher
+  {
+  public:
+    /// <summary>Creates a publisher with an empty snapshot.</summary>
+    ArgumentListPublisher();
+    virtual ~ArgumentListPublisher();
+
+    /// <summary>Returns the current snapshot. The returned snapshot is never NULL.</summary>
+    FrozenArgumentListPtr getSnapshot() const;
+
+    /// <summary>Builds a snapshot of the given arguments and publishes it atomically.</summary>
+    /// <param name="iArguments">The arguments of the new snapshot.</param>
+    void publish(const ArgumentList & iArguments);
+
+    /// <summary>Publishes the given snapshot atomically.</summary>
+    /// <param name="iSnapshot">The new snapshot.</param>
+    /// <returns>Returns true if the snapshot is published. Returns false if iSnapshot is NULL.</returns>
+    bool publish(const FrozenArgumentListPtr & iSnapshot);
+
+  private:
+    //disable copy and assignment
+    ArgumentListPublisher(const ArgumentListPublisher &);
+    ArgumentListPublisher & operator = (const ArgumentListPublisher &);
+
+    SAFE_WARNING_DISABLE(4251); //warning C4251: class 'std::shared_ptr<_Ty>' needs to have dll-interface to be used by clients of class 'ArgumentListPublisher'
+    FrozenArgumentListPtr mSnapshot; //only accessed with std::atomic_load() and std::atomic_store()
+    SAFE_WARNING_RESTORE();
+  };
+
+}; //namespace libargvcodec
+
+#endif //ARGUMENTLISTPUBLISHER_H
@@ -0,0 +1,79 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef ARGUMENTSTREAMENCODER_H
+#define ARGUMENTSTREAMENCODER_H
+
+#include "IArgumentEncoder.h"
+#include "IOutputSink.h"
+
+namespace libargvcodec
+{
+
+  /// <summary>
+  /// Encodes arguments into a command line which is written directly to a sink.
+  /// Each argument is encoded and written as soon as it is given which keeps the memory usage
+  /// independent of the total size of the command line.
+  /// </summary>
+  class LIBARGVCODEC_EXPORT ArgumentStreamEncoder
+  {
+  public:
+    /// <summary>Creates a stream encoder.</summary>
+    /// <param name="iEncoder">The encoder of each argument.</param>
+    /// <param name="iSink">The output sink of the command line.</param>
+    /// <param name="iResource">The source of memory of the scratch buffer of the encoder. Use NULL to allocate from the global heap.</param>
+    ArgumentStreamEncoder(const IArgumentEncoder & iEncoder, IOutputSink & iSink, IMemoryResource * iResource = NULL);
+    virtual ~ArgumentStreamEncoder();
+
+    /// <summary>Encodes a single argument and writes it to the sink. A separator is written before all arguments except the first.</summary>
+    /// <param name="iValue">The value of the argument.</param>
+    /// <returns>Returns true when the argument is written. Returns false otherwise.</returns>
+    bool encodeArgument(const char * iValue);
+
+    /// <summary>Encodes all arguments of an ArgumentList except the first and writes them to the sink.</summary>
+    /// <remarks>The first argument refers to the executable and is skipped like encodeCommandLine().</remarks>
+    /// <param name="iArguments">The list of arguments</param>
+    /// <returns>Returns true when all arguments are written. Returns false otherwise.</returns>
+    bool encodeCommandLine(const ArgumentList & iArguments);
+
+    /// <summary>Starts a new command line. The next argument is written without a separator.</summary>
+    void reset();
+
+    /// <summary>Flushes the sink.</summary>
+    /// <returns>Returns true when the sink is flushed. Returns false otherwise.</returns>
+    bool flush();
+
+  private:
+    ArgumentStreamEncoder(const ArgumentStreamEncoder &);
+    ArgumentStreamEncoder & operator=(const ArgumentStreamEncoder &);
+
+    const IArgumentEncoder & mEncoder;
+    IOutputSink & mSink;
+    ResourceString mScratch;
+    bool mIsFirstArgument;
+  };
+
+}; //namespace libargvcodec
+
+#endif //ARGUMENTSTREAMENCODER_H
@@ -0,0 +1,79 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef BATCHENCODER_H
+#define BATCHENCODER_H
+
+#include "ArgumentList.h"
+#include "IArgumentEncoder.h"
+
+namespace libargvcodec
+{
+
+  /// <summary>Encodes multiple argument lists in parallel.</summary>
+  /// <remarks>
+  /// The argument lists are split in chunks which are encoded by multiple threads. Each chunk is encoded into its own buffer
+  /// and the buffers are concatenated in order. Each command line of the output is followed by a separator character.
+  /// </remarks>
+  class LIBARGVCODEC_EXPORT BatchEncoder
+  {
+  public:
+    /// <summary>Command lines of the same arguments encoded for each dialect.</summary>
+    struct DialectCommandLines
+    {
+      std::string cmdPrompt;
+      std::string createProcess;
+      std::string terminal;
+    };
+
+    /// <summary>Encodes multiple argument lists with the given encoder.</summary>
+    /// <remarks>The encoder is shared by all threads. Its encodeCommandLine() method must be reentrant which is the case for all encoders of the library.</remarks>
+    /// <param name="iEncoder">The encoder of the argument lists.</param>
+    /// <param name="iArgumentLists">The argument lists to encode. The first argument of each list is skipped like with encodeCommandLine().</param>
+    /// <param name="iCount">The number of argument lists.</param>
+    /// <param name="iSeparator">The character which follows each command line. For example '\n' or '\0'.</param>
+    /// <param name="oOutput">The concatenated command lines.</param>
+    /// <param name="iNumThreads">The number of threads to use. Use 0 for the number of processors of the system.</param>
+    /// <returns>Returns true if the argument lists are encoded. Returns false if iArgumentLists is NULL.</returns>
+    static bool encodeBatch(const IArgumentEncoder & iEncoder, const ArgumentList * iArgumentLists, size_t iCount, char iSeparator, std::string & oOutput, int iNumThreads = 0);
+
+    /// <summary>Encodes an argument list for the Windows Command Prompt, the Windows CreateProcess() api and the Linux terminal.</summary>
+    /// <remarks>The characters of each argument are classified once and the classification is shared by the three encoders.</remarks>
+    /// <param name="iArguments">The argument list to encode. The first argument is skipped like with encodeCommandLine().</param>
+    /// <param name="oCommandLines">The command line of each dialect.</param>
+    static void encodeAllDialects(const ArgumentList & iArguments, DialectCommandLines & oCommandLines);
+
+    /// <summary>Encodes multiple argument lists for the Windows Command Prompt, the Windows CreateProcess() api and the Linux terminal.</summary>
+    /// <param name="iArgumentLists">The argument lists to encode. The first argument of each list is skipped like with encodeCommandLine().</param>
+    /// <param name="iCount">The number of argument lists.</param>
+    /// <param name="iSeparator">The character which follows each command line. For example '\n' or '\0'.</param>
+    /// <param name="oOutput">The concatenated command lines of each dialect.</param>
+    /// <param name="iNumThreads">The number of threads to use. Use 0 for the number of processors of the system.</param>
+    /// <returns>Returns true if the argument lists are encoded. Returns false if iArgumentLists is NULL.</returns>
+    static bool encodeBatchAllDialects(const ArgumentList * iArgumentLists, size_t iCount, char iSeparator, DialectCommandLines & oOutput, int iNumThreads = 0);
+  };
+
+}; //namespace libargvcodec
+
+#endif //BATCHENCODER_H
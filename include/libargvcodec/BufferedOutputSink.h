@@ -0,0 +1,67 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef BUFFEREDOUTPUTSINK_H
+#define BUFFEREDOUTPUTSINK_H
+
+#include "IOutputSink.h"
+
+namespace libargvcodec
+{
+
+  /// <summary>
+  /// Base class of sinks which accumulates bytes in a fixed size buffer.
+  /// The buffer is sent to the underlying output when full or when flush() is called.
+  /// </summary>
+  class LIBARGVCODEC_EXPORT BufferedOutputSink : public virtual IOutputSink
+  {
+  public:
+    static const size_t DEFAULT_BUFFER_SIZE = 65536;
+
+    BufferedOutputSink(size_t iBufferSize = DEFAULT_BUFFER_SIZE);
+    virtual ~BufferedOutputSink();
+
+    //IOutputSink
+    virtual bool write(const char * iBuffer, size_t iLength);
+    virtual bool flush();
+
+  protected:
+    /// <summary>Writes bytes to the underlying output.</summary>
+    /// <param name="iBuffer">The bytes to write.</param>
+    /// <param name="iLength">The number of bytes to write.</param>
+    /// <returns>Returns true when all bytes are written. Returns false otherwise.</returns>
+    virtual bool writeBuffer(const char * iBuffer, size_t iLength) = 0;
+
+  private:
+    BufferedOutputSink(const BufferedOutputSink &);
+    BufferedOutputSink & operator=(const BufferedOutputSink &);
+
+    char * mBuffer;
+    size_t mBufferSize;
+    size_t mLength;
+  };
+
+}; //namespace libargvcodec
+
+#endif //BUFFEREDOUTPUTSINK_H
@@ -0,0 +1,62 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef CACHINGARGUMENTENCODER_H
+#define CACHINGARGUMENTENCODER_H
+
+#include "IArgumentEncoder.h"
+#include "EncodedArgumentCache.h"
+
+namespace libargvcodec
+{
+
+  /// <summary>
+  /// Encoder which returns the encoded arguments from a cache and only calls the given encoder on a cache miss.
+  /// Useful when the same arguments are encoded repeatedly.
+  /// </summary>
+  /// <remarks>
+  /// Command lines are built by joining the encoded arguments (except the first) with a space character like the encoders of the library.
+  /// The class is reentrant if the given encoder is reentrant.
+  /// </remarks>
+  class LIBARGVCODEC_EXPORT CachingArgumentEncoder : public virtual IArgumentEncoder
+  {
+  public:
+    /// <summary>Creates a caching encoder.</summary>
+    /// <param name="iEncoder">The encoder which is called on a cache miss.</param>
+    /// <param name="iCache">The cache of encoded arguments. Can be shared with other encoders.</param>
+    CachingArgumentEncoder(const IArgumentEncoder & iEncoder, EncodedArgumentCache & iCache);
+    virtual ~CachingArgumentEncoder();
+
+    //IArgumentEncoder
+    virtual std::string encodeArgument(const char * iValue) const;
+    virtual std::string encodeCommandLine(const ArgumentList & iArguments) const;
+
+  private:
+    const IArgumentEncoder & mEncoder;
+    EncodedArgumentCache & mCache;
+  };
+
+}; //namespace libargvcodec
+
+#endif //CACHINGARGUMENTENCODER_H
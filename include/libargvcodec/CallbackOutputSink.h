@@ -0,0 +1,57 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef CALLBACKOUTPUTSINK_H
+#define CALLBACKOUTPUTSINK_H
+
+#include "BufferedOutputSink.h"
+
+namespace libargvcodec
+{
+
+  /// <summary>Buffered sink which sends the content of its buffer to a user callback function.</summary>
+  class LIBARGVCODEC_EXPORT CallbackOutputSink : public BufferedOutputSink
+  {
+  public:
+    /// <summary>Callback function which receives the content of the buffer.</summary>
+    /// <param name="iBuffer">The bytes to write.</param>
+    /// <param name="iLength">The number of bytes to write.</param>
+    /// <param name="iUserData">The user data given to the constructor.</param>
+    /// <returns>Returns true when all bytes are written. Returns false otherwise.</returns>
+    typedef bool (*WriteCallback)(const char * iBuffer, size_t iLength, void * iUserData);
+
+    CallbackOutputSink(WriteCallback iCallback, void * iUserData, size_t iBufferSize = DEFAULT_BUFFER_SIZE);
+    virtual ~CallbackOutputSink();
+
+  protected:
+    virtual bool writeBuffer(const char * iBuffer, size_t iLength);
+
+  private:
+    WriteCallback mCallback;
+    void * mUserData;
+  };
+
+}; //namespace libargvcodec
+
+#endif //CALLBACKOUTPUTSINK_H
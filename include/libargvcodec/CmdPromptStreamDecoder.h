@@ -0,0 +1,63 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef CMDPROMPTSTREAMDECODER_H
+#define CMDPROMPTSTREAMDECODER_H
+
+#include "IArgumentStreamDecoder.h"
+#include "IMemoryResource.h"
+
+namespace libargvcodec
+{
+
+  template <typename Dialect> class WindowsStreamDecoderCore;
+  struct CmdPromptDialect;
+
+  /// <summary>Decodes command lines of the Windows Command Prompt in chunks.</summary>
+  class LIBARGVCODEC_EXPORT CmdPromptStreamDecoder : public virtual IArgumentStreamDecoder
+  {
+  public:
+    /// <summary>Creates a decoder which sends the decoded arguments to the given handler.</summary>
+    /// <param name="iHandler">The handler of the decoded arguments.</param>
+    /// <param name="iResource">The source of memory of the decoder. Use NULL to allocate from the global heap.</param>
+    CmdPromptStreamDecoder(IArgumentHandler & iHandler, IMemoryResource * iResource = NULL);
+    virtual ~CmdPromptStreamDecoder();
+
+    //IArgumentStreamDecoder
+    virtual void reset();
+    virtual bool feed(const char * iBuffer, size_t iLength);
+    virtual bool finish();
+
+  private:
+    CmdPromptStreamDecoder(const CmdPromptStreamDecoder &);
+    CmdPromptStreamDecoder & operator=(const CmdPromptStreamDecoder &);
+
+    IArgumentHandler & mHandler;
+    IMemoryResource * mResource;
+    WindowsStreamDecoderCore<CmdPromptDialect> * mCore;
+  };
+
+}; //namespace libargvcodec
+
+#endif //CMDPROMPTSTREAMDECODER_H
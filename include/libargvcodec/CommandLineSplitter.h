@@ -0,0 +1,73 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef COMMANDLINESPLITTER_H
+#define COMMANDLINESPLITTER_H
+
+#include "IArgumentEncoder.h"
+#include <vector>
+
+namespace libargvcodec
+{
+
+  /// <summary>
+  /// Splits a long list of arguments into multiple command lines (batches) which are not longer than a maximum length.
+  /// The leading arguments are repeated in each batch and the trailing arguments are distributed in order.
+  /// This is similar to the xargs utility.
+  /// </summary>
+  class LIBARGVCODEC_EXPORT CommandLineSplitter
+  {
+  public:
+    typedef std::vector<ArgumentList> ArgumentListVector;
+
+    /// <summary>Creates a splitter.</summary>
+    /// <param name="iEncoder">The encoder of the command lines.</param>
+    CommandLineSplitter(const IArgumentEncoder & iEncoder);
+    virtual ~CommandLineSplitter();
+
+    /// <summary>Splits the trailing arguments of a list into the minimum number of batches.</summary>
+    /// <remarks>
+    /// Each argument is encoded only once. Each batch contains the arguments [0, iFirstTrailingArgument) of the list
+    /// followed by as many trailing arguments as possible. The length of a batch is the length of its
+    /// encoded command line which, like encodeCommandLine(), does not include the first argument.
+    /// No batch is created if the list has no trailing argument.
+    /// </remarks>
+    /// <param name="iArguments">The list of arguments.</param>
+    /// <param name="iFirstTrailingArgument">The index of the first trailing argument. Must be 1 or greater.</param>
+    /// <param name="iMaxLength">The maximum length of the encoded command line of a batch in bytes.</param>
+    /// <param name="oBatches">The arguments of each batch.</param>
+    /// <param name="oCommandLines">The encoded command line of each batch.</param>
+    /// <returns>Returns true on success. Returns false if a trailing argument does not fit in a batch by itself.</returns>
+    bool split(const ArgumentList & iArguments, int iFirstTrailingArgument, size_t iMaxLength, ArgumentListVector & oBatches, ArgumentList::StringList & oCommandLines);
+
+  private:
+    CommandLineSplitter(const CommandLineSplitter &);
+    CommandLineSplitter & operator=(const CommandLineSplitter &);
+
+    const IArgumentEncoder & mEncoder;
+  };
+
+}; //namespace libargvcodec
+
+#endif //COMMANDLINESPLITTER_H
@@ -27,6 +27,7 @@
 
 #include "IArgumentEncoder.h"
 #include "IArgumentDecoder.h"
+#include "DecodedCommandLines.h"
 #include "CmdPromptArgumentCodec.h"
 
 namespace libargvcodec
@@ -38,18 +39,22 @@ namespace libargvcodec
     CreateProcessArgumentCodec();
     virtual ~CreateProcessArgumentCodec();
 
-    ////IArgumentEncoder interface
-    //virtual std::string encodeArgument(const char * iValue);
-    //virtual std::string encodeCommandLine(const ArgumentList & iArguments);
+    //IArgumentEncoder
+    virtual std::string encodeArgument(const char * iValue) const;
+    virtual std::string encodeCommandLine(const ArgumentList & iArguments) const;
+    virtual void appendEncodedArgument(const char * iValue, ResourceString & ioOutput) const;
 
-    ////IArgumentDecoder interface
-    //virtual std::string decodeArgument(const char * iValue);
-    //virtual ArgumentList decodeCommandLine(const char * iValue);
+    //IArgumentDecoder
+    virtual std::string decodeArgument(const char * iValue) const;
+    virtual ArgumentList decodeCommandLine(const char * iValue) const;
+
+    //StreamArgumentDecoder
+    virtual IArgumentStreamDecoder * createStreamDecoder(IArgumentHandler & iHandler) const;
 
   public:
-    virtual bool isShellCharacter(const char c);
-    virtual bool hasShellCharacters(const char * iValue);
-    virtual bool supportsShellCharacters();
+    virtual bool isShellCharacter(const char c) const;
+    virtual bool hasShellCharacters(const char * iValue) const;
+    virtual bool supportsShellCharacters() const;
 
   };
 
@@ -0,0 +1,110 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef DECODEDCOMMANDLINECACHE_H
+#define DECODEDCOMMANDLINECACHE_H
+
+#include "IArgumentDecoder.h"
+#include "DecodedCommandLines.h"
+
+namespace libargvcodec
+{
+
+  template <typename Value>
+  class ClockCache;
+
+  /// <summary>
+  /// Bounded concurrent cache of decoded command lines keyed on the content of the command line and the dialect (type) of the decoder.
+  /// The decoded arguments are stored as immutable shared snapshots: a hit returns a new reference to the cached arguments without copying them.
+  /// A single cache can be shared by multiple threads and multiple decoders.
+  /// </summary>
+  /// <remarks>
+  /// The memory used by the cache is limited by the size of the command lines and the size of their decoded arguments.
+  /// The cache is split in shards with their own lock and uses the CLOCK eviction algorithm: a hit only sets a flag on the entry.
+  /// See StreamArgumentDecoder::setDecodeCache() for enabling the cache on a decoder.
+  /// </remarks>
+  class LIBARGVCODEC_EXPORT DecodedCommandLineCache
+  {
+  public:
+    static const size_t DEFAULT_MAX_BYTES = 4 * 1024 * 1024;
+    static const size_t DEFAULT_MAX_ENTRIES = 4096;
+
+    /// <summary>Creates a cache.</summary>
+    /// <param name="iMaxBytes">The maximum memory used by the cached command lines and their arguments in bytes.</param>
+    /// <param name="iMaxEntries">The maximum number of decoded command lines in the cache.</param>
+    DecodedCommandLineCache(size_t iMaxBytes = DEFAULT_MAX_BYTES, size_t iMaxEntries = DEFAULT_MAX_ENTRIES);
+    virtual ~DecodedCommandLineCache();
+
+    /// <summary>Finds the decoded arguments of a command line.</summary>
+    /// <param name="iDecoder">The decoder of the command line. Decoders of the same type share the same entries.</param>
+    /// <param name="iCommandLine">The command line. Must not be NULL.</param>
+    /// <param name="oDecoded">The shared decoded arguments of the command line.</param>
+    /// <returns>Returns true if the command line is in the cache. Returns false otherwise.</returns>
+    bool lookup(const IArgumentDecoder & iDecoder, const char * iCommandLine, DecodedCommandLinesPtr & oDecoded);
+
+    /// <summary>Inserts the decoded arguments of a command line in the cache.</summary>
+    /// <remarks>The arguments are not inserted if they are larger than the memory limit of the cache.</remarks>
+    /// <param name="iDecoder">The decoder of the command line.</param>
+    /// <param name="iCommandLine">The command line. Must not be NULL.</param>
+    /// <param name="iDecoded">The decoded arguments of the command line. Must not be modified after insertion.</param>
+    void insert(const IArgumentDecoder & iDecoder, const char * iCommandLine, const DecodedCommandLinesPtr & iDecoded);
+
+    /// <summary>Removes all entries from the cache. Snapshots returned by previous lookups stay valid.</summary>
+    void clear();
+
+    /// <summary>Returns the maximum memory used by the cache in bytes.</summary>
+    size_t getMaxBytes() const;
+
+    /// <summary>Returns the maximum number of entries in the cache.</summary>
+    size_t getMaxEntries() const;
+
+    /// <summary>Returns the current number of entries in the cache.</summary>
+    size_t getNumEntries() const;
+
+    /// <summary>Returns the current memory used by the entries of the cache in bytes.</summary>
+    size_t getNumBytes() const;
+
+    /// <summary>Returns the number of successful lookups since the creation of the cache or the last call to resetStatistics().</summary>
+    size_t getNumHits() const;
+
+    /// <summary>Returns the number of failed lookups since the creation of the cache or the last call to resetStatistics().</summary>
+    size_t getNumMisses() const;
+
+    /// <summary>Returns the number of evicted entries since the creation of the cache or the last call to resetStatistics().</summary>
+    size_t getNumEvictions() const;
+
+    /// <summary>Resets the hits, misses and evictions counters.</summary>
+    void resetStatistics();
+
+  private:
+    //disable copy and assignment
+    DecodedCommandLineCache(const DecodedCommandLineCache &);
+    DecodedCommandLineCache & operator = (const DecodedCommandLineCache &);
+
+    ClockCache<DecodedCommandLinesPtr> * mCache;
+  };
+
+}; //namespace libargvcodec
+
+#endif //DECODEDCOMMANDLINECACHE_H
@@ -0,0 +1,115 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef DECODEDCOMMANDLINES_H
+#define DECODEDCOMMANDLINES_H
+
+#include "IArgumentHandler.h"
+#include "ResourceAllocator.h"
+#include <vector>
+#include <memory>
+
+namespace libargvcodec
+{
+
+  class DecodedCommandLinesBuilder;
+
+  /// <summary>
+  /// Compact columnar storage of the arguments of multiple decoded command lines.
+  /// The arguments of all command lines are stored in a single byte arena, each followed by a NULL character.
+  /// The argument offsets array gives the start of each argument in the arena and the command line offsets array
+  /// gives the index of the first argument of each command line.
+  /// </summary>
+  /// <remarks>
+  /// The class implements IArgumentHandler which allows it to be the handler of a stream decoder.
+  /// Call endCommandLine() after each command line.
+  /// Unlike decodeCommandLine(), the current executable path is not added to the arguments.
+  /// The arrays allocate from the memory resource given to the constructor.
+  /// </remarks>
+  class LIBARGVCODEC_EXPORT DecodedCommandLines : public IArgumentHandler
+  {
+  public:
+    typedef std::vector<char, ResourceAllocator<char> > ByteArray;
+    typedef std::vector<size_t, ResourceAllocator<size_t> > OffsetArray;
+
+    /// <summary>Creates an empty list of command lines.</summary>
+    /// <param name="iResource">The source of memory of the arrays. Use NULL to allocate from the global heap.</param>
+    DecodedCommandLines(IMemoryResource * iResource = NULL);
+    virtual ~DecodedCommandLines();
+
+    /// <summary>Removes all command lines.</summary>
+    void clear();
+
+    /// <summary>Returns the number of command lines.</summary>
+    size_t getNumCommandLines() const;
+
+    /// <summary>Returns the total number of arguments of all command lines.</summary>
+    size_t getNumArguments() const;
+
+    /// <summary>Returns the number of arguments of the given command line.</summary>
+    /// <param name="iCommandLine">The index of the command line.</param>
+    /// <returns>Returns the number of arguments of the given command line. Returns 0 if iCommandLine is out of bounds.</returns>
+    size_t getArgc(size_t iCommandLine) const;
+
+    /// <summary>Returns an argument of a command line.</summary>
+    /// <param name="iCommandLine">The index of the command line.</param>
+    /// <param name="iIndex">The index of the argument within the command line.</param>
+    /// <returns>Returns the NULL terminated value of the argument. Returns NULL if out of bounds.</returns>
+    const char * getArgument(size_t iCommandLine, size_t iIndex) const;
+
+    /// <summary>Returns the length of an argument of a command line.</summary>
+    /// <param name="iCommandLine">The index of the command line.</param>
+    /// <param name="iIndex">The index of the argument within the command line.</param>
+    /// <returns>Returns the length of the argument in bytes. Returns 0 if out of bounds.</returns>
+    size_t getArgumentLength(size_t iCommandLine, size_t iIndex) const;
+
+    /// <summary>Returns the byte arena which contains the NULL terminated arguments of all command lines.</summary>
+    const ByteArray & getArena() const;
+
+    /// <summary>Returns the offset of each argument in the arena. The array contains an additional element which is the size of the arena.</summary>
+    const OffsetArray & getArgumentOffsets() const;
+
+    /// <summary>Returns the index of the first argument of each command line. The array contains an additional element which is the total number of arguments.</summary>
+    const OffsetArray & getCommandLineOffsets() const;
+
+    //IArgumentHandler
+    virtual void onArgument(const char * iValue, size_t iLength);
+
+    /// <summary>Ends the current command line. The following arguments belong to a new command line.</summary>
+    void endCommandLine();
+
+  private:
+    friend class DecodedCommandLinesBuilder;
+
+    ByteArray mArena;
+    OffsetArray mArgumentOffsets;
+    OffsetArray mCommandLineOffsets;
+  };
+
+  /// <summary>Shared pointer to an immutable DecodedCommandLines instance.</summary>
+  typedef std::shared_ptr<const DecodedCommandLines> DecodedCommandLinesPtr;
+
+}; //namespace libargvcodec
+
+#endif //DECODEDCOMMANDLINES_H
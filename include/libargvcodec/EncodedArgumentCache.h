@@ -0,0 +1,98 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef ENCODEDARGUMENTCACHE_H
+#define ENCODEDARGUMENTCACHE_H
+
+#include "IArgumentEncoder.h"
+
+namespace libargvcodec
+{
+
+  template <typename Value>
+  class ClockCache;
+
+  /// <summary>
+  /// Bounded concurrent cache of encoded arguments keyed on the argument value and the dialect (type) of the encoder.
+  /// A single cache can be shared by multiple threads and multiple encoders.
+  /// </summary>
+  /// <remarks>
+  /// The cache is split in shards with their own lock and uses the CLOCK eviction algorithm: a hit only sets a flag on the entry.
+  /// See CachingArgumentEncoder for using the cache in front of an encoder.
+  /// </remarks>
+  class LIBARGVCODEC_EXPORT EncodedArgumentCache
+  {
+  public:
+    static const size_t DEFAULT_MAX_ENTRIES = 4096;
+
+    /// <summary>Creates a cache.</summary>
+    /// <param name="iMaxEntries">The maximum number of encoded arguments in the cache.</param>
+    EncodedArgumentCache(size_t iMaxEntries = DEFAULT_MAX_ENTRIES);
+    virtual ~EncodedArgumentCache();
+
+    /// <summary>Finds the encoded value of an argument.</summary>
+    /// <param name="iEncoder">The encoder of the argument. Encoders of the same type share the same entries.</param>
+    /// <param name="iValue">The value of the argument. Must not be NULL.</param>
+    /// <param name="oEncoded">The encoded argument.</param>
+    /// <returns>Returns true if the encoded argument is in the cache. Returns false otherwise.</returns>
+    bool lookup(const IArgumentEncoder & iEncoder, const char * iValue, std::string & oEncoded);
+
+    /// <summary>Inserts the encoded value of an argument in the cache.</summary>
+    /// <param name="iEncoder">The encoder of the argument.</param>
+    /// <param name="iValue">The value of the argument. Must not be NULL.</param>
+    /// <param name="iEncoded">The encoded argument.</param>
+    void insert(const IArgumentEncoder & iEncoder, const char * iValue, const std::string & iEncoded);
+
+    /// <summary>Removes all entries from the cache.</summary>
+    void clear();
+
+    /// <summary>Returns the maximum number of entries in the cache.</summary>
+    size_t getMaxEntries() const;
+
+    /// <summary>Returns the current number of entries in the cache.</summary>
+    size_t getNumEntries() const;
+
+    /// <summary>Returns the number of successful lookups since the creation of the cache or the last call to resetStatistics().</summary>
+    size_t getNumHits() const;
+
+    /// <summary>Returns the number of failed lookups since the creation of the cache or the last call to resetStatistics().</summary>
+    size_t getNumMisses() const;
+
+    /// <summary>Returns the number of evicted entries since the creation of the cache or the last call to resetStatistics().</summary>
+    size_t getNumEvictions() const;
+
+    /// <summary>Resets the hits, misses and evictions counters.</summary>
+    void resetStatistics();
+
+  private:
+    //disable copy and assignment
+    EncodedArgumentCache(const EncodedArgumentCache &);
+    EncodedArgumentCache & operator = (const EncodedArgumentCache &);
+
+    ClockCache<std::string> * mCache;
+  };
+
+}; //namespace libargvcodec
+
+#endif //ENCODEDARGUMENTCACHE_H
@@ -0,0 +1,50 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef FILEDESCRIPTOROUTPUTSINK_H
+#define FILEDESCRIPTOROUTPUTSINK_H
+
+#include "BufferedOutputSink.h"
+
+namespace libargvcodec
+{
+
+  /// <summary>Buffered sink which writes to a file descriptor (a file, a pipe, a socket, etc).</summary>
+  /// <remarks>The file descriptor is not closed by the sink.</remarks>
+  class LIBARGVCODEC_EXPORT FileDescriptorOutputSink : public BufferedOutputSink
+  {
+  public:
+    FileDescriptorOutputSink(int iFileDescriptor, size_t iBufferSize = DEFAULT_BUFFER_SIZE);
+    virtual ~FileDescriptorOutputSink();
+
+  protected:
+    virtual bool writeBuffer(const char * iBuffer, size_t iLength);
+
+  private:
+    int mFileDescriptor;
+  };
+
+}; //namespace libargvcodec
+
+#endif //FILEDESCRIPTOROUTPUTSINK_H
@@ -0,0 +1,52 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef FILEOUTPUTSINK_H
+#define FILEOUTPUTSINK_H
+
+#include "IOutputSink.h"
+#include <cstdio> //for FILE
+
+namespace libargvcodec
+{
+
+  /// <summary>Sink which writes to a standard c FILE stream. The stream's own buffer is used.</summary>
+  /// <remarks>The stream is not closed by the sink.</remarks>
+  class LIBARGVCODEC_EXPORT FileOutputSink : public virtual IOutputSink
+  {
+  public:
+    FileOutputSink(FILE * iFile);
+    virtual ~FileOutputSink();
+
+    //IOutputSink
+    virtual bool write(const char * iBuffer, size_t iLength);
+    virtual bool flush();
+
+  private:
+    FILE * mFile;
+  };
+
+}; //namespace libargvcodec
+
+#endif //FILEOUTPUTSINK_H
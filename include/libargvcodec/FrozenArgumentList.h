@@ -0,0 +1,101 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef FROZENARGUMENTLIST_H
+#define FROZENARGUMENTLIST_H
+
+#include "ArgumentList.h"
+
+namespace libargvcodec
+{
+
+  /// <summary>
+  /// Immutable snapshot of an ArgumentList and its option prefixes.
+  /// The snapshot only exposes const lookup methods and can never be modified after construction.
+  /// All methods can be called concurrently by multiple threads without locking.
+  /// </summary>
+  /// <remarks>See ArgumentListPublisher for sharing a snapshot which is replaced over time.</remarks>
+  class LIBARGVCODEC_EXPORT FrozenArgumentList
+  {
+  public:
+    /// <summary>Creates an empty snapshot.</summary>
+    FrozenArgumentList();
+
+    /// <summary>Creates a snapshot of the given arguments and option prefixes.</summary>
+    /// <param name="iArguments">The arguments to copy.</param>
+    FrozenArgumentList(const ArgumentList & iArguments);
+
+    virtual ~FrozenArgumentList();
+
+    /// <summary>Returns a modifiable copy of the snapshot including the option prefixes.</summary>
+    ArgumentList toArgumentList() const;
+
+    /// <summary>See ArgumentList::getArgument().</summary>
+    const char * getArgument(int iIndex) const;
+
+    /// <summary>See ArgumentList::getArgc().</summary>
+    int getArgc() const;
+
+    /// <summary>Get a pointer to the first element of the arguments array. The array is terminated by a NULL element.</summary>
+    const char * const * getArgv() const;
+
+    /// <summary>See ArgumentList::findIndex().</summary>
+    int findIndex(const char * iValue) const;
+    int findIndex(const char * iValue, bool iCaseSensitive) const;
+
+    /// <summary>See ArgumentList::contains().</summary>
+    bool contains(const char * iValue) const;
+    bool contains(const char * iValue, bool iCaseSensitive) const;
+
+    /// <summary>See ArgumentList::findOption().</summary>
+    bool findOption(const char * iValue) const;
+    bool findOption(const char * iValue, int & oIndex) const;
+    bool findOption(const char * iValue, bool iCaseSensitive, int & oIndex) const;
+
+    /// <summary>See ArgumentList::findValue().</summary>
+    bool findValue(const char * iValueName, int & oIndex, std::string & oValue) const;
+    bool findValue(const char * iValueName, int & oIndex, int & oValue) const;
+    bool findValue(const char * iValueName, bool iCaseSensitive, int & oIndex, std::string & oValue) const;
+    bool findValue(const char * iValueName, bool iCaseSensitive, int & oIndex, int & oValue) const;
+
+    /// <summary>See ArgumentList::findNextValue().</summary>
+    bool findNextValue(const char * iValueName, int & oIndex, std::string & oValue) const;
+    bool findNextValue(const char * iValueName, int & oIndex, int & oValue) const;
+    bool findNextValue(const char * iValueName, bool iCaseSensitive, int & oIndex, std::string & oValue) const;
+    bool findNextValue(const char * iValueName, bool iCaseSensitive, int & oIndex, int & oValue) const;
+
+    /// <summary>See ArgumentList::getOptionPrefixes().</summary>
+    const ArgumentList::StringList & getOptionPrefixes() const;
+
+  private:
+    //disable copy and assignment: share snapshots by pointer instead
+    FrozenArgumentList(const FrozenArgumentList &);
+    FrozenArgumentList & operator = (const FrozenArgumentList &);
+
+    ArgumentList mArguments;
+  };
+
+}; //namespace libargvcodec
+
+#endif //FROZENARGUMENTLIST_H
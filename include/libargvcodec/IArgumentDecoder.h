@@ -31,6 +31,11 @@
 namespace libargvcodec
 {
 
+  /// <summary>Interface of a command line decoder.</summary>
+  /// <remarks>
+  /// All methods are const and must be reentrant: an implementation must not have mutable state
+  /// so that a single instance can be shared and called concurrently by multiple threads.
+  /// </remarks>
   class LIBARGVCODEC_EXPORT IArgumentDecoder
   {
   public:
@@ -38,13 +43,13 @@ namespace libargvcodec
     /// <summary>Decodes a single argument.</summary>
     /// <param name="iValue">The encoded argument</param>
     /// <returns>Returns the value of the argument without all encoding characters.</returns>
-    virtual std::string decodeArgument(const char * iValue) = 0;
+    virtual std::string decodeArgument(const char * iValue) const = 0;
 
     /// <summary>Decodes a command line into a list of arguments.</summary>
     /// <remarks>The function automatically adds the current executable path as the first argument of the list.</remarks>
     /// <param name="iValue">The command line string.</param>
     /// <returns>Returns all argument's value removing all encoding characters.</returns>
-    virtual ArgumentList decodeCommandLine(const char * iValue) = 0;
+    virtual ArgumentList decodeCommandLine(const char * iValue) const = 0;
   };
 
 }; //namespace libargvcodec
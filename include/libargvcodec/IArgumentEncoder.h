@@ -27,22 +27,41 @@
 
 #include "libargvcodec/config.h"
 #include "ArgumentList.h"
+#include "ResourceAllocator.h"
 
 namespace libargvcodec
 {
 
+  /// <summary>Interface of a command line encoder.</summary>
+  /// <remarks>
+  /// All methods are const and must be reentrant: an implementation must not have mutable state
+  /// so that a single instance can be shared and called concurrently by multiple threads.
+  /// </remarks>
   class LIBARGVCODEC_EXPORT IArgumentEncoder
   {
   public:
     /// <summary>Encodes a single argument.</summary>
     /// <param name="iValue">The value of the argument.</param>
     /// <returns>Returns the argument's value properly encoded.</returns>
-    virtual std::string encodeArgument(const char * iValue) = 0;
+    virtual std::string encodeArgument(const char * iValue) const = 0;
 
     /// <summary>Encodes an ArgumentList (list of arguments) into a command line.</summary>
     /// <param name="iArguments">The list of arguments</param>
     /// <returns>Returns a command line strings with each single argument properly encoded.</returns>
-    virtual std::string encodeCommandLine(const ArgumentList & iArguments) = 0;
+    virtual std::string encodeCommandLine(const ArgumentList & iArguments) const = 0;
+
+    /// <summary>Encodes a single argument and appends the result to the given string.</summary>
+    /// <remarks>
+    /// The default implementation calls encodeArgument(). The codecs of the library encode directly into the string
+    /// which allows a caller to reuse the string and to allocate from its own memory resource.
+    /// </remarks>
+    /// <param name="iValue">The value of the argument.</param>
+    /// <param name="ioOutput">The string which receives the encoded argument.</param>
+    virtual void appendEncodedArgument(const char * iValue, ResourceString & ioOutput) const
+    {
+      const std::string encoded = encodeArgument(iValue);
+      ioOutput.append(encoded.c_str(), encoded.size());
+    }
   };
 
 }; //namespace libargvcodec
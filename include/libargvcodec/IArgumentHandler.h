@@ -0,0 +1,48 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef IARGUMENTHANDLER_H
+#define IARGUMENTHANDLER_H
+
+#include "libargvcodec/config.h"
+#include <cstddef> //for size_t
+
+namespace libargvcodec
+{
+
+  class LIBARGVCODEC_EXPORT IArgumentHandler
+  {
+  public:
+    virtual ~IArgumentHandler() {}
+
+    /// <summary>Called each time a stream decoder completes an argument.</summary>
+    /// <remarks>The given buffer is only valid for the duration of the call.</remarks>
+    /// <param name="iValue">The value of the argument. The buffer is NULL terminated.</param>
+    /// <param name="iLength">The length of the argument in bytes.</param>
+    virtual void onArgument(const char * iValue, size_t iLength) = 0;
+  };
+
+}; //namespace libargvcodec
+
+#endif //IARGUMENTHANDLER_H
@@ -0,0 +1,61 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef IARGUMENTSTREAMDECODER_H
+#define IARGUMENTSTREAMDECODER_H
+
+#include "libargvcodec/config.h"
+#include "IArgumentHandler.h"
+
+namespace libargvcodec
+{
+
+  class LIBARGVCODEC_EXPORT IArgumentStreamDecoder
+  {
+  public:
+    virtual ~IArgumentStreamDecoder() {}
+
+    /// <summary>Resets the decoder to decode a new command line.</summary>
+    virtual void reset() = 0;
+
+    /// <summary>Decodes the next chunk of a command line.</summary>
+    /// <remarks>
+    /// Each completed argument is sent to the decoder's handler.
+    /// Quoting and escaping states are kept between calls which allows a chunk to end anywhere in the command line.
+    /// Unlike decodeCommandLine(), the current executable path is not added to the arguments.
+    /// </remarks>
+    /// <param name="iBuffer">The chunk of the command line. The buffer does not need to be NULL terminated.</param>
+    /// <param name="iLength">The length of the chunk in bytes.</param>
+    /// <returns>Returns true when the chunk was decoded. Returns false otherwise.</returns>
+    virtual bool feed(const char * iBuffer, size_t iLength) = 0;
+
+    /// <summary>Ends the command line and sends the last argument to the decoder's handler.</summary>
+    /// <remarks>The decoder is reset and can be used to decode a new command line.</remarks>
+    /// <returns>Returns true when the command line was decoded. Returns false otherwise.</returns>
+    virtual bool finish() = 0;
+  };
+
+}; //namespace libargvcodec
+
+#endif //IARGUMENTSTREAMDECODER_H
@@ -0,0 +1,62 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef IMEMORYRESOURCE_H
+#define IMEMORYRESOURCE_H
+
+#include "libargvcodec/config.h"
+#include <cstddef> //for size_t
+
+namespace libargvcodec
+{
+
+  /// <summary>
+  /// Interface of a source of memory for the decode outputs, the stream decoders and the encoder scratch buffers.
+  /// This is the C++11 equivalent of std::pmr::memory_resource.
+  /// </summary>
+  class LIBARGVCODEC_EXPORT IMemoryResource
+  {
+  public:
+    virtual ~IMemoryResource() {}
+
+    /// <summary>Allocates a block of memory.</summary>
+    /// <param name="iSize">The size of the block in bytes.</param>
+    /// <param name="iAlignment">The alignment of the block. Must be a power of 2.</param>
+    /// <returns>Returns the allocated block. Throws std::bad_alloc when out of memory, like operator new.</returns>
+    virtual void * allocate(size_t iSize, size_t iAlignment) = 0;
+
+    /// <summary>Releases a block returned by allocate().</summary>
+    /// <param name="iPointer">The block to release.</param>
+    /// <param name="iSize">The size given to allocate().</param>
+    /// <param name="iAlignment">The alignment given to allocate().</param>
+    virtual void deallocate(void * iPointer, size_t iSize, size_t iAlignment) = 0;
+  };
+
+  /// <summary>Returns the resource which allocates from the global heap with operator new and operator delete.</summary>
+  /// <remarks>Alignments larger than the alignment of the fundamental types are not supported.</remarks>
+  LIBARGVCODEC_EXPORT IMemoryResource * getDefaultMemoryResource();
+
+}; //namespace libargvcodec
+
+#endif //IMEMORYRESOURCE_H
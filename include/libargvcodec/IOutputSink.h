@@ -0,0 +1,52 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef IOUTPUTSINK_H
+#define IOUTPUTSINK_H
+
+#include "libargvcodec/config.h"
+#include <cstddef> //for size_t
+
+namespace libargvcodec
+{
+
+  class LIBARGVCODEC_EXPORT IOutputSink
+  {
+  public:
+    virtual ~IOutputSink() {}
+
+    /// <summary>Writes bytes to the sink.</summary>
+    /// <param name="iBuffer">The bytes to write.</param>
+    /// <param name="iLength">The number of bytes to write.</param>
+    /// <returns>Returns true when all bytes are written. Returns false otherwise.</returns>
+    virtual bool write(const char * iBuffer, size_t iLength) = 0;
+
+    /// <summary>Writes all pending bytes to the underlying output.</summary>
+    /// <returns>Returns true when all pending bytes are written. Returns false otherwise.</returns>
+    virtual bool flush() = 0;
+  };
+
+}; //namespace libargvcodec
+
+#endif //IOUTPUTSINK_H
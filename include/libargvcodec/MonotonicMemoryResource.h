@@ -0,0 +1,91 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef MONOTONICMEMORYRESOURCE_H
+#define MONOTONICMEMORYRESOURCE_H
+
+#include "IMemoryResource.h"
+
+namespace libargvcodec
+{
+
+  /// <summary>
+  /// Arena which allocates by incrementing a pointer and releases all its memory at once.
+  /// Memory comes from an optional initial buffer, then from chunks of geometrically increasing size
+  /// allocated from an upstream resource. This is the C++11 equivalent of std::pmr::monotonic_buffer_resource.
+  /// </summary>
+  /// <remarks>
+  /// deallocate() does nothing: memory is only released by release() or by the destructor.
+  /// The class is not thread-safe. Use one instance per request or per thread.
+  /// </remarks>
+  class LIBARGVCODEC_EXPORT MonotonicMemoryResource : public virtual IMemoryResource
+  {
+  public:
+    static const size_t DEFAULT_CHUNK_SIZE = 4096;
+
+    /// <summary>Creates an arena which allocates chunks from the given upstream resource.</summary>
+    /// <param name="iUpstream">The source of the chunks. Use NULL to allocate the chunks from the default resource.</param>
+    MonotonicMemoryResource(IMemoryResource * iUpstream = NULL);
+
+    /// <summary>Creates an arena which allocates from the given buffer first.</summary>
+    /// <param name="iBuffer">The initial buffer. The buffer is not owned by the arena and must outlive it.</param>
+    /// <param name="iSize">The size of the initial buffer in bytes.</param>
+    /// <param name="iUpstream">The source of the chunks once the buffer is full. Use NULL to allocate the chunks from the default resource.</param>
+    MonotonicMemoryResource(void * iBuffer, size_t iSize, IMemoryResource * iUpstream = NULL);
+
+    virtual ~MonotonicMemoryResource();
+
+    //IMemoryResource
+    virtual void * allocate(size_t iSize, size_t iAlignment);
+    virtual void deallocate(void * iPointer, size_t iSize, size_t iAlignment);
+
+    /// <summary>Releases all chunks to the upstream resource. The initial buffer is reused by the next allocations.</summary>
+    void release();
+
+    /// <summary>Returns the number of bytes allocated since the last call to release(), including alignment padding.</summary>
+    size_t getNumBytes() const;
+
+    /// <summary>Returns the number of chunks allocated from the upstream resource since the last call to release().</summary>
+    size_t getNumChunks() const;
+
+  private:
+    MonotonicMemoryResource(const MonotonicMemoryResource &);
+    MonotonicMemoryResource & operator=(const MonotonicMemoryResource &);
+
+    struct Chunk;
+
+    IMemoryResource * mUpstream;
+    char * mBuffer;
+    size_t mBufferSize;
+    char * mCurrent;
+    char * mEnd;
+    Chunk * mChunks;
+    size_t mNextChunkSize;
+    size_t mNumBytes;
+    size_t mNumChunks;
+  };
+
+}; //namespace libargvcodec
+
+#endif //MONOTONICMEMORYRESOURCE_H
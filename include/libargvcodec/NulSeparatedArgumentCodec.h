@@ -0,0 +1,83 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef NULSEPARATEDARGUMENTCODEC_H
+#define NULSEPARATEDARGUMENTCODEC_H
+
+#include "IArgumentEncoder.h"
+#include "IArgumentDecoder.h"
+#include "IArgumentHandler.h"
+
+namespace libargvcodec
+{
+
+  /// <summary>
+  /// Codec of argument vectors stored as NULL separated bytes, like the content of /proc/[pid]/cmdline on Linux.
+  /// Arguments are copied as is: there is no escaping.
+  /// </summary>
+  /// <remarks>
+  /// Each encoded argument of a command line is followed by a NULL character. The encoded command line contains NULL characters
+  /// and must be handled with std::string::data() and std::string::size(). ArgumentStreamEncoder is not supported since it separates arguments with spaces.
+  /// decodeCommandLine() expects a list terminated by an empty argument (two consecutive NULL characters), which is the case of
+  /// std::string::c_str() of an encoded command line. Use decodeArgumentVector() to decode a blob of a known size which may contain empty arguments.
+  /// </remarks>
+  class LIBARGVCODEC_EXPORT NulSeparatedArgumentCodec : public virtual IArgumentEncoder,
+    public virtual IArgumentDecoder
+  {
+  public:
+    NulSeparatedArgumentCodec();
+    virtual ~NulSeparatedArgumentCodec();
+
+    //IArgumentEncoder
+    virtual std::string encodeArgument(const char * iValue) const;
+    virtual std::string encodeCommandLine(const ArgumentList & iArguments) const;
+    virtual void appendEncodedArgument(const char * iValue, ResourceString & ioOutput) const;
+
+    //IArgumentDecoder
+    virtual std::string decodeArgument(const char * iValue) const;
+    virtual ArgumentList decodeCommandLine(const char * iValue) const;
+
+    /// <summary>Decodes a blob of NULL separated arguments into a list of arguments.</summary>
+    /// <remarks>
+    /// Unlike decodeCommandLine(), the current executable path is not added: the first argument of the blob is the first argument of the list.
+    /// The last argument of the blob does not require a NULL terminator.
+    /// </remarks>
+    /// <param name="iData">The NULL separated arguments.</param>
+    /// <param name="iSize">The size of the blob in bytes.</param>
+    /// <param name="oArguments">The decoded arguments.</param>
+    /// <returns>Returns true if the blob is decoded. Returns false if iData is NULL.</returns>
+    bool decodeArgumentVector(const char * iData, size_t iSize, ArgumentList & oArguments) const;
+
+    /// <summary>Decodes a blob of NULL separated arguments and sends each argument to the given handler.</summary>
+    /// <remarks>The arguments which are NULL terminated in the blob are given without being copied.</remarks>
+    /// <param name="iData">The NULL separated arguments.</param>
+    /// <param name="iSize">The size of the blob in bytes.</param>
+    /// <param name="iHandler">The handler of the decoded arguments.</param>
+    /// <returns>Returns true if the blob is decoded. Returns false if iData is NULL.</returns>
+    bool decodeArgumentVector(const char * iData, size_t iSize, IArgumentHandler & iHandler) const;
+  };
+
+}; //namespace libargvcodec
+
+#endif //NULSEPARATEDARGUMENTCODEC_H
@@ -0,0 +1,57 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef PARALLELSPAWNER_H
+#define PARALLELSPAWNER_H
+
+#include "libargvcodec/config.h"
+#include "ArgumentList.h"
+#include <vector>
+
+namespace libargvcodec
+{
+
+  /// <summary>Runs multiple processes (for example the batches of a CommandLineSplitter) with a maximum number of concurrent processes.</summary>
+  class LIBARGVCODEC_EXPORT ParallelSpawner
+  {
+  public:
+    typedef std::vector<ArgumentList> ArgumentListVector;
+    typedef std::vector<int> ExitCodeList;
+
+    /// <summary>Runs a process for each given list of arguments and waits for all processes to complete.</summary>
+    /// <remarks>
+    /// The first argument of each list is the executable which is searched in the PATH directories.
+    /// On Linux, the arguments are given to the new process as is, without a shell.
+    /// On Windows, the arguments are encoded with the CreateProcess() rules.
+    /// </remarks>
+    /// <param name="iProcesses">The arguments of each process.</param>
+    /// <param name="iMaxProcesses">The maximum number of concurrent processes. Must be 1 or greater.</param>
+    /// <param name="oExitCodes">The exit code of each process. The exit code is -1 if the process did not exit normally.</param>
+    /// <returns>Returns true if all processes were started. Returns false otherwise.</returns>
+    static bool run(const ArgumentListVector & iProcesses, int iMaxProcesses, ExitCodeList & oExitCodes);
+  };
+
+}; //namespace libargvcodec
+
+#endif //PARALLELSPAWNER_H
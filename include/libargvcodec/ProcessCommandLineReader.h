@@ -0,0 +1,85 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef PROCESSCOMMANDLINEREADER_H
+#define PROCESSCOMMANDLINEREADER_H
+
+#include "ArgumentList.h"
+#include "DecodedCommandLines.h"
+#include <vector>
+
+namespace libargvcodec
+{
+
+  /// <summary>
+  /// Reads the arguments of running processes from /proc/[pid]/cmdline on Linux.
+  /// The file of each process is read in a reusable buffer with as few read calls as possible
+  /// and decoded with NulSeparatedArgumentCodec.
+  /// </summary>
+  /// <remarks>
+  /// The arguments are the original argument vector of a process unless the process modified its own arguments.
+  /// An instance must not be used by multiple threads at the same time. Other systems are not supported: all methods return false.
+  /// </remarks>
+  class LIBARGVCODEC_EXPORT ProcessCommandLineReader
+  {
+  public:
+    static const size_t DEFAULT_BUFFER_SIZE = 65536;
+
+    ProcessCommandLineReader();
+    virtual ~ProcessCommandLineReader();
+
+    /// <summary>Tells if the arguments of processes can be read on this system.</summary>
+    static bool isSupported();
+
+    /// <summary>Reads the arguments of a process.</summary>
+    /// <param name="iPid">The identifier of the process.</param>
+    /// <param name="oArguments">The arguments of the process. The first argument is the argv[0] of the process.</param>
+    /// <returns>Returns true if the arguments are read. Returns false if the process does not exist or can not be read.</returns>
+    bool read(int iPid, ArgumentList & oArguments);
+
+    /// <summary>Reads the arguments of all running processes.</summary>
+    /// <remarks>
+    /// The arguments of all processes are stored in a single DecodedCommandLines instance.
+    /// Processes which terminate while being listed are skipped. Kernel threads have no arguments.
+    /// </remarks>
+    /// <param name="oPids">The identifier of each process, in ascending order. Matches the command lines of oCommandLines.</param>
+    /// <param name="oCommandLines">The arguments of each process.</param>
+    /// <returns>Returns true if the processes are listed. Returns false otherwise.</returns>
+    bool readAll(std::vector<int> & oPids, DecodedCommandLines & oCommandLines);
+
+  private:
+    ProcessCommandLineReader(const ProcessCommandLineReader &);
+    ProcessCommandLineReader & operator=(const ProcessCommandLineReader &);
+
+    /// <summary>Reads the whole content of /proc/[pid]/cmdline in the buffer.</summary>
+    bool readCommandLine(int iPid, size_t & oSize);
+
+    SAFE_WARNING_DISABLE(4251); //warning C4251: 'foo' : class 'std::vector<_Ty>' needs to have dll-interface to be used by clients of class 'bar'
+    std::vector<char> mBuffer;
+    SAFE_WARNING_RESTORE();
+  };
+
+}; //namespace libargvcodec
+
+#endif //PROCESSCOMMANDLINEREADER_H
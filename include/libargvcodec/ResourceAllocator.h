@@ -0,0 +1,109 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef RESOURCEALLOCATOR_H
+#define RESOURCEALLOCATOR_H
+
+#include "IMemoryResource.h"
+#include <string>
+
+namespace libargvcodec
+{
+
+  /// <summary>
+  /// Standard allocator which allocates from an IMemoryResource.
+  /// This is the C++11 equivalent of std::pmr::polymorphic_allocator.
+  /// </summary>
+  /// <remarks>
+  /// Like std::pmr::polymorphic_allocator, the resource is not propagated when a container is copied, moved or swapped.
+  /// A copy of a container uses the default resource.
+  /// </remarks>
+  template <typename T>
+  class ResourceAllocator
+  {
+  public:
+    typedef T value_type;
+
+    /// <summary>Creates an allocator which allocates from the default resource.</summary>
+    ResourceAllocator() :
+      mResource(getDefaultMemoryResource())
+    {
+    }
+
+    /// <summary>Creates an allocator which allocates from the given resource.</summary>
+    /// <param name="iResource">The source of memory. Use NULL to allocate from the default resource.</param>
+    ResourceAllocator(IMemoryResource * iResource) :
+      mResource(iResource != NULL ? iResource : getDefaultMemoryResource())
+    {
+    }
+
+    template <typename U>
+    ResourceAllocator(const ResourceAllocator<U> & iAllocator) :
+      mResource(iAllocator.getResource())
+    {
+    }
+
+    T * allocate(size_t n)
+    {
+      return static_cast<T *>(mResource->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T * p, size_t n)
+    {
+      mResource->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    ResourceAllocator select_on_container_copy_construction() const
+    {
+      return ResourceAllocator();
+    }
+
+    /// <summary>Returns the source of memory of the allocator.</summary>
+    IMemoryResource * getResource() const
+    {
+      return mResource;
+    }
+
+  private:
+    IMemoryResource * mResource;
+  };
+
+  template <typename T, typename U>
+  inline bool operator == (const ResourceAllocator<T> & iLeft, const ResourceAllocator<U> & iRight)
+  {
+    return iLeft.getResource() == iRight.getResource();
+  }
+
+  template <typename T, typename U>
+  inline bool operator != (const ResourceAllocator<T> & iLeft, const ResourceAllocator<U> & iRight)
+  {
+    return !(iLeft == iRight);
+  }
+
+  /// <summary>String which allocates from an IMemoryResource.</summary>
+  typedef std::basic_string<char, std::char_traits<char>, ResourceAllocator<char> > ResourceString;
+
+}; //namespace libargvcodec
+
+#endif //RESOURCEALLOCATOR_H
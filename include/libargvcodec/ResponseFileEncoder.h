@@ -0,0 +1,80 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef RESPONSEFILEENCODER_H
+#define RESPONSEFILEENCODER_H
+
+#include "IArgumentEncoder.h"
+
+namespace libargvcodec
+{
+
+  /// <summary>
+  /// Encodes an ArgumentList into a command line which fits in a maximum length.
+  /// The arguments which do not fit in the command line are written to a response file
+  /// which is referenced from the command line with the @file syntax.
+  /// </summary>
+  class LIBARGVCODEC_EXPORT ResponseFileEncoder
+  {
+  public:
+    /// <summary>Maximum length of a command line in the Windows Command Prompt.</summary>
+    static const size_t CMD_PROMPT_MAX_LENGTH = 8191;
+
+    /// <summary>Maximum length of a command line of the Windows CreateProcess() api.</summary>
+    static const size_t CREATE_PROCESS_MAX_LENGTH = 32767;
+
+    /// <summary>Creates a response file encoder.</summary>
+    /// <param name="iEncoder">The encoder of the command line and of the response file.</param>
+    ResponseFileEncoder(const IArgumentEncoder & iEncoder);
+    virtual ~ResponseFileEncoder();
+
+    /// <summary>Returns the maximum length of the arguments of a new process on the current system (ARG_MAX on Linux).</summary>
+    /// <remarks>On Linux, the environment variables of the new process also count against this limit.</remarks>
+    /// <returns>Returns the maximum length of the arguments of a new process.</returns>
+    static size_t getSystemMaxLength();
+
+    /// <summary>Encodes an ArgumentList into a command line which is not longer than iMaxLength.</summary>
+    /// <remarks>
+    /// Arguments are kept in the command line until the length is reached. The remaining arguments
+    /// are encoded with the same encoder and written, one per line, to the response file with a single write.
+    /// Like encodeCommandLine(), the first argument of the list is skipped.
+    /// </remarks>
+    /// <param name="iArguments">The list of arguments.</param>
+    /// <param name="iMaxLength">The maximum length of the command line in bytes.</param>
+    /// <param name="iResponseFilePath">The path of the response file to create if required.</param>
+    /// <param name="oCommandLine">The encoded command line.</param>
+    /// <param name="oResponseFilePath">The path of the created response file. Empty if all arguments fit in the command line.</param>
+    /// <returns>Returns true on success. Returns false if the response file can not be written or if the response file argument does not fit in iMaxLength.</returns>
+    bool encodeCommandLine(const ArgumentList & iArguments, size_t iMaxLength, const char * iResponseFilePath, std::string & oCommandLine, std::string & oResponseFilePath);
+
+  private:
+    ResponseFileEncoder(const ResponseFileEncoder &);
+    ResponseFileEncoder & operator=(const ResponseFileEncoder &);
+
+    const IArgumentEncoder & mEncoder;
+  };
+
+}; //namespace libargvcodec
+
+#endif //RESPONSEFILEENCODER_H
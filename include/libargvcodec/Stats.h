@@ -0,0 +1,72 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef LIBARGVCODEC_STATS_H
+#define LIBARGVCODEC_STATS_H
+
+#include "libargvcodec/config.h"
+
+#include <stddef.h>
+
+namespace libargvcodec
+{
+  /// <summary>
+  /// Allocation counters of the library.
+  /// The counters are only updated when the library is built with the LIBARGVCODEC_ENABLE_STATS option.
+  /// </summary>
+  /// <remarks>
+  /// The counters are per thread. Only the allocations made by the current thread while running a public method
+  /// of the codecs or ArgumentList are counted. The allocations made by the worker threads of the batch functions are not counted.
+  /// </remarks>
+  namespace stats
+  {
+
+    struct Counters
+    {
+      /// <summary>The number of calls to public methods. Calls made by other public methods are not counted.</summary>
+      size_t calls;
+      /// <summary>The number of heap allocations.</summary>
+      size_t allocations;
+      /// <summary>The number of allocated bytes.</summary>
+      size_t bytes;
+      /// <summary>The number of times the argv array of an ArgumentList is rebuilt.</summary>
+      size_t argvRebuilds;
+    };
+
+    /// <summary>Returns true if the library is built with allocation counters. Returns false otherwise.</summary>
+    LIBARGVCODEC_EXPORT bool isEnabled();
+
+    /// <summary>Returns the counters of the current thread since the last call to resetCounters().</summary>
+    LIBARGVCODEC_EXPORT void getCounters(Counters & oCounters);
+
+    /// <summary>Returns the counters of the last public method called by the current thread.</summary>
+    LIBARGVCODEC_EXPORT void getLastCallCounters(Counters & oCounters);
+
+    /// <summary>Resets the counters of the current thread.</summary>
+    LIBARGVCODEC_EXPORT void resetCounters();
+
+  }; //namespace stats
+}; //namespace libargvcodec
+
+#endif //LIBARGVCODEC_STATS_H
@@ -0,0 +1,98 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef STREAMARGUMENTDECODER_H
+#define STREAMARGUMENTDECODER_H
+
+#include "IArgumentDecoder.h"
+#include "IArgumentStreamDecoder.h"
+#include "DecodedCommandLines.h"
+#include "DecodedCommandLineCache.h"
+
+namespace libargvcodec
+{
+
+  /// <summary>
+  /// Base class of the decoders which decode their dialect with a stream decoder.
+  /// Implements response files, batch decoding and shared snapshots once for all dialects.
+  /// </summary>
+  class LIBARGVCODEC_EXPORT StreamArgumentDecoder : public virtual IArgumentDecoder
+  {
+  public:
+    StreamArgumentDecoder();
+    virtual ~StreamArgumentDecoder();
+
+    /// <summary>Creates a stream decoder of the dialect of the decoder.</summary>
+    /// <param name="iHandler">The handler of the decoded arguments.</param>
+    /// <returns>Returns a new stream decoder. The caller must delete it.</returns>
+    virtual IArgumentStreamDecoder * createStreamDecoder(IArgumentHandler & iHandler) const = 0;
+
+    /// <summary>Replaces each @file argument of the list by the arguments decoded from the given file (response file).</summary>
+    /// <remarks>
+    /// The files are mapped in memory and decoded in place. New lines are argument separators.
+    /// Response files may include other response files. The first argument of the list is never expanded.
+    /// </remarks>
+    /// <param name="ioArguments">The list of arguments to expand.</param>
+    /// <returns>Returns true if all response files are expanded. Returns false if a file can not be read or if a file includes itself. The list is unchanged on failure.</returns>
+    bool expandResponseFiles(ArgumentList & ioArguments) const;
+
+    /// <summary>Decodes multiple command lines in parallel.</summary>
+    /// <remarks>
+    /// The command lines are split in chunks which are decoded by multiple threads. Each thread decodes its chunks into its own storage
+    /// and the results are concatenated in order. Unlike decodeCommandLine(), the current executable path is not added to the arguments.
+    /// </remarks>
+    /// <param name="iCommandLines">The command lines to decode. NULL elements are decoded as empty command lines.</param>
+    /// <param name="iCount">The number of command lines.</param>
+    /// <param name="oResult">The arguments of all decoded command lines.</param>
+    /// <param name="iNumThreads">The number of threads to use. Use 0 for the number of processors of the system.</param>
+    /// <returns>Returns true if the command lines are decoded. Returns false if iCommandLines is NULL.</returns>
+    bool decodeBatch(const char * const * iCommandLines, size_t iCount, DecodedCommandLines & oResult, int iNumThreads = 0) const;
+
+    /// <summary>Decodes a command line into an immutable snapshot which can be shared between threads.</summary>
+    /// <remarks>
+    /// If a decode cache is set, the snapshot is looked up in the cache first and a hit returns the cached snapshot without copying the arguments.
+    /// Unlike decodeCommandLine(), the current executable path is not added to the arguments.
+    /// </remarks>
+    /// <param name="iValue">The command line to decode.</param>
+    /// <returns>Returns the decoded arguments as a single command line. Returns a NULL pointer if iValue is NULL.</returns>
+    DecodedCommandLinesPtr decodeShared(const char * iValue) const;
+
+    /// <summary>Sets the cache of decoded command lines used by decodeCommandLine() and decodeShared().</summary>
+    /// <remarks>
+    /// The cache is disabled by default. The cache is not owned by the decoder and must outlive it.
+    /// The cache may be shared by multiple decoders and threads but this method must not be called while the decoder is decoding.
+    /// </remarks>
+    /// <param name="iCache">The cache of decoded command lines. Use NULL to disable the cache.</param>
+    void setDecodeCache(DecodedCommandLineCache * iCache);
+
+    /// <summary>Returns the cache of decoded command lines of the decoder. Returns NULL if the cache is disabled.</summary>
+    DecodedCommandLineCache * getDecodeCache() const;
+
+  private:
+    DecodedCommandLineCache * mDecodeCache;
+  };
+
+}; //namespace libargvcodec
+
+#endif //STREAMARGUMENTDECODER_H
@@ -27,54 +27,52 @@
 
 #include "IArgumentEncoder.h"
 #include "IArgumentDecoder.h"
+#include "StreamArgumentDecoder.h"
 
 namespace libargvcodec
 {
 
   class LIBARGVCODEC_EXPORT TerminalArgumentCodec : public virtual IArgumentEncoder,
-    public virtual IArgumentDecoder
+    public StreamArgumentDecoder
   {
   public:
     TerminalArgumentCodec();
     virtual ~TerminalArgumentCodec();
 
     //IArgumentEncoder
-    virtual std::string encodeArgument(const char * iValue);
-    virtual std::string encodeCommandLine(const ArgumentList & iArguments);
+    virtual std::string encodeArgument(const char * iValue) const;
+    virtual std::string encodeCommandLine(const ArgumentList & iArguments) const;
+    virtual void appendEncodedArgument(const char * iValue, ResourceString & ioOutput) const;
 
     //IArgumentDecoder
-    virtual std::string decodeArgument(const char * iValue);
-    virtual ArgumentList decodeCommandLine(const char * iValue);
+    virtual std::string decodeArgument(const char * iValue) const;
+    virtual ArgumentList decodeCommandLine(const char * iValue) const;
+
+    //StreamArgumentDecoder
+    virtual IArgumentStreamDecoder * createStreamDecoder(IArgumentHandler & iHandler) const;
 
   public:
     /// <summary>Returns true if the given character is an argument separator character.</summary>
     /// <param name="c">The given character to test.</param>
     /// <returns>Returns true if the given character is an argument separator character. Returns false otherwise.</returns>
-    virtual bool isArgumentSeparator(const char c);
+    virtual bool isArgumentSeparator(const char c) const;
 
     /// <summary>Returns true if the given character is a shell character.</summary>
     /// <param name="c">The given character to test.</param>
     /// <returns>Returns true if the given character is a shell character. Returns false otherwise.</returns>
-    virtual bool isShellCharacter(const char c);
+    virtual bool isShellCharacter(const char c) const;
 
     /// <summary>Returns true if the given string has at least one shell character.</summary>
     /// <param name="iValue">The given string to test. Must not be NULL.</param>
     /// <returns>Returns true if the given string has at least one shell character. Returns false otherwise.</returns>
-    virtual bool hasShellCharacters(const char * iValue);
+    virtual bool hasShellCharacters(const char * iValue) const;
 
   protected:
     /// <summary>Parses a command line string into a list of arguments.</summary>
     /// <param name="iCmdLine">The command line string to parse.</param>
     /// <param name="oArguments">The output list of arguments.</param>
     /// <returns>Returns true on parse success. Returns false otherwise.</returns>
-    bool parseCmdLine(const char * iCmdLine, ArgumentList::StringList & oArguments);
-
-    /// <summary>Returns the character at offset iIndex of the given string. The function is safe as it returns \0 if iIndex is out-of-range.</summary>
-    /// <param name="iValue">The given string.</param>
-    /// <param name="iIndex">The character offset within the given iValue string.</param>
-    /// <returns>Returns the character at offset iIndex of the given string. The function is safe as it returns \0 if iIndex is out-of-range.</returns>
-    char getSafeCharacter(const char * iValue, size_t iIndex);
-
+    bool parseCmdLine(const char * iCmdLine, ArgumentList::StringList & oArguments) const;
   };
 
 }; //namespace libargvcodec
@@ -0,0 +1,69 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef TERMINALSTREAMDECODER_H
+#define TERMINALSTREAMDECODER_H
+
+#include "IArgumentStreamDecoder.h"
+#include "ResourceAllocator.h"
+
+namespace libargvcodec
+{
+
+  /// <summary>Decodes command lines of Linux terminals in chunks.</summary>
+  class LIBARGVCODEC_EXPORT TerminalStreamDecoder : public virtual IArgumentStreamDecoder
+  {
+  public:
+    /// <summary>Creates a decoder which sends the decoded arguments to the given handler.</summary>
+    /// <param name="iHandler">The handler of the decoded arguments.</param>
+    /// <param name="iResource">The source of memory of the decoder. Use NULL to allocate from the global heap.</param>
+    TerminalStreamDecoder(IArgumentHandler & iHandler, IMemoryResource * iResource = NULL);
+    virtual ~TerminalStreamDecoder();
+
+    //IArgumentStreamDecoder
+    virtual void reset();
+    virtual bool feed(const char * iBuffer, size_t iLength);
+    virtual bool finish();
+
+  private:
+    TerminalStreamDecoder(const TerminalStreamDecoder &);
+    TerminalStreamDecoder & operator=(const TerminalStreamDecoder &);
+
+    /// <summary>Decodes a single character of the command line.</summary>
+    /// <param name="c">The character to decode.</param>
+    inline void process(const char c);
+
+    /// <summary>Sends the accumulated argument to the handler.</summary>
+    void flush();
+
+    IArgumentHandler & mHandler;
+    ResourceString mAccumulator;
+    unsigned char mState;
+    bool mIsStringEmpty;    //true while no character was read since the beginning of the current string.
+    bool mIsEmptyArgument;  //true when the last string is detected as an empty string.
+  };
+
+}; //namespace libargvcodec
+
+#endif //TERMINALSTREAMDECODER_H
@@ -0,0 +1,108 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef LIBARGVCODEC_TRACING_H
+#define LIBARGVCODEC_TRACING_H
+
+#include "libargvcodec/config.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace libargvcodec
+{
+  /// <summary>
+  /// Trace points of the codecs and ArgumentList.
+  /// The trace points are only compiled when the library is built with the LIBARGVCODEC_ENABLE_TRACING option.
+  /// </summary>
+  /// <remarks>
+  /// Events are sent to a user-supplied callback or to a per-thread ring buffer.
+  /// When no sink is enabled, a trace point costs a single relaxed atomic load.
+  /// </remarks>
+  namespace tracing
+  {
+
+    enum Phase
+    {
+      /// <summary>Classification of the characters of an argument before encoding.</summary>
+      PHASE_CLASSIFY,
+      /// <summary>Quoting and escaping of an argument.</summary>
+      PHASE_ESCAPE,
+      /// <summary>Decoding of a command line into arguments.</summary>
+      PHASE_ACCUMULATE,
+      /// <summary>Initialization of the arguments and argv array of an ArgumentList.</summary>
+      PHASE_ARGUMENT_LIST_INIT,
+      NUM_PHASES
+    };
+
+    struct Event
+    {
+      /// <summary>The traced phase.</summary>
+      Phase phase;
+      /// <summary>The time spent in the phase, in nanoseconds.</summary>
+      uint64_t duration;
+      /// <summary>The number of arguments processed by the phase.</summary>
+      size_t numArguments;
+      /// <summary>The number of bytes processed by the phase.</summary>
+      size_t numBytes;
+    };
+
+    /// <summary>Function called for each event. Called from the thread that runs the traced phase.</summary>
+    typedef void (*Callback)(const Event & iEvent, void * iUserData);
+
+    /// <summary>The number of events kept by the ring buffer of each thread.</summary>
+    static const size_t RING_BUFFER_CAPACITY = 1024;
+
+    /// <summary>Returns true if the library is built with trace points. Returns false otherwise.</summary>
+    LIBARGVCODEC_EXPORT bool isEnabled();
+
+    /// <summary>Sets the function which receives the events. Use NULL to disable the callback.</summary>
+    /// <remarks>Should not be called while other threads are running traced methods.</remarks>
+    /// <param name="iCallback">The function called for each event.</param>
+    /// <param name="iUserData">A value given back to the function.</param>
+    LIBARGVCODEC_EXPORT void setCallback(Callback iCallback, void * iUserData);
+
+    /// <summary>
+    /// Enables or disables the ring buffers. Each thread writes its events to its own ring buffer
+    /// without locking. Events are dropped when the ring buffer of a thread is full.
+    /// </summary>
+    LIBARGVCODEC_EXPORT void setRingBufferEnabled(bool iEnabled);
+
+    /// <summary>Moves the events of the ring buffers of all threads to the given list.</summary>
+    /// <param name="oEvents">The list which receives the events. Events are appended to the list.</param>
+    /// <returns>Returns the number of events which were dropped since the last call because a ring buffer was full.</returns>
+    LIBARGVCODEC_EXPORT size_t collectEvents(std::vector<Event> & oEvents);
+
+    /// <summary>Traces only one event out of iInterval events of each phase and thread. The default value is 1 which traces all events.</summary>
+    /// <param name="iInterval">The sampling interval. A value of 0 is handled as 1.</param>
+    LIBARGVCODEC_EXPORT void setSamplingInterval(size_t iInterval);
+
+    /// <summary>Returns the name of the given phase.</summary>
+    LIBARGVCODEC_EXPORT const char * getPhaseName(Phase iPhase);
+
+  }; //namespace tracing
+}; //namespace libargvcodec
+
+#endif //LIBARGVCODEC_TRACING_H
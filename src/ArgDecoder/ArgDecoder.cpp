@@ -0,0 +1,454 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <iostream>
+#include <vector>
+#ifdef _WIN32
+#include <io.h>    //for _setmode()
+#include <fcntl.h> //for _O_BINARY
+#endif
+
+#include "libargvcodec/version.h"
+#include "libargvcodec/ArgumentList.h"
+#include "libargvcodec/CmdPromptArgumentCodec.h"
+#include "libargvcodec/CreateProcessArgumentCodec.h"
+#include "libargvcodec/TerminalArgumentCodec.h"
+#include "libargvcodec/DecodedCommandLines.h"
+
+using namespace libargvcodec;
+using namespace std;
+
+void printHeader()
+{
+  cout << "argdecoder v" << LIBARGVCODEC_VERSION << " - command line decoder" << endl;
+  cout << endl;
+}
+
+void printUsage()
+{
+  cout << "usage: argdecoder [--input=<file>] [--dialect=<name>] [--delimiter=<name>] [--format=<name>] [--threads=<count>]" << endl;
+  cout << endl;
+  cout << "Command lines are read from stdin or from the input file." << endl;
+  cout << "Each command line is terminated by the delimiter. The arguments of each command line are written to stdout." << endl;
+  cout << "  --dialect:   cmdprompt, createprocess or terminal. Defaults to terminal." << endl;
+  cout << "  --delimiter: newline or nul. Defaults to newline." << endl;
+  cout << "  --format:    nul or json. Defaults to nul." << endl;
+  cout << "               With nul, each command line starts with its number of arguments in decimal followed by a NUL character" << endl;
+  cout << "               and each argument is followed by a NUL character." << endl;
+  cout << "               With json, the arguments of each command line are written as a json array on a single line." << endl;
+  cout << "               Bytes which are not valid UTF-8 are replaced by U+FFFD." << endl;
+  cout << "  --threads:   number of decoding threads. Defaults to the number of processors." << endl;
+}
+
+enum Dialect
+{
+  DIALECT_CMDPROMPT,
+  DIALECT_CREATEPROCESS,
+  DIALECT_TERMINAL,
+};
+
+enum OutputFormat
+{
+  FORMAT_NUL,
+  FORMAT_JSON,
+};
+
+struct Options
+{
+  std::string inputPath;
+  Dialect dialect;
+  char delimiter;
+  OutputFormat format;
+  int numThreads;
+};
+
+/// <summary>Number of bytes read from the input at once.</summary>
+static const size_t READ_SIZE = 1024*1024;
+
+/// <summary>Number of command lines decoded and written at once.</summary>
+static const size_t BATCH_NUM_COMMAND_LINES = 16384;
+
+bool parseOptions(const ArgumentList & iArguments, Options & oOptions)
+{
+  oOptions.inputPath.clear();
+  oOptions.dialect = DIALECT_TERMINAL;
+  oOptions.delimiter = '\n';
+  oOptions.format = FORMAT_NUL;
+  oOptions.numThreads = 0;
+
+  int index = -1;
+  std::string value;
+  if (iArguments.findValue("--input=", index, value))
+    oOptions.inputPath = value;
+
+  if (iArguments.findValue("--dialect=", index, value))
+  {
+    if (value == "cmdprompt")
+      oOptions.dialect = DIALECT_CMDPROMPT;
+    else if (value == "createprocess")
+      oOptions.dialect = DIALECT_CREATEPROCESS;
+    else if (value == "terminal")
+      oOptions.dialect = DIALECT_TERMINAL;
+    else
+      return false;
+  }
+
+  if (iArguments.findValue("--delimiter=", index, value))
+  {
+    if (value == "newline")
+      oOptions.delimiter = '\n';
+    else if (value == "nul")
+      oOptions.delimiter = '\0';
+    else
+      return false;
+  }
+
+  if (iArguments.findValue("--format=", index, value))
+  {
+    if (value == "nul")
+      oOptions.format = FORMAT_NUL;
+    else if (value == "json")
+      oOptions.format = FORMAT_JSON;
+    else
+      return false;
+  }
+
+  int numThreads = 0;
+  if (iArguments.findValue("--threads=", index, numThreads))
+  {
+    if (numThreads < 0)
+      return false;
+    oOptions.numThreads = numThreads;
+  }
+
+  return true;
+}
+
+/// <summary>Returns the length of the valid UTF-8 sequence at the given position. Returns 0 if the sequence is invalid.</summary>
+size_t getUtf8SequenceLength(const unsigned char * iValue, size_t iLength)
+{
+  const unsigned char c = iValue[0];
+  size_t length = 0;
+  unsigned char secondMin = 0x80; //range of the second byte
+  unsigned char secondMax = 0xBF;
+  if (c >= 0xC2 && c <= 0xDF)
+    length = 2;
+  else if (c >= 0xE0 && c <= 0xEF)
+  {
+    length = 3;
+    if (c == 0xE0)
+      secondMin = 0xA0; //overlong
+    else if (c == 0xED)
+      secondMax = 0x9F; //surrogates
+  }
+  else if (c >= 0xF0 && c <= 0xF4)
+  {
+    length = 4;
+    if (c == 0xF0)
+      secondMin = 0x90; //overlong
+    else if (c == 0xF4)
+      secondMax = 0x8F; //above U+10FFFF
+  }
+  else
+    return 0;
+
+  if (iLength < length || iValue[1] < secondMin || iValue[1] > secondMax)
+    return 0;
+  for(size_t i=2; i<length; i++)
+  {
+    if ((iValue[i] & 0xC0) != 0x80)
+      return 0;
+  }
+  return length;
+}
+
+void appendJsonString(const char * iValue, size_t iLength, std::string & ioOutput)
+{
+  static const char * gHexDigits = "0123456789abcdef";
+
+  ioOutput.append(1, '\"');
+  for(size_t i=0; i<iLength; i++)
+  {
+    const unsigned char c = (unsigned char)iValue[i];
+    switch(c)
+    {
+    case '\"': ioOutput.append("\\\""); break;
+    case '\\': ioOutput.append("\\\\"); break;
+    case '\b': ioOutput.append("\\b"); break;
+    case '\f': ioOutput.append("\\f"); break;
+    case '\n': ioOutput.append("\\n"); break;
+    case '\r': ioOutput.append("\\r"); break;
+    case '\t': ioOutput.append("\\t"); break;
+    default:
+      if (c < 0x20)
+      {
+        ioOutput.append("\\u00");
+        ioOutput.append(1, gHexDigits[c >> 4]);
+        ioOutput.append(1, gHexDigits[c & 0x0F]);
+      }
+      else if (c < 0x80)
+        ioOutput.append(1, (char)c);
+      else
+      {
+        //json strings must be valid UTF-8
+        const size_t length = getUtf8SequenceLength((const unsigned char *)iValue + i, iLength - i);
+        if (length == 0)
+          ioOutput.append("\\ufffd");
+        else
+        {
+          ioOutput.append(iValue + i, length);
+          i += length - 1;
+        }
+      }
+    };
+  }
+  ioOutput.append(1, '\"');
+}
+
+/// <summary>Command lines of a batch, copied and NULL terminated.</summary>
+class CommandLineBatch
+{
+public:
+  void add(const char * iValue, size_t iLength)
+  {
+    mOffsets.push_back(mBuffer.size());
+    mBuffer.insert(mBuffer.end(), iValue, iValue + iLength);
+    mBuffer.push_back('\0');
+  }
+
+  size_t size() const
+  {
+    return mOffsets.size();
+  }
+
+  void clear()
+  {
+    mBuffer.clear();
+    mOffsets.clear();
+  }
+
+  /// <summary>Returns the command lines. The pointers are valid until the next call to add() or clear().</summary>
+  const char * const * getCommandLines()
+  {
+    mCommandLines.resize(mOffsets.size());
+    for(size_t i=0; i<mOffsets.size(); i++)
+      mCommandLines[i] = &mBuffer[mOffsets[i]];
+    return (mCommandLines.empty() ? NULL : &mCommandLines[0]);
+  }
+
+private:
+  std::vector<char> mBuffer;
+  std::vector<size_t> mOffsets;
+  std::vector<const char *> mCommandLines;
+};
+
+class CommandLineDecoder
+{
+public:
+  CommandLineDecoder(const Options & iOptions) :
+    mOptions(iOptions),
+    mScanned(0),
+    mSuccess(true)
+  {
+  }
+
+  /// <summary>Splits the given bytes in command lines.</summary>
+  /// <remarks>The bytes of an incomplete command line which were already searched for a delimiter are not searched again.</remarks>
+  /// <param name="iFinal">True if the bytes are the end of the input. The last command line does not require a delimiter.</param>
+  /// <returns>Returns the number of bytes which belong to complete command lines. The remaining bytes must be given again with the next bytes.</returns>
+  size_t process(const char * iData, size_t iSize, bool iFinal)
+  {
+    const char * position = iData;
+    const char * end = iData + iSize;
+    const char * scan = iData + mScanned;
+    mScanned = 0;
+    while (position < end && mSuccess)
+    {
+      const char * delimiter = (const char *)memchr(scan, mOptions.delimiter, end - scan);
+      if (delimiter == NULL)
+      {
+        if (!iFinal)
+        {
+          mScanned = (size_t)(end - position);
+          break;
+        }
+        delimiter = end;
+      }
+
+      size_t length = (size_t)(delimiter - position);
+
+      //tolerate CRLF line endings
+      if (mOptions.delimiter == '\n' && length > 0 && position[length-1] == '\r')
+        length--;
+
+      mBatch.add(position, length);
+      position = (delimiter < end ? delimiter + 1 : end);
+      scan = position;
+
+      if (mBatch.size() >= BATCH_NUM_COMMAND_LINES)
+        flush();
+    }
+    return (size_t)(position - iData);
+  }
+
+  /// <summary>Decodes the pending command lines and writes their arguments at once.</summary>
+  void flush()
+  {
+    if (mBatch.size() == 0 || !mSuccess)
+      return;
+
+    const char * const * cmdLines = mBatch.getCommandLines();
+    switch(mOptions.dialect)
+    {
+    case DIALECT_CMDPROMPT:
+      CmdPromptArgumentCodec().decodeBatch(cmdLines, mBatch.size(), mDecoded, mOptions.numThreads);
+      break;
+    case DIALECT_CREATEPROCESS:
+      CreateProcessArgumentCodec().decodeBatch(cmdLines, mBatch.size(), mDecoded, mOptions.numThreads);
+      break;
+    case DIALECT_TERMINAL:
+      TerminalArgumentCodec().decodeBatch(cmdLines, mBatch.size(), mDecoded, mOptions.numThreads);
+      break;
+    };
+    mBatch.clear();
+
+    mOutput.clear();
+    for(size_t i=0; i<mDecoded.getNumCommandLines(); i++)
+    {
+      const size_t argc = mDecoded.getArgc(i);
+      if (mOptions.format == FORMAT_JSON)
+        mOutput.append(1, '[');
+      else
+      {
+        //the number of arguments makes empty arguments and empty command lines unambiguous
+        char count[32];
+        sprintf(count, "%lu", (unsigned long)argc);
+        mOutput.append(count, strlen(count) + 1); //including the NULL terminator
+      }
+      for(size_t j=0; j<argc; j++)
+      {
+        const char * value = mDecoded.getArgument(i, j);
+        const size_t length = mDecoded.getArgumentLength(i, j);
+        if (mOptions.format == FORMAT_JSON)
+        {
+          if (j > 0)
+            mOutput.append(1, ',');
+          appendJsonString(value, length, mOutput);
+        }
+        else
+          mOutput.append(value, length + 1); //including the NULL terminator
+      }
+      if (mOptions.format == FORMAT_JSON)
+        mOutput.append("]\n");
+    }
+
+    mSuccess = (fwrite(mOutput.data(), 1, mOutput.size(), stdout) == mOutput.size());
+  }
+
+  bool isSuccess() const
+  {
+    return mSuccess;
+  }
+
+private:
+  const Options & mOptions;
+  CommandLineBatch mBatch;
+  DecodedCommandLines mDecoded;
+  std::string mOutput;
+  size_t mScanned; //bytes of the incomplete command line which do not contain a delimiter
+  bool mSuccess;
+};
+
+int main(int argc, char* argv[])
+{
+  ArgumentList arguments;
+  arguments.init(argc, argv);
+
+  if (arguments.findOption("--help") || arguments.findOption("-h"))
+  {
+    printHeader();
+    printUsage();
+    return 0;
+  }
+
+  Options options;
+  if (!parseOptions(arguments, options))
+  {
+    printUsage();
+    return 1;
+  }
+
+#ifdef _WIN32
+  _setmode(_fileno(stdin), _O_BINARY);
+  _setmode(_fileno(stdout), _O_BINARY);
+#endif
+
+  FILE * input = stdin;
+  if (!options.inputPath.empty())
+  {
+    input = fopen(options.inputPath.c_str(), "rb");
+    if (input == NULL)
+    {
+      cerr << "unable to open input file '" << options.inputPath << "'" << endl;
+      return 1;
+    }
+  }
+
+  CommandLineDecoder decoder(options);
+  std::vector<char> buffer;
+  size_t pending = 0; //bytes of an incomplete command line at the beginning of the buffer
+  bool eof = false;
+  while (!eof && decoder.isSuccess())
+  {
+    if (buffer.size() < pending + READ_SIZE)
+      buffer.resize(pending + READ_SIZE);
+
+    size_t size = fread(&buffer[pending], 1, READ_SIZE, input);
+    eof = (size < READ_SIZE);
+    if (eof && ferror(input))
+    {
+      cerr << "unable to read input" << endl;
+      if (input != stdin)
+        fclose(input);
+      return 1;
+    }
+
+    size += pending;
+    size_t processed = decoder.process(&buffer[0], size, eof);
+    pending = size - processed;
+    if (pending > 0 && processed > 0)
+      memmove(&buffer[0], &buffer[processed], pending);
+  }
+  if (input != stdin)
+    fclose(input);
+  decoder.flush();
+
+  bool success = decoder.isSuccess();
+  if (fflush(stdout) != 0)
+    success = false;
+
+  return (success ? 0 : 1);
+}
@@ -23,10 +23,17 @@
  *********************************************************************************/
 
 #include <stdio.h>
+#include <string.h>
 #include <iostream>
+#include <vector>
+#ifdef _WIN32
+#include <io.h>    //for _setmode()
+#include <fcntl.h> //for _O_BINARY
+#endif
 
 #include "libargvcodec/version.h"
 #include "libargvcodec/ArgumentList.h"
+#include "libargvcodec/BatchEncoder.h"
 #include "libargvcodec/CmdPromptArgumentCodec.h"
 #include "libargvcodec/CreateProcessArgumentCodec.h"
 #include "libargvcodec/TerminalArgumentCodec.h"
@@ -42,7 +49,250 @@ void printHeader()
   cout << endl;
 }
 
-int main(int argc, char* argv[])
+void printUsage()
+{
+  cout << "usage: argencoder [--batch [--input=<file>] [--dialect=<name>] [--delimiter=<name>] [--threads=<count>]]" << endl;
+  cout << endl;
+  cout << "Without arguments, the arguments are entered interactively." << endl;
+  cout << endl;
+  cout << "In batch mode, argument lists are read from stdin or from the input file." << endl;
+  cout << "Each argument list starts with its number of arguments in decimal followed by the delimiter" << endl;
+  cout << "and each argument is followed by the delimiter. This is the nul output format of argdecoder." << endl;
+  cout << "The encoded command line of each argument list is written to stdout, followed by the delimiter." << endl;
+  cout << "  --dialect:   cmdprompt, createprocess, terminal or all. Defaults to all." << endl;
+  cout << "               With all, the command lines are written in the order cmdprompt, createprocess, terminal." << endl;
+  cout << "  --delimiter: newline or nul. Defaults to newline." << endl;
+  cout << "  --threads:   number of encoding threads. Defaults to the number of processors." << endl;
+}
+
+enum Dialect
+{
+  DIALECT_CMDPROMPT,
+  DIALECT_CREATEPROCESS,
+  DIALECT_TERMINAL,
+  DIALECT_ALL,
+};
+
+struct BatchOptions
+{
+  std::string inputPath;
+  Dialect dialect;
+  char delimiter;
+  int numThreads;
+};
+
+/// <summary>Number of bytes read from the input at once.</summary>
+static const size_t BATCH_READ_SIZE = 1024*1024;
+
+/// <summary>Number of argument lists encoded and written at once.</summary>
+static const size_t BATCH_NUM_ARGUMENT_LISTS = 4096;
+
+bool parseBatchOptions(const ArgumentList & iArguments, BatchOptions & oOptions)
+{
+  oOptions.inputPath.clear();
+  oOptions.dialect = DIALECT_ALL;
+  oOptions.delimiter = '\n';
+  oOptions.numThreads = 0;
+
+  int index = -1;
+  std::string value;
+  if (iArguments.findValue("--input=", index, value))
+    oOptions.inputPath = value;
+
+  if (iArguments.findValue("--dialect=", index, value))
+  {
+    if (value == "cmdprompt")
+      oOptions.dialect = DIALECT_CMDPROMPT;
+    else if (value == "createprocess")
+      oOptions.dialect = DIALECT_CREATEPROCESS;
+    else if (value == "terminal")
+      oOptions.dialect = DIALECT_TERMINAL;
+    else if (value == "all")
+      oOptions.dialect = DIALECT_ALL;
+    else
+      return false;
+  }
+
+  if (iArguments.findValue("--delimiter=", index, value))
+  {
+    if (value == "newline")
+      oOptions.delimiter = '\n';
+    else if (value == "nul")
+      oOptions.delimiter = '\0';
+    else
+      return false;
+  }
+
+  int numThreads = 0;
+  if (iArguments.findValue("--threads=", index, numThreads))
+  {
+    if (numThreads < 0)
+      return false;
+    oOptions.numThreads = numThreads;
+  }
+
+  return true;
+}
+
+/// <summary>Encodes the argument lists with the selected dialect and writes the command lines at once.</summary>
+bool writeBatch(const BatchOptions & iOptions, const std::vector<ArgumentList> & iArgumentLists, std::string & ioOutput, FILE * iFile)
+{
+  if (iArgumentLists.empty())
+    return true;
+
+  ioOutput.clear();
+  switch(iOptions.dialect)
+  {
+  case DIALECT_CMDPROMPT:
+    BatchEncoder::encodeBatch(CmdPromptArgumentCodec(), &iArgumentLists[0], iArgumentLists.size(), iOptions.delimiter, ioOutput, iOptions.numThreads);
+    break;
+  case DIALECT_CREATEPROCESS:
+    BatchEncoder::encodeBatch(CreateProcessArgumentCodec(), &iArgumentLists[0], iArgumentLists.size(), iOptions.delimiter, ioOutput, iOptions.numThreads);
+    break;
+  case DIALECT_TERMINAL:
+    BatchEncoder::encodeBatch(TerminalArgumentCodec(), &iArgumentLists[0], iArgumentLists.size(), iOptions.delimiter, ioOutput, iOptions.numThreads);
+    break;
+  case DIALECT_ALL:
+    {
+      //encode all dialects in parallel. The command lines are separated by NUL characters
+      //which never appear in a command line, then the dialects of each argument list are interleaved.
+      BatchEncoder::DialectCommandLines cmdLines;
+      BatchEncoder::encodeBatchAllDialects(&iArgumentLists[0], iArgumentLists.size(), '\0', cmdLines, iOptions.numThreads);
+      const std::string * dialects[] = {&cmdLines.cmdPrompt, &cmdLines.createProcess, &cmdLines.terminal};
+      size_t offsets[] = {0, 0, 0};
+      ioOutput.reserve(cmdLines.cmdPrompt.size() + cmdLines.createProcess.size() + cmdLines.terminal.size());
+      for(size_t i=0; i<iArgumentLists.size(); i++)
+      {
+        for(size_t j=0; j<3; j++)
+        {
+          const std::string & dialect = *dialects[j];
+          size_t end = dialect.find('\0', offsets[j]);
+          ioOutput.append(dialect, offsets[j], end - offsets[j]);
+          ioOutput.append(1, iOptions.delimiter);
+          offsets[j] = end + 1;
+        }
+      }
+    }
+    break;
+  };
+
+  return (fwrite(ioOutput.data(), 1, ioOutput.size(), iFile) == ioOutput.size());
+}
+
+int runBatch(const BatchOptions & iOptions)
+{
+  FILE * input = stdin;
+  if (!iOptions.inputPath.empty())
+  {
+    input = fopen(iOptions.inputPath.c_str(), "rb");
+    if (input == NULL)
+    {
+      cerr << "unable to open input file '" << iOptions.inputPath << "'" << endl;
+      return 1;
+    }
+  }
+#ifdef _WIN32
+  else
+    _setmode(_fileno(stdin), _O_BINARY);
+  _setmode(_fileno(stdout), _O_BINARY);
+#endif
+
+  std::vector<char> buffer(BATCH_READ_SIZE);
+  std::string field;      //field being read, may span multiple reads
+  std::string output;
+  ArgumentList::StringList arguments;
+  arguments.push_back("foo.exe"); //argv[0] is always the path of the current process
+  size_t remaining = 0;   //number of arguments of the current list which are not read yet
+  bool inList = false;    //true if the count of the current list was read
+  std::vector<ArgumentList> argumentLists;
+  argumentLists.reserve(BATCH_NUM_ARGUMENT_LISTS);
+
+  bool success = true;
+  bool eof = false;
+  while (success && !eof)
+  {
+    size_t size = fread(&buffer[0], 1, buffer.size(), input);
+    eof = (size < buffer.size());
+    if (eof && ferror(input))
+    {
+      cerr << "unable to read input" << endl;
+      success = false;
+      break;
+    }
+
+    const char * position = &buffer[0];
+    const char * end = position + size;
+    while (position < end || (eof && !field.empty()))
+    {
+      const char * delimiter = (position < end ? (const char *)memchr(position, iOptions.delimiter, end - position) : NULL);
+      if (delimiter == NULL && !eof)
+      {
+        field.append(position, end);
+        break;
+      }
+
+      //at the end of the input, the last field does not require a delimiter
+      if (delimiter == NULL)
+        delimiter = end;
+      field.append(position, delimiter);
+      position = (delimiter < end ? delimiter + 1 : end);
+
+      //tolerate CRLF line endings
+      if (iOptions.delimiter == '\n' && !field.empty() && field[field.size()-1] == '\r')
+        field.erase(field.size()-1);
+
+      if (!inList)
+      {
+        //the number of arguments of the next list
+        char * last = NULL;
+        remaining = (size_t)strtoul(field.c_str(), &last, 10);
+        if (field.empty() || *last != '\0' || field[0] == '-')
+        {
+          cerr << "invalid argument count '" << field << "'" << endl;
+          success = false;
+          break;
+        }
+        inList = true;
+      }
+      else
+      {
+        arguments.push_back(field);
+        remaining--;
+      }
+      field.clear();
+
+      if (inList && remaining == 0)
+      {
+        argumentLists.push_back(ArgumentList());
+        argumentLists.back().init(arguments);
+        arguments.resize(1);
+        inList = false;
+      }
+    }
+
+    if (success && eof && inList)
+    {
+      cerr << "truncated argument list" << endl;
+      success = false;
+    }
+
+    if (success && (argumentLists.size() >= BATCH_NUM_ARGUMENT_LISTS || eof))
+    {
+      success = writeBatch(iOptions, argumentLists, output, stdout);
+      argumentLists.clear();
+    }
+  }
+
+  if (input != stdin)
+    fclose(input);
+
+  if (fflush(stdout) != 0)
+    success = false;
+
+  return (success ? 0 : 1);
+}
+
+int runInteractive()
 {
   printHeader();
 
@@ -120,3 +370,29 @@ int main(int argc, char* argv[])
 
 	return 0;
 }
+
+int main(int argc, char* argv[])
+{
+  ArgumentList arguments;
+  arguments.init(argc, argv);
+
+  if (arguments.findOption("--help") || arguments.findOption("-h"))
+  {
+    printHeader();
+    printUsage();
+    return 0;
+  }
+
+  if (arguments.findOption("--batch"))
+  {
+    BatchOptions options;
+    if (!parseBatchOptions(arguments, options))
+    {
+      printUsage();
+      return 1;
+    }
+    return runBatch(options);
+  }
+
+  return runInteractive();
+}
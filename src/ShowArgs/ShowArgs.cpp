@@ -23,13 +23,18 @@
  *********************************************************************************/
 
 #include <stdio.h>
-#include <iostream>
+#include <string.h>
+#include <string>
+#ifdef _WIN32
+#include <io.h>    //for _setmode()
+#include <fcntl.h> //for _O_BINARY
+#else
+#include <unistd.h> //for execl()
+#endif
 
 #include "rapidassist/console.h"
 #include "rapidassist/environment.h"
 
-using namespace std;
-
 //look if the environment variable 'showargs_output' is defined
 std::string getFileOutputPath()
 {
@@ -54,42 +59,177 @@ std::string getFileOutputPath()
   return tmp;
 }
 
+enum OutputFormat
+{
+  FORMAT_TEXT,      //'arg0: value' lines
+  FORMAT_NUL,       //each argument followed by a NUL character
+  FORMAT_LENPREFIX, //each argument preceded by its 32 bits little-endian length
+};
+
+static const char * gFormatArgumentPrefix = "--showargs-format=";
+
+bool parseOutputFormat(const std::string & iValue, OutputFormat & oFormat)
+{
+  if (iValue == "text")
+    oFormat = FORMAT_TEXT;
+  else if (iValue == "nul")
+    oFormat = FORMAT_NUL;
+  else if (iValue == "lenprefix")
+    oFormat = FORMAT_LENPREFIX;
+  else
+    return false;
+  return true;
+}
+
+//The output format is selected with a '--showargs-format=' first argument (which is not shown)
+//or with the environment variable 'showargs_format'.
+OutputFormat getOutputFormat(int & ioArgc, char* ioArgv[])
+{
+  OutputFormat format = FORMAT_TEXT;
+
+  const size_t prefixLength = strlen(gFormatArgumentPrefix);
+  if (ioArgc >= 2 && strncmp(ioArgv[1], gFormatArgumentPrefix, prefixLength) == 0 && parseOutputFormat(ioArgv[1] + prefixLength, format))
+  {
+    //remove the argument from the list of shown arguments
+    for(int i=1; i+1<ioArgc; i++)
+      ioArgv[i] = ioArgv[i+1];
+    ioArgc--;
+    return format;
+  }
+
+  std::string tmp = ra::environment::getEnvironmentVariable("showargs_format");
+  if (tmp.empty())
+    tmp = ra::environment::getEnvironmentVariable("SHOWARGS_FORMAT");
+  parseOutputFormat(tmp, format);
+  return format;
+}
+
+//build the whole output in memory so that it can be written at once
+std::string getOutput(OutputFormat iFormat, int argc, char* argv[])
+{
+  std::string output;
+  for(int i=0; i<argc; i++)
+  {
+    const char * value = argv[i];
+    const size_t length = strlen(value);
+    switch(iFormat)
+    {
+    case FORMAT_TEXT:
+      {
+        char prefix[32];
+        sprintf(prefix, "arg%d: ", i);
+        output.append(prefix);
+        output.append(value, length);
+        output.push_back('\n');
+      }
+      break;
+    case FORMAT_NUL:
+      output.append(value, length + 1);
+      break;
+    case FORMAT_LENPREFIX:
+      for(int j=0; j<4; j++)
+      {
+        output.push_back( (char)((length >> (8*j)) & 0xFF) );
+      }
+      output.append(value, length);
+      break;
+    };
+  }
+  return output;
+}
+
+//look if the environment variable 'showargs_mode' is set to 'server'
+bool isServerMode()
+{
+  std::string tmp = ra::environment::getEnvironmentVariable("showargs_mode");
+  if (tmp.empty())
+    tmp = ra::environment::getEnvironmentVariable("SHOWARGS_MODE");
+  return (tmp == "server");
+}
+
+#ifndef _WIN32
+//Server mode.
+//The process is replaced by a long-lived shell which reads one request per line on stdin.
+//A request is a sequence number followed by a space and a command line.
+//Each command line is evaluated in a subshell as the arguments of a 'showargs' shell function
+//which gives the same arguments as a spawned showargs process without spawning a process.
+//The function exits the subshell like 'exec showargs' would replace the shell.
+//The variables and positional parameters of the server are cleared before the command line is evaluated
+//and the sequence number is part of the function definition so the command line sees the same state as 'sh -c'.
+//The subshell waits for its background jobs and isolates the state (variables, options, directory)
+//changed by the command line from the following requests.
+//Responses are written as records which start and end with a NUL character:
+//  'A' followed by the sequence number, a space and the number of arguments, then each argument, for each call to showargs.
+//  'S' followed by the sequence number, a space and the exit status of the command line, once the command line is completed.
+//The 'A' records are written to the standard output of the function so the redirections of the command line apply to them.
+//Any other output of the command lines ends up between two records.
+static const char * gServerScript =
+  "exec 3>&1 1>/dev/null\n"
+  "showargs_record() {\n"
+  "  printf '\\0A%s %d\\0' \"$1\" $(($# - 1))\n"
+  "  shift\n"
+  "  if [ $# -gt 0 ]; then printf '%s\\0' \"$@\"; fi\n"
+  "  exit 0\n"
+  "}\n"
+  "while IFS= read -r showargs_line; do\n"
+  "  showargs_seq=${showargs_line%% *}\n"
+  "  (\n"
+  "    eval \"showargs() { showargs_record $showargs_seq \\\"\\$@\\\"; }\"\n"
+  "    set -- \"${showargs_line#* }\"\n"
+  "    unset showargs_line showargs_seq\n"
+  "    trap wait EXIT\n"
+  "    command eval \"set --; showargs $1\" >&3\n"
+  "  )\n"
+  "  printf '\\0S%s %d\\0' \"$showargs_seq\" $? >&3\n"
+  "done\n";
+
+int runServer()
+{
+  execl("/bin/sh", "/bin/sh", "-c", gServerScript, (char*)NULL);
+  return 1; //exec failed
+}
+#endif
+
 int main(int argc, char* argv[])
 {
+#ifndef _WIN32
+  if (isServerMode())
+    return runServer();
+#endif
+
+  OutputFormat format = getOutputFormat(argc, argv);
+  const bool binary = (format != FORMAT_TEXT);
+  const std::string output = getOutput(format, argc, argv);
+
   //look for a file output path
   std::string output_file_path = getFileOutputPath();
   bool file_output_enabled = !output_file_path.empty();
-  if (file_output_enabled)
-  {
-    //output to a file
-    FILE * f = fopen(output_file_path.c_str(), "w");
-    if (f == NULL)
-      return 1;
 
-    for(int i=0; i<argc; i++)
-    {
-      const char * value = argv[i];
-      fprintf(f, "arg%d: %s\n", i, value);
-    }
+  FILE * f = stdout;
+  if (file_output_enabled)
+    f = fopen(output_file_path.c_str(), (binary ? "wb" : "w"));
+#ifdef _WIN32
+  else if (binary)
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+  if (f == NULL)
+    return 1;
 
-    fclose(f);
-  }
+  //single write of the whole output
+  bool written = (fwrite(output.data(), 1, output.size(), f) == output.size());
+  if (f == stdout)
+    written = (fflush(f) == 0) && written;
   else
-  {
-    //output to stdout
-    for(int i=0; i<argc; i++)
-    {
-      const char * value = argv[i];
-      cout << "arg" << i << ": " << value << endl;
-    }
+    written = (fclose(f) == 0) && written;
+  if (!written)
+    return 1;
 
-    //is this application that spawned a console?
-    //if so, then we ask the user to press a key before it goes away
-    if (ra::console::hasConsoleOwnership())
-    {
-      cout << "Press a key to terminate application..." << endl;
-      getchar();
-    }
+  //is this application that spawned a console?
+  //if so, then we ask the user to press a key before it goes away
+  if (!file_output_enabled && !binary && ra::console::hasConsoleOwnership())
+  {
+    printf("Press a key to terminate application...\n");
+    getchar();
   }
 
 	return 0;
@@ -0,0 +1,107 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "ArgumentClassifier.h"
+
+namespace libargvcodec
+{
+
+enum CharacterFlags
+{
+  FLAG_SPACE                    = 0x01,
+  FLAG_DOUBLE_QUOTE             = 0x02,
+  FLAG_SINGLE_QUOTE             = 0x04,
+  FLAG_BACKSLASH                = 0x08,
+  FLAG_CMD_PROMPT_SHELL         = 0x10,
+  FLAG_TERMINAL_SHELL           = 0x20,
+};
+
+class CharacterFlagsTable
+{
+public:
+  CharacterFlagsTable()
+  {
+    for(size_t i=0; i<256; i++)
+      flags[i] = 0;
+
+    flags[(unsigned char)' ' ] = FLAG_SPACE;
+    flags[(unsigned char)'\t'] = FLAG_SPACE;
+    flags[(unsigned char)'\"'] = FLAG_DOUBLE_QUOTE;
+    flags[(unsigned char)'\''] = FLAG_SINGLE_QUOTE;
+    flags[(unsigned char)'\\'] = FLAG_BACKSLASH;
+    flags[(unsigned char)'^' ] = FLAG_CMD_PROMPT_SHELL;
+    flags[(unsigned char)'%' ] = FLAG_CMD_PROMPT_SHELL;
+    flags[(unsigned char)'&' ] = FLAG_CMD_PROMPT_SHELL | FLAG_TERMINAL_SHELL;
+    flags[(unsigned char)'|' ] = FLAG_CMD_PROMPT_SHELL | FLAG_TERMINAL_SHELL;
+    flags[(unsigned char)'(' ] = FLAG_CMD_PROMPT_SHELL | FLAG_TERMINAL_SHELL;
+    flags[(unsigned char)')' ] = FLAG_CMD_PROMPT_SHELL | FLAG_TERMINAL_SHELL;
+    flags[(unsigned char)'<' ] = FLAG_CMD_PROMPT_SHELL | FLAG_TERMINAL_SHELL;
+    flags[(unsigned char)'>' ] = FLAG_CMD_PROMPT_SHELL | FLAG_TERMINAL_SHELL;
+    flags[(unsigned char)'*' ] = FLAG_TERMINAL_SHELL;
+  }
+
+  unsigned char flags[256];
+};
+
+static const CharacterFlagsTable gCharacterFlags;
+
+void classifyArgument(const char * iValue, ArgumentClass & oClass)
+{
+  oClass.length = 0;
+  oClass.hasSpaces = false;
+  oClass.hasDoubleQuotes = false;
+  oClass.hasBackslashes = false;
+  oClass.hasCmdPromptShellCharacters = false;
+  oClass.numDoubleQuotes = 0;
+  oClass.numSingleQuotes = 0;
+  oClass.numTerminalShellCharacters = 0;
+
+  if (iValue == NULL)
+    return;
+
+  unsigned char allFlags = 0;
+  const char * c = iValue;
+  for(; *c != '\0'; c++)
+  {
+    unsigned char flags = gCharacterFlags.flags[(unsigned char)*c];
+    if (flags == 0)
+      continue;
+
+    allFlags |= flags;
+    if (flags & FLAG_DOUBLE_QUOTE)
+      oClass.numDoubleQuotes++;
+    else if (flags & FLAG_SINGLE_QUOTE)
+      oClass.numSingleQuotes++;
+    else if (flags & FLAG_TERMINAL_SHELL)
+      oClass.numTerminalShellCharacters++;
+  }
+
+  oClass.length = (size_t)(c - iValue);
+  oClass.hasSpaces                    = (allFlags & FLAG_SPACE) != 0;
+  oClass.hasDoubleQuotes              = (allFlags & FLAG_DOUBLE_QUOTE) != 0;
+  oClass.hasBackslashes               = (allFlags & FLAG_BACKSLASH) != 0;
+  oClass.hasCmdPromptShellCharacters  = (allFlags & FLAG_CMD_PROMPT_SHELL) != 0;
+}
+
+}; //namespace libargvcodec
@@ -0,0 +1,56 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef ARGUMENTCLASSIFIER_H
+#define ARGUMENTCLASSIFIER_H
+
+#include <cstddef> //for size_t
+
+namespace libargvcodec
+{
+
+  /// <summary>
+  /// Summary of the characters of an argument which drives the encoding rules of all dialects.
+  /// An argument is classified once and the classification can be shared by the encoders of multiple dialects.
+  /// </summary>
+  struct ArgumentClass
+  {
+    size_t length;
+    bool hasSpaces;                         //[space] or tab characters
+    bool hasDoubleQuotes;
+    bool hasBackslashes;
+    bool hasCmdPromptShellCharacters;       //^ & | ( ) < > %
+    size_t numDoubleQuotes;
+    size_t numSingleQuotes;
+    size_t numTerminalShellCharacters;      //& | ( ) < > *, excluding the special shell characters $ and `
+  };
+
+  /// <summary>Classifies the characters of an argument in a single pass.</summary>
+  /// <param name="iValue">The argument to classify. A NULL value is classified as an empty argument.</param>
+  /// <param name="oClass">The classification of the argument.</param>
+  void classifyArgument(const char * iValue, ArgumentClass & oClass);
+
+}; //namespace libargvcodec
+
+#endif //ARGUMENTCLASSIFIER_H
@@ -23,6 +23,8 @@
  *********************************************************************************/
 
 #include "libargvcodec/ArgumentList.h"
+#include "StatsScope.h"
+#include "TraceScope.h"
 #include "rapidassist/strings.h"
 #include <assert.h>
 #include <vector>
@@ -33,13 +35,27 @@ static const bool gDefaultCaseSensitive = true;
 namespace libargvcodec
 {
 
+#ifdef LIBARGVCODEC_TRACING
+static size_t getNumBytes(const ArgumentList::StringList & iArguments)
+{
+  size_t numBytes = 0;
+  for(size_t i=0; i<iArguments.size(); i++)
+  {
+    numBytes += iArguments[i].size();
+  }
+  return numBytes;
+}
+#endif
+
 ArgumentList::ArgumentList() :
-  mArgv(NULL)
+  mArgv(NULL),
+  mArgvCapacity(0)
 {
 }
 
 ArgumentList::ArgumentList(const ArgumentList & iArgumentManager) :
-  mArgv(NULL)
+  mArgv(NULL),
+  mArgvCapacity(0)
 {
   (*this) = iArgumentManager;
 }
@@ -50,10 +66,12 @@ ArgumentList::~ArgumentList()
   if (mArgv)
     delete[] mArgv;
   mArgv = NULL;
+  mArgvCapacity = 0;
 }
 
 void ArgumentList::init(int argc, char** argv)
 {
+  LIBARGVCODEC_STATS_SCOPE();
   StringList tmp;
   for(int i=0; i<argc; i++)
   {
@@ -64,8 +82,12 @@ void ArgumentList::init(int argc, char** argv)
 
 void ArgumentList::init(const StringList & iArguments)
 {
+  LIBARGVCODEC_STATS_SCOPE();
+  LIBARGVCODEC_TRACE_PHASE(initTimer, PHASE_ARGUMENT_LIST_INIT);
+  LIBARGVCODEC_TRACE_BEGIN(initTimer);
   mArguments = iArguments;
   rebuildArgv();
+  LIBARGVCODEC_TRACE_END(initTimer, mArguments.size(), getNumBytes(mArguments));
 }
 
 const char * ArgumentList::getArgument(int iIndex) const
@@ -77,6 +99,7 @@ const char * ArgumentList::getArgument(int iIndex) const
 
 bool ArgumentList::insert(int iIndex, const char * iValue)
 {
+  LIBARGVCODEC_STATS_SCOPE();
   if (iValue == NULL)
     return false;
   if (iIndex == getArgc())
@@ -91,6 +114,7 @@ bool ArgumentList::insert(int iIndex, const char * iValue)
 
 bool ArgumentList::insert(const char * iValue)
 {
+  LIBARGVCODEC_STATS_SCOPE();
   if (iValue == NULL)
     return false;
   mArguments.push_back(iValue);
@@ -100,6 +124,7 @@ bool ArgumentList::insert(const char * iValue)
 
 bool ArgumentList::remove(int iIndex)
 {
+  LIBARGVCODEC_STATS_SCOPE();
   if (!isValid(iIndex))
     return false; //out of bounds
   mArguments.erase(mArguments.begin() + iIndex);
@@ -109,6 +134,7 @@ bool ArgumentList::remove(int iIndex)
 
 bool ArgumentList::replace(int iIndex, const char * iValue)
 {
+  LIBARGVCODEC_STATS_SCOPE();
   if (iValue == NULL)
     return false;
   if (!isValid(iIndex))
@@ -133,6 +159,7 @@ char** ArgumentList::getArgv() const
 
 const ArgumentList & ArgumentList::operator = (const ArgumentList & iArgumentManager)
 {
+  LIBARGVCODEC_STATS_SCOPE();
   this->init(iArgumentManager.mArguments);
   return (*this);
 }
@@ -151,28 +178,40 @@ bool ArgumentList::operator != (const ArgumentList & iArgumentManager) const
 
 void ArgumentList::rebuildArgv()
 {
-  //safe delete the array
-  if (mArgv)
-    delete[] mArgv;
-  mArgv = NULL;
+  LIBARGVCODEC_STATS_ARGV_REBUILD();
 
   //argv size is 1 element bigger than argc (the number of arguments)
   //the last element of argv must be an empty string (NULL character)
   //the last element is *not* an argument
-  int argvSize = mArguments.size() + 1;
+  size_t argvSize = mArguments.size() + 1;
 
-  typedef char * cStr;
-  mArgv = new cStr[argvSize];
-  if (mArgv)
+  //the array is only reallocated when it is too small so that
+  //extracting, removing or inserting arguments in a loop does not reallocate it each time
+  if (mArgv == NULL || mArgvCapacity < argvSize)
   {
-    //fill
-    for(size_t i=0; i<mArguments.size(); i++)
-    {
-      mArgv[i] = (char*)mArguments[i].c_str();
-    }
-    //last vector element must be NULL
-    mArgv[mArguments.size()] = NULL;
+    //grow geometrically for arguments inserted in a loop
+    size_t capacity = mArgvCapacity * 2;
+    if (capacity < argvSize)
+      capacity = argvSize;
+
+    //safe delete the array
+    if (mArgv)
+      delete[] mArgv;
+    mArgv = NULL;
+    mArgvCapacity = 0;
+
+    typedef char * cStr;
+    mArgv = new cStr[capacity];
+    mArgvCapacity = capacity;
+  }
+
+  //fill. The strings may have moved within the list, all pointers are updated.
+  for(size_t i=0; i<mArguments.size(); i++)
+  {
+    mArgv[i] = (char*)mArguments[i].c_str();
   }
+  //last vector element must be NULL
+  mArgv[mArguments.size()] = NULL;
 }
 
 bool ArgumentList::isValid(int iIndex) const
@@ -186,6 +225,7 @@ bool ArgumentList::isValid(int iIndex) const
 
 int ArgumentList::findIndex(const char * iValue, bool iCaseSensitive) const
 {
+  LIBARGVCODEC_STATS_SCOPE();
   if (iValue == NULL)
     return -1;
   std::string uppercaseValue = ra::strings::uppercase(iValue);
@@ -201,11 +241,13 @@ int ArgumentList::findIndex(const char * iValue, bool iCaseSensitive) const
 
 int ArgumentList::findIndex(const char * iValue) const
 {
+  LIBARGVCODEC_STATS_SCOPE();
   return findIndex(iValue, gDefaultCaseSensitive);
 }
 
 bool ArgumentList::contains(const char * iValue, bool iCaseSensitive) const
 {
+  LIBARGVCODEC_STATS_SCOPE();
   if (iValue == NULL)
     return false;
   int pos = findIndex(iValue, iCaseSensitive);
@@ -214,6 +256,7 @@ bool ArgumentList::contains(const char * iValue, bool iCaseSensitive) const
 
 bool ArgumentList::contains(const char * iValue) const
 {
+  LIBARGVCODEC_STATS_SCOPE();
   return contains(iValue, gDefaultCaseSensitive);
 }
 
@@ -228,11 +271,13 @@ bool ArgumentList::findOption2(const char * iValue, bool iCaseSensitive, int & o
 
 bool ArgumentList::findOption(const char * iValue, int & oIndex) const
 {
+  LIBARGVCODEC_STATS_SCOPE();
   return findOption(iValue, gDefaultCaseSensitive, oIndex);
 }
 
 bool ArgumentList::findOption(const char * iValue) const
 {
+  LIBARGVCODEC_STATS_SCOPE();
   int tmp = 0;
   return findOption(iValue, gDefaultCaseSensitive, tmp);
 }
@@ -262,6 +307,7 @@ bool ArgumentList::findValue2(const char * iValueName, bool iCaseSensitive, int
 
 bool ArgumentList::findValue(const char * iValueName, bool iCaseSensitive, int & oIndex, int & oValue) const
 {
+  LIBARGVCODEC_STATS_SCOPE();
   oIndex = -1;
   oValue = 0;
 
@@ -280,11 +326,13 @@ bool ArgumentList::findValue(const char * iValueName, bool iCaseSensitive, int &
 
 bool ArgumentList::findValue(const char * iValueName, int & oIndex, std::string & oValue) const
 {
+  LIBARGVCODEC_STATS_SCOPE();
   return findValue(iValueName, gDefaultCaseSensitive, oIndex, oValue);
 }
 
 bool ArgumentList::findValue(const char * iValueName, int & oIndex, int & oValue) const
 {
+  LIBARGVCODEC_STATS_SCOPE();
   return findValue(iValueName, gDefaultCaseSensitive, oIndex, oValue);
 }
 
@@ -317,6 +365,7 @@ bool ArgumentList::findNextValue2(const char * iValueName, bool iCaseSensitive,
 
 bool ArgumentList::findNextValue(const char * iValueName, bool iCaseSensitive, int & oIndex, int & oValue) const
 {
+  LIBARGVCODEC_STATS_SCOPE();
   oIndex = -1;
   oValue = 0;
 
@@ -335,16 +384,19 @@ bool ArgumentList::findNextValue(const char * iValueName, bool iCaseSensitive, i
 
 bool ArgumentList::findNextValue(const char * iValueName, int & oIndex, std::string & oValue) const
 {
+  LIBARGVCODEC_STATS_SCOPE();
   return findNextValue(iValueName, gDefaultCaseSensitive, oIndex, oValue);
 }
 
 bool ArgumentList::findNextValue(const char * iValueName, int & oIndex, int & oValue) const
 {
+  LIBARGVCODEC_STATS_SCOPE();
   return findNextValue(iValueName, gDefaultCaseSensitive, oIndex, oValue);
 }
 
 bool ArgumentList::extractOption(const char * iValue, bool iCaseSensitive)
 {
+  LIBARGVCODEC_STATS_SCOPE();
   if (iValue == NULL)
     return false;
   int index = 0;
@@ -358,11 +410,13 @@ bool ArgumentList::extractOption(const char * iValue, bool iCaseSensitive)
 
 bool ArgumentList::extractOption(const char * iValue)
 {
+  LIBARGVCODEC_STATS_SCOPE();
   return extractOption(iValue, gDefaultCaseSensitive);
 }
 
 bool ArgumentList::extractValue(const char * iValueName, bool iCaseSensitive, std::string & oValue)
 {
+  LIBARGVCODEC_STATS_SCOPE();
   oValue = "";
   if (iValueName == NULL)
     return false;
@@ -377,6 +431,7 @@ bool ArgumentList::extractValue(const char * iValueName, bool iCaseSensitive, st
 
 bool ArgumentList::extractValue(const char * iValueName, bool iCaseSensitive, int & oValue)
 {
+  LIBARGVCODEC_STATS_SCOPE();
   oValue = 0;
 
   std::string sValue;
@@ -392,6 +447,7 @@ bool ArgumentList::extractValue(const char * iValueName, bool iCaseSensitive, in
 
 std::string ArgumentList::extractValue(const char * iValueName, bool iCaseSensitive)
 {
+  LIBARGVCODEC_STATS_SCOPE();
   if (iValueName == NULL)
     return "";
   std::string value;
@@ -405,21 +461,25 @@ std::string ArgumentList::extractValue(const char * iValueName, bool iCaseSensit
 
 bool ArgumentList::extractValue(const char * iValueName, std::string & oValue)
 {
+  LIBARGVCODEC_STATS_SCOPE();
   return extractValue(iValueName, gDefaultCaseSensitive, oValue);
 }
 
 bool ArgumentList::extractValue(const char * iValueName, int & oValue)
 {
+  LIBARGVCODEC_STATS_SCOPE();
   return extractValue(iValueName, gDefaultCaseSensitive, oValue);
 }
 
 std::string ArgumentList::extractValue(const char * iValueName)
 {
+  LIBARGVCODEC_STATS_SCOPE();
   return extractValue(iValueName, gDefaultCaseSensitive);
 }
 
 bool ArgumentList::extractNextValue(const char * iValueName, bool iCaseSensitive, std::string & oValue)
 {
+  LIBARGVCODEC_STATS_SCOPE();
   oValue = "";
   if (iValueName == NULL)
     return false;
@@ -437,6 +497,7 @@ bool ArgumentList::extractNextValue(const char * iValueName, bool iCaseSensitive
 
 bool ArgumentList::extractNextValue(const char * iValueName, bool iCaseSensitive, int & oValue)
 {
+  LIBARGVCODEC_STATS_SCOPE();
   oValue = 0;
 
   std::string sValue;
@@ -452,6 +513,7 @@ bool ArgumentList::extractNextValue(const char * iValueName, bool iCaseSensitive
 
 std::string ArgumentList::extractNextValue(const char * iValueName, bool iCaseSensitive)
 {
+  LIBARGVCODEC_STATS_SCOPE();
   if (iValueName == NULL)
     return "";
   std::string value;
@@ -465,16 +527,19 @@ std::string ArgumentList::extractNextValue(const char * iValueName, bool iCaseSe
 
 bool ArgumentList::extractNextValue(const char * iValueName, std::string & oValue)
 {
+  LIBARGVCODEC_STATS_SCOPE();
   return extractNextValue(iValueName, gDefaultCaseSensitive, oValue);
 }
 
 bool ArgumentList::extractNextValue(const char * iValueName, int & oValue)
 {
+  LIBARGVCODEC_STATS_SCOPE();
   return extractNextValue(iValueName, gDefaultCaseSensitive, oValue);
 }
 
 std::string ArgumentList::extractNextValue(const char * iValueName)
 {
+  LIBARGVCODEC_STATS_SCOPE();
   return extractNextValue(iValueName, gDefaultCaseSensitive);
 }
 
@@ -500,13 +565,14 @@ void ArgumentList::equalize(std::string & iValue)
   }
 }
 
-const ArgumentList::StringList & ArgumentList::getOptionPrefixes()
+const ArgumentList::StringList & ArgumentList::getOptionPrefixes() const
 {
   return mPrefixes;
 }
 
 bool ArgumentList::addOptionPrefix(const char * iValue)
 {
+  LIBARGVCODEC_STATS_SCOPE();
   if (iValue != NULL)
   {
     mPrefixes.push_back(std::string(iValue));
@@ -517,6 +583,7 @@ bool ArgumentList::addOptionPrefix(const char * iValue)
 
 bool ArgumentList::removeOptionPrefix(const char * iValue)
 {
+  LIBARGVCODEC_STATS_SCOPE();
   StringList::iterator pos = std::find(mPrefixes.begin(), mPrefixes.end(), std::string(iValue));
   if (pos != mPrefixes.end())
   {
@@ -528,6 +595,7 @@ bool ArgumentList::removeOptionPrefix(const char * iValue)
 
 void ArgumentList::clearOptionPrefixes()
 {
+  LIBARGVCODEC_STATS_SCOPE();
   mPrefixes.clear();
 }
 
@@ -566,6 +634,7 @@ std::string ArgumentList::rebuildArgumentPrefix(const char * iValueName, const s
 
 bool ArgumentList::findOption(const char * iValue, bool iCaseSensitive, int & oIndex) const
 {
+  LIBARGVCODEC_STATS_SCOPE();
   bool found = findOption2(iValue, iCaseSensitive, oIndex);
   if (found)
     return true;
@@ -591,6 +660,7 @@ bool ArgumentList::findOption(const char * iValue, bool iCaseSensitive, int & oI
 
 bool ArgumentList::findValue(const char * iValueName, bool iCaseSensitive, int & oIndex, std::string & oValue) const
 {
+  LIBARGVCODEC_STATS_SCOPE();
   bool found = findValue2(iValueName, iCaseSensitive, oIndex, oValue);
   if (found)
     return true;
@@ -616,6 +686,7 @@ bool ArgumentList::findValue(const char * iValueName, bool iCaseSensitive, int &
 
 bool ArgumentList::findNextValue(const char * iValueName, bool iCaseSensitive, int & oIndex, std::string & oValue) const
 {
+  LIBARGVCODEC_STATS_SCOPE();
   //une fois que c'est confirmer que ca fonctionne bien, deleter ArgumentList.cpp.old
 
   bool found = findNextValue2(iValueName, iCaseSensitive, oIndex, oValue);
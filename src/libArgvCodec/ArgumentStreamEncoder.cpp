@@ -0,0 +1,76 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "libargvcodec/ArgumentStreamEncoder.h"
+
+namespace libargvcodec
+{
+
+ArgumentStreamEncoder::ArgumentStreamEncoder(const IArgumentEncoder & iEncoder, IOutputSink & iSink, IMemoryResource * iResource) :
+  mEncoder(iEncoder),
+  mSink(iSink),
+  mScratch(ResourceString::allocator_type(iResource)),
+  mIsFirstArgument(true)
+{
+}
+
+ArgumentStreamEncoder::~ArgumentStreamEncoder()
+{
+}
+
+bool ArgumentStreamEncoder::encodeArgument(const char * iValue)
+{
+  //the scratch buffer keeps its capacity between arguments
+  mScratch.clear();
+
+  //add a space between arguments
+  if (!mIsFirstArgument)
+    mScratch.push_back(' ');
+  mIsFirstArgument = false;
+
+  mEncoder.appendEncodedArgument(iValue, mScratch);
+  return mSink.write(mScratch.data(), mScratch.size());
+}
+
+bool ArgumentStreamEncoder::encodeCommandLine(const ArgumentList & iArguments)
+{
+  for(int i=1; i<iArguments.getArgc(); i++) //skip first element since it refers to the actual .exe that was launched
+  {
+    if (!encodeArgument(iArguments.getArgument(i)))
+      return false;
+  }
+  return true;
+}
+
+void ArgumentStreamEncoder::reset()
+{
+  mIsFirstArgument = true;
+}
+
+bool ArgumentStreamEncoder::flush()
+{
+  return mSink.flush();
+}
+
+}; //namespace libargvcodec
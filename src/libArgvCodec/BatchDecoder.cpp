@@ -0,0 +1,159 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "BatchDecoder.h"
+#include "ParallelFor.h"
+
+#include <cstring> //for strlen()
+
+namespace libargvcodec
+{
+
+/// <summary>Number of command lines decoded by a single task.</summary>
+static const size_t BATCH_DECODER_CHUNK_SIZE = 256;
+
+/// <summary>Decodes a chunk of command lines with a new stream decoder.</summary>
+class BatchDecodeTask : public ParallelTask
+{
+public:
+  BatchDecodeTask(const StreamArgumentDecoder & iDecoder, const char * const * iCommandLines, size_t iCount, DecodedCommandLinesVector & oChunks) :
+    mDecoder(iDecoder),
+    mCommandLines(iCommandLines),
+    mCount(iCount),
+    mChunks(oChunks)
+  {
+  }
+
+  virtual void run(size_t iTask, int /*iThread*/)
+  {
+    DecodedCommandLines & chunk = mChunks[iTask];
+    IArgumentStreamDecoder * decoder = mDecoder.createStreamDecoder(chunk);
+
+    const size_t first = iTask * BATCH_DECODER_CHUNK_SIZE;
+    const size_t last = (first + BATCH_DECODER_CHUNK_SIZE < mCount ? first + BATCH_DECODER_CHUNK_SIZE : mCount);
+    for(size_t i=first; i<last; i++)
+    {
+      const char * cmdLine = mCommandLines[i];
+      if (cmdLine != NULL)
+        decoder->feed(cmdLine, strlen(cmdLine));
+      decoder->finish();
+      chunk.endCommandLine();
+    }
+
+    delete decoder;
+  }
+
+private:
+  const StreamArgumentDecoder & mDecoder;
+  const char * const * mCommandLines;
+  size_t mCount;
+  DecodedCommandLinesVector & mChunks;
+};
+
+/// <summary>Copies a part at its final position in the concatenated result.</summary>
+class ConcatenateTask : public ParallelTask
+{
+public:
+  ConcatenateTask(const DecodedCommandLinesVector & iParts, const DecodedCommandLines::OffsetArray & iArenaBases, const DecodedCommandLines::OffsetArray & iArgumentBases, const DecodedCommandLines::OffsetArray & iCommandLineBases,
+                  DecodedCommandLines::ByteArray & oArena, DecodedCommandLines::OffsetArray & oArgumentOffsets, DecodedCommandLines::OffsetArray & oCommandLineOffsets) :
+    mParts(iParts),
+    mArenaBases(iArenaBases),
+    mArgumentBases(iArgumentBases),
+    mCommandLineBases(iCommandLineBases),
+    mArena(oArena),
+    mArgumentOffsets(oArgumentOffsets),
+    mCommandLineOffsets(oCommandLineOffsets)
+  {
+  }
+
+  virtual void run(size_t iTask, int /*iThread*/)
+  {
+    const DecodedCommandLines & part = mParts[iTask];
+    const DecodedCommandLines::ByteArray & arena = part.getArena();
+    const DecodedCommandLines::OffsetArray & argumentOffsets = part.getArgumentOffsets();
+    const DecodedCommandLines::OffsetArray & commandLineOffsets = part.getCommandLineOffsets();
+
+    const size_t arenaBase = mArenaBases[iTask];
+    const size_t argumentBase = mArgumentBases[iTask];
+    const size_t commandLineBase = mCommandLineBases[iTask];
+
+    if (!arena.empty())
+      memcpy(&mArena[arenaBase], &arena[0], arena.size());
+
+    //the last offset of each part is the first offset of the next part
+    for(size_t i=0; i+1<argumentOffsets.size(); i++)
+      mArgumentOffsets[argumentBase + i] = arenaBase + argumentOffsets[i];
+    for(size_t i=0; i+1<commandLineOffsets.size(); i++)
+      mCommandLineOffsets[commandLineBase + i] = argumentBase + commandLineOffsets[i];
+  }
+
+private:
+  const DecodedCommandLinesVector & mParts;
+  const DecodedCommandLines::OffsetArray & mArenaBases;
+  const DecodedCommandLines::OffsetArray & mArgumentBases;
+  const DecodedCommandLines::OffsetArray & mCommandLineBases;
+  DecodedCommandLines::ByteArray & mArena;
+  DecodedCommandLines::OffsetArray & mArgumentOffsets;
+  DecodedCommandLines::OffsetArray & mCommandLineOffsets;
+};
+
+void DecodedCommandLinesBuilder::concatenate(const DecodedCommandLinesVector & iParts, int iNumThreads, DecodedCommandLines & oResult)
+{
+  //compute the position of each part in the result
+  DecodedCommandLines::OffsetArray arenaBases(iParts.size() + 1, 0);
+  DecodedCommandLines::OffsetArray argumentBases(iParts.size() + 1, 0);
+  DecodedCommandLines::OffsetArray commandLineBases(iParts.size() + 1, 0);
+  for(size_t i=0; i<iParts.size(); i++)
+  {
+    arenaBases[i+1] = arenaBases[i] + iParts[i].getArena().size();
+    argumentBases[i+1] = argumentBases[i] + iParts[i].getNumArguments();
+    commandLineBases[i+1] = commandLineBases[i] + iParts[i].getNumCommandLines();
+  }
+
+  oResult.mArena.resize(arenaBases.back());
+  oResult.mArgumentOffsets.resize(argumentBases.back() + 1);
+  oResult.mCommandLineOffsets.resize(commandLineBases.back() + 1);
+  oResult.mArgumentOffsets.back() = arenaBases.back();
+  oResult.mCommandLineOffsets.back() = argumentBases.back();
+
+  ConcatenateTask task(iParts, arenaBases, argumentBases, commandLineBases, oResult.mArena, oResult.mArgumentOffsets, oResult.mCommandLineOffsets);
+  parallelFor(iParts.size(), iNumThreads, task);
+}
+
+bool decodeBatch(const StreamArgumentDecoder & iDecoder, const char * const * iCommandLines, size_t iCount, int iNumThreads, DecodedCommandLines & oResult)
+{
+  oResult.clear();
+  if (iCommandLines == NULL && iCount > 0)
+    return false;
+
+  const size_t numChunks = (iCount + BATCH_DECODER_CHUNK_SIZE - 1) / BATCH_DECODER_CHUNK_SIZE;
+  DecodedCommandLinesVector chunks(numChunks);
+  BatchDecodeTask task(iDecoder, iCommandLines, iCount, chunks);
+  parallelFor(numChunks, iNumThreads, task);
+
+  DecodedCommandLinesBuilder::concatenate(chunks, iNumThreads, oResult);
+  return true;
+}
+
+}; //namespace libargvcodec
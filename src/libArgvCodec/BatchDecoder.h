@@ -0,0 +1,58 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef BATCHDECODER_H
+#define BATCHDECODER_H
+
+#include "libargvcodec/DecodedCommandLines.h"
+#include "libargvcodec/StreamArgumentDecoder.h"
+
+namespace libargvcodec
+{
+
+  typedef std::vector<DecodedCommandLines> DecodedCommandLinesVector;
+
+  /// <summary>Builds a DecodedCommandLines instance from multiple parts.</summary>
+  class DecodedCommandLinesBuilder
+  {
+  public:
+    /// <summary>Concatenates the given parts, in order, into a single instance. The parts are copied in parallel.</summary>
+    /// <param name="iParts">The parts to concatenate.</param>
+    /// <param name="iNumThreads">The requested number of threads. Use 0 for the default number of threads.</param>
+    /// <param name="oResult">The concatenated command lines.</param>
+    static void concatenate(const DecodedCommandLinesVector & iParts, int iNumThreads, DecodedCommandLines & oResult);
+  };
+
+  /// <summary>Decodes multiple command lines in parallel with the stream decoders of the given decoder.</summary>
+  /// <param name="iDecoder">The decoder which creates a stream decoder for each chunk of command lines.</param>
+  /// <param name="iCommandLines">The command lines to decode. NULL elements are decoded as empty command lines.</param>
+  /// <param name="iCount">The number of command lines.</param>
+  /// <param name="iNumThreads">The requested number of threads. Use 0 for the default number of threads.</param>
+  /// <param name="oResult">The arguments of all decoded command lines.</param>
+  /// <returns>Returns true if the command lines are decoded. Returns false if iCommandLines is NULL.</returns>
+  bool decodeBatch(const StreamArgumentDecoder & iDecoder, const char * const * iCommandLines, size_t iCount, int iNumThreads, DecodedCommandLines & oResult);
+
+}; //namespace libargvcodec
+
+#endif //BATCHDECODER_H
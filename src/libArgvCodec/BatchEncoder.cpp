@@ -0,0 +1,231 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "libargvcodec/BatchEncoder.h"
+#include "WindowsArgumentCodecCore.h"
+#include "TerminalArgumentCodecCore.h"
+#include "ArgumentClassifier.h"
+#include "ParallelFor.h"
+
+#include <cstring> //for memcpy()
+#include <vector>
+
+namespace libargvcodec
+{
+
+/// <summary>Number of argument lists encoded by a single task.</summary>
+static const size_t BATCH_ENCODER_CHUNK_SIZE = 64;
+
+typedef std::vector<std::string> StringVector;
+
+static size_t getNumChunks(size_t iCount)
+{
+  return (iCount + BATCH_ENCODER_CHUNK_SIZE - 1) / BATCH_ENCODER_CHUNK_SIZE;
+}
+
+static size_t getChunkEnd(size_t iChunk, size_t iCount)
+{
+  const size_t last = (iChunk + 1) * BATCH_ENCODER_CHUNK_SIZE;
+  return (last < iCount ? last : iCount);
+}
+
+/// <summary>Appends the encoded arguments of a list to the command line of each dialect.</summary>
+static void appendAllDialects(const ArgumentList & iArguments, BatchEncoder::DialectCommandLines & ioCommandLines)
+{
+  for(int i=1; i<iArguments.getArgc(); i++) //skip first element since it refers to the actual .exe that was launched
+  {
+    //add a space between arguments
+    if (i > 1)
+    {
+      ioCommandLines.cmdPrompt.append(1, ' ');
+      ioCommandLines.createProcess.append(1, ' ');
+      ioCommandLines.terminal.append(1, ' ');
+    }
+
+    const char * argValue = iArguments.getArgument(i);
+    ArgumentClass argumentClass;
+    classifyArgument(argValue, argumentClass);
+
+    CmdPromptCodecCore::appendEncodedArgument(argValue, argumentClass, ioCommandLines.cmdPrompt);
+    CreateProcessCodecCore::appendEncodedArgument(argValue, argumentClass, ioCommandLines.createProcess);
+    TerminalArgumentCodecCore::appendEncodedArgument(argValue, argumentClass, ioCommandLines.terminal);
+  }
+}
+
+/// <summary>Encodes a chunk of argument lists into the buffer of the chunk.</summary>
+class EncodeBatchTask : public ParallelTask
+{
+public:
+  EncodeBatchTask(const IArgumentEncoder & iEncoder, const ArgumentList * iArgumentLists, size_t iCount, char iSeparator, StringVector & oBuffers) :
+    mEncoder(iEncoder),
+    mArgumentLists(iArgumentLists),
+    mCount(iCount),
+    mSeparator(iSeparator),
+    mBuffers(oBuffers)
+  {
+  }
+
+  virtual void run(size_t iTask, int /*iThread*/)
+  {
+    std::string & buffer = mBuffers[iTask];
+    const size_t last = getChunkEnd(iTask, mCount);
+    for(size_t i=iTask * BATCH_ENCODER_CHUNK_SIZE; i<last; i++)
+    {
+      buffer.append(mEncoder.encodeCommandLine(mArgumentLists[i]));
+      buffer.append(1, mSeparator);
+    }
+  }
+
+private:
+  const IArgumentEncoder & mEncoder;
+  const ArgumentList * mArgumentLists;
+  size_t mCount;
+  char mSeparator;
+  StringVector & mBuffers;
+};
+
+/// <summary>Encodes a chunk of argument lists into the buffers of each dialect of the chunk.</summary>
+class EncodeAllDialectsTask : public ParallelTask
+{
+public:
+  EncodeAllDialectsTask(const ArgumentList * iArgumentLists, size_t iCount, char iSeparator, std::vector<BatchEncoder::DialectCommandLines> & oBuffers) :
+    mArgumentLists(iArgumentLists),
+    mCount(iCount),
+    mSeparator(iSeparator),
+    mBuffers(oBuffers)
+  {
+  }
+
+  virtual void run(size_t iTask, int /*iThread*/)
+  {
+    BatchEncoder::DialectCommandLines & buffers = mBuffers[iTask];
+    const size_t last = getChunkEnd(iTask, mCount);
+    for(size_t i=iTask * BATCH_ENCODER_CHUNK_SIZE; i<last; i++)
+    {
+      appendAllDialects(mArgumentLists[i], buffers);
+      buffers.cmdPrompt.append(1, mSeparator);
+      buffers.createProcess.append(1, mSeparator);
+      buffers.terminal.append(1, mSeparator);
+    }
+  }
+
+private:
+  const ArgumentList * mArgumentLists;
+  size_t mCount;
+  char mSeparator;
+  std::vector<BatchEncoder::DialectCommandLines> & mBuffers;
+};
+
+/// <summary>Copies a buffer at its final position in the concatenated output.</summary>
+class ConcatenateBuffersTask : public ParallelTask
+{
+public:
+  ConcatenateBuffersTask(const std::vector<const std::string *> & iBuffers, const std::vector<size_t> & iOffsets, std::string & oOutput) :
+    mBuffers(iBuffers),
+    mOffsets(iOffsets),
+    mOutput(oOutput)
+  {
+  }
+
+  virtual void run(size_t iTask, int /*iThread*/)
+  {
+    const std::string & buffer = *mBuffers[iTask];
+    if (!buffer.empty())
+      memcpy(&mOutput[mOffsets[iTask]], buffer.data(), buffer.size());
+  }
+
+private:
+  const std::vector<const std::string *> & mBuffers;
+  const std::vector<size_t> & mOffsets;
+  std::string & mOutput;
+};
+
+static void concatenate(const std::vector<const std::string *> & iBuffers, int iNumThreads, std::string & oOutput)
+{
+  std::vector<size_t> offsets(iBuffers.size() + 1, 0);
+  for(size_t i=0; i<iBuffers.size(); i++)
+  {
+    offsets[i+1] = offsets[i] + iBuffers[i]->size();
+  }
+
+  oOutput.resize(offsets.back());
+  ConcatenateBuffersTask task(iBuffers, offsets, oOutput);
+  parallelFor(iBuffers.size(), iNumThreads, task);
+}
+
+bool BatchEncoder::encodeBatch(const IArgumentEncoder & iEncoder, const ArgumentList * iArgumentLists, size_t iCount, char iSeparator, std::string & oOutput, int iNumThreads)
+{
+  oOutput.clear();
+  if (iArgumentLists == NULL && iCount > 0)
+    return false;
+
+  StringVector buffers(getNumChunks(iCount));
+  EncodeBatchTask task(iEncoder, iArgumentLists, iCount, iSeparator, buffers);
+  parallelFor(buffers.size(), iNumThreads, task);
+
+  std::vector<const std::string *> parts;
+  for(size_t i=0; i<buffers.size(); i++)
+    parts.push_back(&buffers[i]);
+  concatenate(parts, iNumThreads, oOutput);
+
+  return true;
+}
+
+void BatchEncoder::encodeAllDialects(const ArgumentList & iArguments, DialectCommandLines & oCommandLines)
+{
+  oCommandLines.cmdPrompt.clear();
+  oCommandLines.createProcess.clear();
+  oCommandLines.terminal.clear();
+  appendAllDialects(iArguments, oCommandLines);
+}
+
+bool BatchEncoder::encodeBatchAllDialects(const ArgumentList * iArgumentLists, size_t iCount, char iSeparator, DialectCommandLines & oOutput, int iNumThreads)
+{
+  oOutput.cmdPrompt.clear();
+  oOutput.createProcess.clear();
+  oOutput.terminal.clear();
+  if (iArgumentLists == NULL && iCount > 0)
+    return false;
+
+  std::vector<DialectCommandLines> buffers(getNumChunks(iCount));
+  EncodeAllDialectsTask task(iArgumentLists, iCount, iSeparator, buffers);
+  parallelFor(buffers.size(), iNumThreads, task);
+
+  std::vector<const std::string *> cmdPromptParts;
+  std::vector<const std::string *> createProcessParts;
+  std::vector<const std::string *> terminalParts;
+  for(size_t i=0; i<buffers.size(); i++)
+  {
+    cmdPromptParts.push_back(&buffers[i].cmdPrompt);
+    createProcessParts.push_back(&buffers[i].createProcess);
+    terminalParts.push_back(&buffers[i].terminal);
+  }
+  concatenate(cmdPromptParts, iNumThreads, oOutput.cmdPrompt);
+  concatenate(createProcessParts, iNumThreads, oOutput.createProcess);
+  concatenate(terminalParts, iNumThreads, oOutput.terminal);
+
+  return true;
+}
+
+}; //namespace libargvcodec
@@ -0,0 +1,77 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "libargvcodec/BufferedOutputSink.h"
+
+#include <cstring> //for memcpy()
+
+namespace libargvcodec
+{
+
+BufferedOutputSink::BufferedOutputSink(size_t iBufferSize) :
+  mBuffer(NULL),
+  mBufferSize(iBufferSize > 0 ? iBufferSize : 1),
+  mLength(0)
+{
+  mBuffer = new char[mBufferSize];
+}
+
+BufferedOutputSink::~BufferedOutputSink()
+{
+  //derived classes must flush the buffer since writeBuffer() can not be called from this destructor
+  delete[] mBuffer;
+}
+
+bool BufferedOutputSink::write(const char * iBuffer, size_t iLength)
+{
+  if (iBuffer == NULL && iLength > 0)
+    return false;
+
+  //make room for the new bytes
+  if (mLength + iLength > mBufferSize)
+  {
+    if (!flush())
+      return false;
+  }
+
+  //bypass the buffer for large writes
+  if (iLength >= mBufferSize)
+    return writeBuffer(iBuffer, iLength);
+
+  memcpy(mBuffer + mLength, iBuffer, iLength);
+  mLength += iLength;
+  return true;
+}
+
+bool BufferedOutputSink::flush()
+{
+  if (mLength == 0)
+    return true;
+
+  bool success = writeBuffer(mBuffer, mLength);
+  mLength = 0;
+  return success;
+}
+
+}; //namespace libargvcodec
@@ -0,0 +1,71 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "libargvcodec/CachingArgumentEncoder.h"
+
+namespace libargvcodec
+{
+
+CachingArgumentEncoder::CachingArgumentEncoder(const IArgumentEncoder & iEncoder, EncodedArgumentCache & iCache) :
+  mEncoder(iEncoder),
+  mCache(iCache)
+{
+}
+
+CachingArgumentEncoder::~CachingArgumentEncoder()
+{
+}
+
+std::string CachingArgumentEncoder::encodeArgument(const char * iValue) const
+{
+  if (iValue == NULL)
+    return mEncoder.encodeArgument(iValue);
+
+  std::string encoded;
+  if (mCache.lookup(mEncoder, iValue, encoded))
+    return encoded;
+
+  encoded = mEncoder.encodeArgument(iValue);
+  mCache.insert(mEncoder, iValue, encoded);
+  return encoded;
+}
+
+std::string CachingArgumentEncoder::encodeCommandLine(const ArgumentList & iArguments) const
+{
+  std::string cmdLine;
+
+  for(int i=1; i<iArguments.getArgc(); i++) //skip first element since it refers to the actual .exe that was launched
+  {
+    cmdLine.append(encodeArgument(iArguments.getArgument(i)));
+
+    //add a space between arguments (except the last one)
+    bool isLastArgument = !(i+1<iArguments.getArgc());
+    if (!isLastArgument)
+      cmdLine.append(" ");
+  }
+
+  return cmdLine;
+}
+
+}; //namespace libargvcodec
@@ -0,0 +1,297 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "ClockCache.h"
+
+#include <cstring> //for memcmp()
+
+namespace libargvcodec
+{
+
+static const size_t NUM_SHARDS = 16; //must be a power of 2
+
+template <typename Value>
+ClockCache<Value>::ClockCache(size_t iMaxEntries, size_t iMaxBytes) :
+  mMaxEntries(iMaxEntries),
+  mMaxBytes(iMaxBytes)
+{
+  mMaxEntriesPerShard = (iMaxEntries + NUM_SHARDS - 1) / NUM_SHARDS;
+  if (mMaxEntriesPerShard == 0)
+    mMaxEntriesPerShard = 1;
+  mMaxBytesPerShard = (iMaxBytes + NUM_SHARDS - 1) / NUM_SHARDS;
+
+  //use at least twice as many buckets as entries
+  size_t numBuckets = 1;
+  while(numBuckets < 2 * mMaxEntriesPerShard)
+    numBuckets *= 2;
+
+  for(size_t i=0; i<NUM_SHARDS; i++)
+  {
+    Shard * shard = new Shard();
+    shard->buckets.resize(numBuckets, -1);
+    shard->hand = 0;
+    shard->bytes = 0;
+    shard->hits = 0;
+    shard->misses = 0;
+    shard->evictions = 0;
+    mShards.push_back(shard);
+  }
+}
+
+template <typename Value>
+ClockCache<Value>::~ClockCache()
+{
+  for(size_t i=0; i<mShards.size(); i++)
+  {
+    delete mShards[i];
+  }
+  mShards.clear();
+}
+
+template <typename Value>
+size_t ClockCache<Value>::hash(const std::type_info * iTag, const char * iKey, size_t iKeyLength)
+{
+  //FNV-1a
+  size_t h = (sizeof(size_t) == 8 ? (size_t)14695981039346656037ULL : (size_t)2166136261U);
+  const size_t prime = (sizeof(size_t) == 8 ? (size_t)1099511628211ULL : (size_t)16777619U);
+  for(size_t i=0; i<iKeyLength; i++)
+  {
+    h ^= (unsigned char)iKey[i];
+    h *= prime;
+  }
+  h ^= iTag->hash_code() + 0x9e3779b9 + (h << 6) + (h >> 2);
+  return h;
+}
+
+template <typename Value>
+typename ClockCache<Value>::Shard & ClockCache<Value>::getShard(size_t iHash)
+{
+  //use the high bits for the shard and the low bits for the bucket
+  return *mShards[(iHash >> (sizeof(size_t) * 8 - 8)) & (NUM_SHARDS - 1)];
+}
+
+template <typename Value>
+int ClockCache<Value>::find(const Shard & iShard, size_t iHash, const std::type_info * iTag, const char * iKey, size_t iKeyLength) const
+{
+  int index = iShard.buckets[iHash & (iShard.buckets.size() - 1)];
+  while(index != -1)
+  {
+    const Entry & entry = iShard.entries[index];
+    if (entry.hash == iHash && *entry.tag == *iTag && entry.key.size() == iKeyLength && memcmp(entry.key.data(), iKey, iKeyLength) == 0)
+      return index;
+    index = entry.next;
+  }
+  return -1;
+}
+
+template <typename Value>
+bool ClockCache<Value>::lookup(const std::type_info * iTag, const char * iKey, size_t iKeyLength, Value & oValue)
+{
+  const size_t h = hash(iTag, iKey, iKeyLength);
+  Shard & shard = getShard(h);
+
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  int index = find(shard, h, iTag, iKey, iKeyLength);
+  if (index == -1)
+  {
+    shard.misses++;
+    return false;
+  }
+
+  Entry & entry = shard.entries[index];
+  entry.referenced = true;
+  oValue = entry.value;
+  shard.hits++;
+  return true;
+}
+
+template <typename Value>
+void ClockCache<Value>::unlink(Shard & ioShard, int iEntry)
+{
+  Entry & entry = ioShard.entries[iEntry];
+  int * link = &ioShard.buckets[entry.hash & (ioShard.buckets.size() - 1)];
+  while(*link != iEntry)
+  {
+    link = &ioShard.entries[*link].next;
+  }
+  *link = entry.next;
+  entry.next = -1;
+}
+
+template <typename Value>
+void ClockCache<Value>::evict(Shard & ioShard, int iEntry)
+{
+  Entry & entry = ioShard.entries[iEntry];
+  unlink(ioShard, iEntry);
+  ioShard.bytes -= entry.size;
+  entry.used = false;
+  entry.referenced = false;
+  std::string().swap(entry.key);
+  entry.value = Value();
+  ioShard.freeEntries.push_back(iEntry);
+  ioShard.evictions++;
+}
+
+template <typename Value>
+int ClockCache<Value>::evictNext(Shard & ioShard)
+{
+  //give a second chance to referenced entries. Stops after two rounds at most.
+  for(size_t i=0; i<2 * ioShard.entries.size(); i++)
+  {
+    size_t index = ioShard.hand;
+    ioShard.hand = (ioShard.hand + 1) % ioShard.entries.size();
+
+    Entry & entry = ioShard.entries[index];
+    if (!entry.used)
+      continue;
+    if (entry.referenced)
+    {
+      entry.referenced = false;
+      continue;
+    }
+
+    evict(ioShard, (int)index);
+    return (int)index;
+  }
+  return -1;
+}
+
+template <typename Value>
+void ClockCache<Value>::insert(const std::type_info * iTag, const char * iKey, size_t iKeyLength, const Value & iValue, size_t iValueSize)
+{
+  const size_t entryBytes = iKeyLength + iValueSize;
+  if (mMaxBytesPerShard > 0 && entryBytes > mMaxBytesPerShard)
+    return;
+
+  const size_t h = hash(iTag, iKey, iKeyLength);
+  Shard & shard = getShard(h);
+
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  //another thread may have inserted the same key in the meantime
+  if (find(shard, h, iTag, iKey, iKeyLength) != -1)
+    return;
+
+  //make room for the new entry
+  while(mMaxBytesPerShard > 0 && shard.bytes + entryBytes > mMaxBytesPerShard)
+  {
+    if (evictNext(shard) == -1)
+      break;
+  }
+  if (shard.freeEntries.empty() && shard.entries.size() >= mMaxEntriesPerShard)
+    evictNext(shard);
+
+  int index = -1;
+  if (!shard.freeEntries.empty())
+  {
+    index = shard.freeEntries.back();
+    shard.freeEntries.pop_back();
+  }
+  else
+  {
+    shard.entries.push_back(Entry());
+    index = (int)shard.entries.size() - 1;
+  }
+
+  Entry & entry = shard.entries[index];
+  entry.hash = h;
+  entry.tag = iTag;
+  entry.key.assign(iKey, iKeyLength);
+  entry.value = iValue;
+  entry.size = entryBytes;
+  entry.referenced = false;
+  entry.used = true;
+
+  int & bucket = shard.buckets[h & (shard.buckets.size() - 1)];
+  entry.next = bucket;
+  bucket = index;
+
+  shard.bytes += entryBytes;
+}
+
+template <typename Value>
+void ClockCache<Value>::clear()
+{
+  for(size_t i=0; i<mShards.size(); i++)
+  {
+    Shard & shard = *mShards[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.entries.clear();
+    shard.freeEntries.clear();
+    shard.buckets.assign(shard.buckets.size(), -1);
+    shard.hand = 0;
+    shard.bytes = 0;
+  }
+}
+
+template <typename Value>
+void ClockCache<Value>::getStatistics(ClockCacheStatistics & oStatistics) const
+{
+  oStatistics.hits = 0;
+  oStatistics.misses = 0;
+  oStatistics.evictions = 0;
+  oStatistics.entries = 0;
+  oStatistics.bytes = 0;
+  for(size_t i=0; i<mShards.size(); i++)
+  {
+    const Shard & shard = *mShards[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    oStatistics.hits += shard.hits;
+    oStatistics.misses += shard.misses;
+    oStatistics.evictions += shard.evictions;
+    oStatistics.entries += shard.entries.size() - shard.freeEntries.size();
+    oStatistics.bytes += shard.bytes;
+  }
+}
+
+template <typename Value>
+void ClockCache<Value>::resetStatistics()
+{
+  for(size_t i=0; i<mShards.size(); i++)
+  {
+    Shard & shard = *mShards[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.hits = 0;
+    shard.misses = 0;
+    shard.evictions = 0;
+  }
+}
+
+template <typename Value>
+size_t ClockCache<Value>::getMaxEntries() const
+{
+  return mMaxEntries;
+}
+
+template <typename Value>
+size_t ClockCache<Value>::getMaxBytes() const
+{
+  return mMaxBytes;
+}
+
+//explicit template instantiation
+template class ClockCache<std::string>;
+template class ClockCache<DecodedCommandLinesPtr>;
+
+}; //namespace libargvcodec
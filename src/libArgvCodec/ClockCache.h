@@ -0,0 +1,139 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef CLOCKCACHE_H
+#define CLOCKCACHE_H
+
+#include "libargvcodec/DecodedCommandLines.h"
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <typeinfo>
+
+namespace libargvcodec
+{
+
+  /// <summary>Counters of a ClockCache.</summary>
+  struct ClockCacheStatistics
+  {
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+    size_t entries;
+    size_t bytes;
+  };
+
+  /// <summary>
+  /// Bounded concurrent cache of values keyed by a type tag and a sequence of bytes.
+  /// The values are copied on lookup. Use a shared pointer to an immutable object for large values.
+  /// </summary>
+  /// <remarks>
+  /// The cache is split in shards, each protected by its own mutex, to reduce contention between threads.
+  /// Entries are evicted with the CLOCK algorithm: a hit only sets the referenced flag of the entry which
+  /// keeps the critical section of lookups short (no list reordering like with LRU).
+  /// The key is hashed and compared in place which allows lookups without memory allocation.
+  /// </remarks>
+  template <typename Value>
+  class ClockCache
+  {
+  public:
+    /// <summary>Creates a cache.</summary>
+    /// <param name="iMaxEntries">The maximum number of entries in the cache.</param>
+    /// <param name="iMaxBytes">The maximum size of all keys and values in bytes. Use 0 for no limit.</param>
+    ClockCache(size_t iMaxEntries, size_t iMaxBytes);
+    ~ClockCache();
+
+    /// <summary>Finds the value of the given key.</summary>
+    /// <param name="iTag">The tag of the key, usually the type of a codec. Keys with different tags are different. Tags are compared with type_info::operator==, the hash code of the type is only used for bucketing.</param>
+    /// <param name="iKey">The bytes of the key.</param>
+    /// <param name="iKeyLength">The length of the key in bytes.</param>
+    /// <param name="oValue">The value of the key.</param>
+    /// <returns>Returns true if the key is in the cache. Returns false otherwise.</returns>
+    bool lookup(const std::type_info * iTag, const char * iKey, size_t iKeyLength, Value & oValue);
+
+    /// <summary>Inserts a key and its value. Evicts other entries if the cache is full.</summary>
+    /// <remarks>The entry is not inserted if its size exceeds the byte limit of a shard.</remarks>
+    /// <param name="iValueSize">The memory used by the value in bytes.</param>
+    void insert(const std::type_info * iTag, const char * iKey, size_t iKeyLength, const Value & iValue, size_t iValueSize);
+
+    /// <summary>Removes all entries. The counters are not reset.</summary>
+    void clear();
+
+    /// <summary>Returns the counters of the cache.</summary>
+    void getStatistics(ClockCacheStatistics & oStatistics) const;
+
+    /// <summary>Resets the hits, misses and evictions counters.</summary>
+    void resetStatistics();
+
+    size_t getMaxEntries() const;
+    size_t getMaxBytes() const;
+
+  private:
+    struct Entry
+    {
+      size_t hash;
+      const std::type_info * tag;
+      std::string key;
+      Value value;
+      size_t size;      //size of the key and the value in bytes
+      int next;         //next entry of the same bucket or -1
+      bool referenced;  //CLOCK reference bit
+      bool used;
+    };
+
+    struct Shard
+    {
+      mutable std::mutex mutex;
+      std::vector<Entry> entries;
+      std::vector<int> buckets;
+      std::vector<int> freeEntries;
+      size_t hand;
+      size_t bytes;
+      size_t hits;
+      size_t misses;
+      size_t evictions;
+    };
+
+    //disable copy and assignment
+    ClockCache(const ClockCache &);
+    ClockCache & operator = (const ClockCache &);
+
+    static size_t hash(const std::type_info * iTag, const char * iKey, size_t iKeyLength);
+    Shard & getShard(size_t iHash);
+    int find(const Shard & iShard, size_t iHash, const std::type_info * iTag, const char * iKey, size_t iKeyLength) const;
+    void unlink(Shard & ioShard, int iEntry);
+    void evict(Shard & ioShard, int iEntry);
+    int evictNext(Shard & ioShard);
+
+    std::vector<Shard*> mShards;
+    size_t mMaxEntries;
+    size_t mMaxBytes;
+    size_t mMaxEntriesPerShard;
+    size_t mMaxBytesPerShard;
+  };
+
+}; //namespace libargvcodec
+
+#endif //CLOCKCACHE_H
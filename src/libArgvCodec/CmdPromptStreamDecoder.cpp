@@ -0,0 +1,70 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "libargvcodec/CmdPromptStreamDecoder.h"
+#include "WindowsArgumentCodecCore.h"
+
+#include <new> //for placement new
+
+namespace libargvcodec
+{
+
+typedef WindowsStreamDecoderCore<CmdPromptDialect> CmdPromptStreamDecoderCore;
+
+CmdPromptStreamDecoder::CmdPromptStreamDecoder(IArgumentHandler & iHandler, IMemoryResource * iResource) :
+  mHandler(iHandler),
+  mResource(iResource != NULL ? iResource : getDefaultMemoryResource()),
+  mCore(NULL)
+{
+  void * core = mResource->allocate(sizeof(CmdPromptStreamDecoderCore), alignof(CmdPromptStreamDecoderCore));
+  mCore = new(core) CmdPromptStreamDecoderCore(mResource);
+}
+
+CmdPromptStreamDecoder::~CmdPromptStreamDecoder()
+{
+  mCore->~CmdPromptStreamDecoderCore();
+  mResource->deallocate(mCore, sizeof(CmdPromptStreamDecoderCore), alignof(CmdPromptStreamDecoderCore));
+}
+
+void CmdPromptStreamDecoder::reset()
+{
+  mCore->reset();
+}
+
+bool CmdPromptStreamDecoder::feed(const char * iBuffer, size_t iLength)
+{
+  if (iBuffer == NULL && iLength > 0)
+    return false;
+
+  mCore->feed(iBuffer, iLength, mHandler);
+  return true;
+}
+
+bool CmdPromptStreamDecoder::finish()
+{
+  mCore->finish(mHandler);
+  return true;
+}
+
+}; //namespace libargvcodec
@@ -0,0 +1,116 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "libargvcodec/CommandLineSplitter.h"
+
+namespace libargvcodec
+{
+
+CommandLineSplitter::CommandLineSplitter(const IArgumentEncoder & iEncoder) :
+  mEncoder(iEncoder)
+{
+}
+
+CommandLineSplitter::~CommandLineSplitter()
+{
+}
+
+bool CommandLineSplitter::split(const ArgumentList & iArguments, int iFirstTrailingArgument, size_t iMaxLength, ArgumentListVector & oBatches, ArgumentList::StringList & oCommandLines)
+{
+  oBatches.clear();
+  oCommandLines.clear();
+
+  const int argc = iArguments.getArgc();
+  if (iFirstTrailingArgument < 1 || iFirstTrailingArgument > argc)
+    return false;
+
+  //encode the leading arguments once
+  std::string leadingCmdLine;
+  ArgumentList::StringList leadingArguments;
+  for(int i=0; i<iFirstTrailingArgument; i++)
+  {
+    leadingArguments.push_back(iArguments.getArgument(i));
+
+    //skip first element since it refers to the actual .exe that was launched
+    if (i == 0)
+      continue;
+    if (!leadingCmdLine.empty())
+      leadingCmdLine.append(1, ' ');
+    leadingCmdLine.append(mEncoder.encodeArgument(iArguments.getArgument(i)));
+  }
+
+  if (leadingCmdLine.size() > iMaxLength)
+    return false;
+
+  //a single pass over the trailing arguments.
+  //each argument is added to the current batch if it fits. Otherwise, a new batch is started.
+  //Since the order of the arguments is preserved, this greedy approach gives the minimum number of batches.
+  ArgumentList::StringList batchArguments = leadingArguments;
+  std::string batchCmdLine = leadingCmdLine;
+  bool isBatchEmpty = true;
+  for(int i=iFirstTrailingArgument; i<argc; i++)
+  {
+    const char * value = iArguments.getArgument(i);
+    const std::string arg = mEncoder.encodeArgument(value);
+
+    //start a new batch if the argument does not fit in the current batch
+    if (!isBatchEmpty && batchCmdLine.size() + 1 + arg.size() > iMaxLength)
+    {
+      oBatches.push_back(ArgumentList());
+      oBatches.back().init(batchArguments);
+      oCommandLines.push_back(batchCmdLine);
+
+      batchArguments = leadingArguments;
+      batchCmdLine = leadingCmdLine;
+      isBatchEmpty = true;
+    }
+
+    //the argument does not fit in an empty batch
+    const size_t separatorLength = (batchCmdLine.empty() ? 0 : 1);
+    if (batchCmdLine.size() + separatorLength + arg.size() > iMaxLength)
+    {
+      oBatches.clear();
+      oCommandLines.clear();
+      return false;
+    }
+
+    if (!batchCmdLine.empty())
+      batchCmdLine.append(1, ' ');
+    batchCmdLine.append(arg);
+    batchArguments.push_back(value);
+    isBatchEmpty = false;
+  }
+
+  //last batch
+  if (!isBatchEmpty)
+  {
+    oBatches.push_back(ArgumentList());
+    oBatches.back().init(batchArguments);
+    oCommandLines.push_back(batchCmdLine);
+  }
+
+  return true;
+}
+
+}; //namespace libargvcodec
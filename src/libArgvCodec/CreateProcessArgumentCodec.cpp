@@ -23,6 +23,10 @@
  *********************************************************************************/
 
 #include "libargvcodec/CreateProcessArgumentCodec.h"
+#include "libargvcodec/CreateProcessStreamDecoder.h"
+#include "WindowsArgumentCodecCore.h"
+#include "SharedDecoder.h"
+#include "StatsScope.h"
 
 namespace libargvcodec
 {
@@ -35,19 +39,58 @@ CreateProcessArgumentCodec::~CreateProcessArgumentCodec()
 {
 }
 
-bool CreateProcessArgumentCodec::isShellCharacter(const char /*c*/)
+//IArgumentEncoder
+std::string CreateProcessArgumentCodec::encodeArgument(const char * iValue) const
 {
-  return false; //No such thing as shell characters
+  LIBARGVCODEC_STATS_SCOPE();
+  return CreateProcessCodecCore::encodeArgument(iValue);
 }
 
-bool CreateProcessArgumentCodec::hasShellCharacters(const char * /*iValue*/)
+std::string CreateProcessArgumentCodec::encodeCommandLine(const ArgumentList & iArguments) const
 {
-  return false; //No such thing as shell characters
+  LIBARGVCODEC_STATS_SCOPE();
+  return CreateProcessCodecCore::encodeCommandLine(iArguments);
 }
 
-bool CreateProcessArgumentCodec::supportsShellCharacters()
+void CreateProcessArgumentCodec::appendEncodedArgument(const char * iValue, ResourceString & ioOutput) const
 {
-  return false;
+  LIBARGVCODEC_STATS_SCOPE();
+  CreateProcessCodecCore::appendEncodedArgument(iValue, ioOutput);
+}
+
+//IArgumentDecoder
+std::string CreateProcessArgumentCodec::decodeArgument(const char * iValue) const
+{
+  LIBARGVCODEC_STATS_SCOPE();
+  return CreateProcessCodecCore::decodeArgument(iValue);
+}
+
+ArgumentList CreateProcessArgumentCodec::decodeCommandLine(const char * iValue) const
+{
+  LIBARGVCODEC_STATS_SCOPE();
+  if (getDecodeCache() == NULL)
+    return CreateProcessCodecCore::decodeCommandLine(iValue);
+  return toArgumentList(decodeShared(iValue));
+}
+
+IArgumentStreamDecoder * CreateProcessArgumentCodec::createStreamDecoder(IArgumentHandler & iHandler) const
+{
+  return new CreateProcessStreamDecoder(iHandler);
+}
+
+bool CreateProcessArgumentCodec::isShellCharacter(const char c) const
+{
+  return CreateProcessDialect::isShellCharacter(c); //No such thing as shell characters
+}
+
+bool CreateProcessArgumentCodec::hasShellCharacters(const char * iValue) const
+{
+  return CreateProcessCodecCore::hasShellCharacters(iValue); //No such thing as shell characters
+}
+
+bool CreateProcessArgumentCodec::supportsShellCharacters() const
+{
+  return CreateProcessDialect::SUPPORTS_SHELL_CHARACTERS;
 }
 
 }; //namespace libargvcodec
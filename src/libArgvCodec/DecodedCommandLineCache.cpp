@@ -0,0 +1,127 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "libargvcodec/DecodedCommandLineCache.h"
+#include "ClockCache.h"
+
+#include <cstring> //for strlen()
+#include <typeinfo>
+
+namespace libargvcodec
+{
+
+static const std::type_info * getDialectTag(const IArgumentDecoder & iDecoder)
+{
+  return &typeid(iDecoder);
+}
+
+static size_t getMemoryUsage(const DecodedCommandLines & iDecoded)
+{
+  return sizeof(DecodedCommandLines) +
+         iDecoded.getArena().capacity() +
+         iDecoded.getArgumentOffsets().capacity() * sizeof(size_t) +
+         iDecoded.getCommandLineOffsets().capacity() * sizeof(size_t);
+}
+
+DecodedCommandLineCache::DecodedCommandLineCache(size_t iMaxBytes, size_t iMaxEntries) :
+  mCache(new ClockCache<DecodedCommandLinesPtr>(iMaxEntries, iMaxBytes))
+{
+}
+
+DecodedCommandLineCache::~DecodedCommandLineCache()
+{
+  delete mCache;
+  mCache = NULL;
+}
+
+bool DecodedCommandLineCache::lookup(const IArgumentDecoder & iDecoder, const char * iCommandLine, DecodedCommandLinesPtr & oDecoded)
+{
+  if (iCommandLine == NULL)
+    return false;
+  return mCache->lookup(getDialectTag(iDecoder), iCommandLine, strlen(iCommandLine), oDecoded);
+}
+
+void DecodedCommandLineCache::insert(const IArgumentDecoder & iDecoder, const char * iCommandLine, const DecodedCommandLinesPtr & iDecoded)
+{
+  if (iCommandLine == NULL || iDecoded == NULL)
+    return;
+  mCache->insert(getDialectTag(iDecoder), iCommandLine, strlen(iCommandLine), iDecoded, getMemoryUsage(*iDecoded));
+}
+
+void DecodedCommandLineCache::clear()
+{
+  mCache->clear();
+}
+
+size_t DecodedCommandLineCache::getMaxBytes() const
+{
+  return mCache->getMaxBytes();
+}
+
+size_t DecodedCommandLineCache::getMaxEntries() const
+{
+  return mCache->getMaxEntries();
+}
+
+size_t DecodedCommandLineCache::getNumEntries() const
+{
+  ClockCacheStatistics statistics;
+  mCache->getStatistics(statistics);
+  return statistics.entries;
+}
+
+size_t DecodedCommandLineCache::getNumBytes() const
+{
+  ClockCacheStatistics statistics;
+  mCache->getStatistics(statistics);
+  return statistics.bytes;
+}
+
+size_t DecodedCommandLineCache::getNumHits() const
+{
+  ClockCacheStatistics statistics;
+  mCache->getStatistics(statistics);
+  return statistics.hits;
+}
+
+size_t DecodedCommandLineCache::getNumMisses() const
+{
+  ClockCacheStatistics statistics;
+  mCache->getStatistics(statistics);
+  return statistics.misses;
+}
+
+size_t DecodedCommandLineCache::getNumEvictions() const
+{
+  ClockCacheStatistics statistics;
+  mCache->getStatistics(statistics);
+  return statistics.evictions;
+}
+
+void DecodedCommandLineCache::resetStatistics()
+{
+  mCache->resetStatistics();
+}
+
+}; //namespace libargvcodec
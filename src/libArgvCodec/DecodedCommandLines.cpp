@@ -0,0 +1,109 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "libargvcodec/DecodedCommandLines.h"
+
+namespace libargvcodec
+{
+
+DecodedCommandLines::DecodedCommandLines(IMemoryResource * iResource) :
+  mArena(ByteArray::allocator_type(iResource)),
+  mArgumentOffsets(OffsetArray::allocator_type(iResource)),
+  mCommandLineOffsets(OffsetArray::allocator_type(iResource))
+{
+  clear();
+}
+
+DecodedCommandLines::~DecodedCommandLines()
+{
+}
+
+void DecodedCommandLines::clear()
+{
+  mArena.clear();
+  mArgumentOffsets.assign(1, 0);
+  mCommandLineOffsets.assign(1, 0);
+}
+
+size_t DecodedCommandLines::getNumCommandLines() const
+{
+  return mCommandLineOffsets.size() - 1;
+}
+
+size_t DecodedCommandLines::getNumArguments() const
+{
+  return mArgumentOffsets.size() - 1;
+}
+
+size_t DecodedCommandLines::getArgc(size_t iCommandLine) const
+{
+  if (iCommandLine >= getNumCommandLines())
+    return 0;
+  return mCommandLineOffsets[iCommandLine+1] - mCommandLineOffsets[iCommandLine];
+}
+
+const char * DecodedCommandLines::getArgument(size_t iCommandLine, size_t iIndex) const
+{
+  if (iIndex >= getArgc(iCommandLine))
+    return NULL;
+  const size_t argument = mCommandLineOffsets[iCommandLine] + iIndex;
+  return &mArena[mArgumentOffsets[argument]];
+}
+
+size_t DecodedCommandLines::getArgumentLength(size_t iCommandLine, size_t iIndex) const
+{
+  if (iIndex >= getArgc(iCommandLine))
+    return 0;
+  const size_t argument = mCommandLineOffsets[iCommandLine] + iIndex;
+  return mArgumentOffsets[argument+1] - mArgumentOffsets[argument] - 1; //without the NULL character
+}
+
+const DecodedCommandLines::ByteArray & DecodedCommandLines::getArena() const
+{
+  return mArena;
+}
+
+const DecodedCommandLines::OffsetArray & DecodedCommandLines::getArgumentOffsets() const
+{
+  return mArgumentOffsets;
+}
+
+const DecodedCommandLines::OffsetArray & DecodedCommandLines::getCommandLineOffsets() const
+{
+  return mCommandLineOffsets;
+}
+
+void DecodedCommandLines::onArgument(const char * iValue, size_t iLength)
+{
+  mArena.insert(mArena.end(), iValue, iValue + iLength);
+  mArena.push_back('\0');
+  mArgumentOffsets.push_back(mArena.size());
+}
+
+void DecodedCommandLines::endCommandLine()
+{
+  mCommandLineOffsets.push_back(getNumArguments());
+}
+
+}; //namespace libargvcodec
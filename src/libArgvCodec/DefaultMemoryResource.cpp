@@ -0,0 +1,53 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "libargvcodec/IMemoryResource.h"
+
+#include <new>
+
+namespace libargvcodec
+{
+
+/// <summary>Resource which allocates from the global heap.</summary>
+class NewDeleteMemoryResource : public virtual IMemoryResource
+{
+public:
+  virtual void * allocate(size_t iSize, size_t /*iAlignment*/)
+  {
+    return ::operator new(iSize);
+  }
+
+  virtual void deallocate(void * iPointer, size_t /*iSize*/, size_t /*iAlignment*/)
+  {
+    ::operator delete(iPointer);
+  }
+};
+
+IMemoryResource * getDefaultMemoryResource()
+{
+  static NewDeleteMemoryResource gResource;
+  return &gResource;
+}
+
+}; //namespace libargvcodec
@@ -0,0 +1,107 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "libargvcodec/EncodedArgumentCache.h"
+#include "ClockCache.h"
+
+#include <cstring> //for strlen()
+#include <typeinfo>
+
+namespace libargvcodec
+{
+
+static const std::type_info * getDialectTag(const IArgumentEncoder & iEncoder)
+{
+  return &typeid(iEncoder);
+}
+
+EncodedArgumentCache::EncodedArgumentCache(size_t iMaxEntries) :
+  mCache(new ClockCache<std::string>(iMaxEntries, 0))
+{
+}
+
+EncodedArgumentCache::~EncodedArgumentCache()
+{
+  delete mCache;
+  mCache = NULL;
+}
+
+bool EncodedArgumentCache::lookup(const IArgumentEncoder & iEncoder, const char * iValue, std::string & oEncoded)
+{
+  if (iValue == NULL)
+    return false;
+  return mCache->lookup(getDialectTag(iEncoder), iValue, strlen(iValue), oEncoded);
+}
+
+void EncodedArgumentCache::insert(const IArgumentEncoder & iEncoder, const char * iValue, const std::string & iEncoded)
+{
+  if (iValue == NULL)
+    return;
+  mCache->insert(getDialectTag(iEncoder), iValue, strlen(iValue), iEncoded, iEncoded.size());
+}
+
+void EncodedArgumentCache::clear()
+{
+  mCache->clear();
+}
+
+size_t EncodedArgumentCache::getMaxEntries() const
+{
+  return mCache->getMaxEntries();
+}
+
+size_t EncodedArgumentCache::getNumEntries() const
+{
+  ClockCacheStatistics statistics;
+  mCache->getStatistics(statistics);
+  return statistics.entries;
+}
+
+size_t EncodedArgumentCache::getNumHits() const
+{
+  ClockCacheStatistics statistics;
+  mCache->getStatistics(statistics);
+  return statistics.hits;
+}
+
+size_t EncodedArgumentCache::getNumMisses() const
+{
+  ClockCacheStatistics statistics;
+  mCache->getStatistics(statistics);
+  return statistics.misses;
+}
+
+size_t EncodedArgumentCache::getNumEvictions() const
+{
+  ClockCacheStatistics statistics;
+  mCache->getStatistics(statistics);
+  return statistics.evictions;
+}
+
+void EncodedArgumentCache::resetStatistics()
+{
+  mCache->resetStatistics();
+}
+
+}; //namespace libargvcodec
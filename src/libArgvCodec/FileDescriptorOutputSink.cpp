@@ -0,0 +1,74 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "libargvcodec/FileDescriptorOutputSink.h"
+
+#ifdef _WIN32
+#include <io.h> //for _write()
+#else
+#include <unistd.h> //for write()
+#include <errno.h>
+#endif
+
+namespace libargvcodec
+{
+
+FileDescriptorOutputSink::FileDescriptorOutputSink(int iFileDescriptor, size_t iBufferSize) :
+  BufferedOutputSink(iBufferSize),
+  mFileDescriptor(iFileDescriptor)
+{
+}
+
+FileDescriptorOutputSink::~FileDescriptorOutputSink()
+{
+  flush();
+}
+
+bool FileDescriptorOutputSink::writeBuffer(const char * iBuffer, size_t iLength)
+{
+  if (mFileDescriptor < 0)
+    return false;
+
+  //write() may write less bytes than requested
+  while(iLength > 0)
+  {
+#ifdef _WIN32
+    unsigned int count = (iLength > 0x7FFFFFFF ? 0x7FFFFFFF : (unsigned int)iLength);
+    int written = _write(mFileDescriptor, iBuffer, count);
+    if (written < 0)
+      return false;
+#else
+    ssize_t written = ::write(mFileDescriptor, iBuffer, iLength);
+    if (written < 0 && errno == EINTR)
+      continue;
+    if (written < 0)
+      return false;
+#endif
+    iBuffer += written;
+    iLength -= (size_t)written;
+  }
+  return true;
+}
+
+}; //namespace libargvcodec
@@ -0,0 +1,57 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "libargvcodec/FileOutputSink.h"
+
+namespace libargvcodec
+{
+
+FileOutputSink::FileOutputSink(FILE * iFile) :
+  mFile(iFile)
+{
+}
+
+FileOutputSink::~FileOutputSink()
+{
+}
+
+bool FileOutputSink::write(const char * iBuffer, size_t iLength)
+{
+  if (mFile == NULL || (iBuffer == NULL && iLength > 0))
+    return false;
+  if (iLength == 0)
+    return true;
+
+  size_t written = fwrite(iBuffer, 1, iLength, mFile);
+  return (written == iLength);
+}
+
+bool FileOutputSink::flush()
+{
+  if (mFile == NULL)
+    return false;
+  return (fflush(mFile) == 0);
+}
+
+}; //namespace libargvcodec
@@ -0,0 +1,157 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "libargvcodec/FrozenArgumentList.h"
+
+namespace libargvcodec
+{
+
+static void copyOptionPrefixes(const ArgumentList & iSource, ArgumentList & oTarget)
+{
+  oTarget.clearOptionPrefixes();
+  const ArgumentList::StringList & prefixes = iSource.getOptionPrefixes();
+  for(size_t i=0; i<prefixes.size(); i++)
+  {
+    oTarget.addOptionPrefix(prefixes[i].c_str());
+  }
+}
+
+FrozenArgumentList::FrozenArgumentList()
+{
+}
+
+FrozenArgumentList::FrozenArgumentList(const ArgumentList & iArguments) :
+  mArguments(iArguments)
+{
+  //the copy constructor of ArgumentList does not copy the prefixes
+  copyOptionPrefixes(iArguments, mArguments);
+}
+
+FrozenArgumentList::~FrozenArgumentList()
+{
+}
+
+ArgumentList FrozenArgumentList::toArgumentList() const
+{
+  ArgumentList copy(mArguments);
+  copyOptionPrefixes(mArguments, copy);
+  return copy;
+}
+
+const char * FrozenArgumentList::getArgument(int iIndex) const
+{
+  return mArguments.getArgument(iIndex);
+}
+
+int FrozenArgumentList::getArgc() const
+{
+  return mArguments.getArgc();
+}
+
+const char * const * FrozenArgumentList::getArgv() const
+{
+  return mArguments.getArgv();
+}
+
+int FrozenArgumentList::findIndex(const char * iValue) const
+{
+  return mArguments.findIndex(iValue);
+}
+
+int FrozenArgumentList::findIndex(const char * iValue, bool iCaseSensitive) const
+{
+  return mArguments.findIndex(iValue, iCaseSensitive);
+}
+
+bool FrozenArgumentList::contains(const char * iValue) const
+{
+  return mArguments.contains(iValue);
+}
+
+bool FrozenArgumentList::contains(const char * iValue, bool iCaseSensitive) const
+{
+  return mArguments.contains(iValue, iCaseSensitive);
+}
+
+bool FrozenArgumentList::findOption(const char * iValue) const
+{
+  return mArguments.findOption(iValue);
+}
+
+bool FrozenArgumentList::findOption(const char * iValue, int & oIndex) const
+{
+  return mArguments.findOption(iValue, oIndex);
+}
+
+bool FrozenArgumentList::findOption(const char * iValue, bool iCaseSensitive, int & oIndex) const
+{
+  return mArguments.findOption(iValue, iCaseSensitive, oIndex);
+}
+
+bool FrozenArgumentList::findValue(const char * iValueName, int & oIndex, std::string & oValue) const
+{
+  return mArguments.findValue(iValueName, oIndex, oValue);
+}
+
+bool FrozenArgumentList::findValue(const char * iValueName, int & oIndex, int & oValue) const
+{
+  return mArguments.findValue(iValueName, oIndex, oValue);
+}
+
+bool FrozenArgumentList::findValue(const char * iValueName, bool iCaseSensitive, int & oIndex, std::string & oValue) const
+{
+  return mArguments.findValue(iValueName, iCaseSensitive, oIndex, oValue);
+}
+
+bool FrozenArgumentList::findValue(const char * iValueName, bool iCaseSensitive, int & oIndex, int & oValue) const
+{
+  return mArguments.findValue(iValueName, iCaseSensitive, oIndex, oValue);
+}
+
+bool FrozenArgumentList::findNextValue(const char * iValueName, int & oIndex, std::string & oValue) const
+{
+  return mArguments.findNextValue(iValueName, oIndex, oValue);
+}
+
+bool FrozenArgumentList::findNextValue(const char * iValueName, int & oIndex, int & oValue) const
+{
+  return mArguments.findNextValue(iValueName, oIndex, oValue);
+}
+
+bool FrozenArgumentList::findNextValue(const char * iValueName, bool iCaseSensitive, int & oIndex, std::string & oValue) const
+{
+  return mArguments.findNextValue(iValueName, iCaseSensitive, oIndex, oValue);
+}
+
+bool FrozenArgumentList::findNextValue(const char * iValueName, bool iCaseSensitive, int & oIndex, int & oValue) const
+{
+  return mArguments.findNextValue(iValueName, iCaseSensitive, oIndex, oValue);
+}
+
+const ArgumentList::StringList & FrozenArgumentList::getOptionPrefixes() const
+{
+  return mArguments.getOptionPrefixes();
+}
+
+}; //namespace libargvcodec
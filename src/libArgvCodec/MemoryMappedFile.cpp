@@ -0,0 +1,184 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "MemoryMappedFile.h"
+
+#ifdef _WIN32
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN // Exclude rarely-used stuff from Windows headers
+#   endif /* WIN32_LEAN_AND_MEAN */
+#   include <Windows.h>
+#else
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
+
+namespace libargvcodec
+{
+
+static const char gEmptyContent[] = "";
+
+MemoryMappedFile::MemoryMappedFile() :
+  mData(NULL),
+  mSize(0)
+#ifdef _WIN32
+  ,mFile(INVALID_HANDLE_VALUE),
+  mMapping(NULL)
+#endif
+{
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+  close();
+}
+
+#ifdef _WIN32
+
+bool MemoryMappedFile::open(const char * iPath)
+{
+  close();
+
+  if (iPath == NULL)
+    return false;
+
+  mFile = CreateFileA(iPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (mFile == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(mFile, &size))
+  {
+    close();
+    return false;
+  }
+
+  //empty files can not be mapped
+  if (size.QuadPart == 0)
+  {
+    mData = gEmptyContent;
+    mSize = 0;
+    return true;
+  }
+
+  mMapping = CreateFileMappingA(mFile, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mMapping == NULL)
+  {
+    close();
+    return false;
+  }
+
+  mData = (const char *)MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0);
+  if (mData == NULL)
+  {
+    close();
+    return false;
+  }
+  mSize = (size_t)size.QuadPart;
+
+  return true;
+}
+
+void MemoryMappedFile::close()
+{
+  if (mData != NULL && mData != gEmptyContent)
+    UnmapViewOfFile(mData);
+  if (mMapping != NULL)
+    CloseHandle(mMapping);
+  if (mFile != INVALID_HANDLE_VALUE)
+    CloseHandle(mFile);
+
+  mData = NULL;
+  mSize = 0;
+  mMapping = NULL;
+  mFile = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+bool MemoryMappedFile::open(const char * iPath)
+{
+  close();
+
+  if (iPath == NULL)
+    return false;
+
+  int fd = ::open(iPath, O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+  {
+    ::close(fd);
+    return false;
+  }
+
+  //empty files can not be mapped
+  if (info.st_size == 0)
+  {
+    ::close(fd);
+    mData = gEmptyContent;
+    mSize = 0;
+    return true;
+  }
+
+  void * data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd); //the mapping keeps a reference to the file
+  if (data == MAP_FAILED)
+    return false;
+
+  //the file is read once from start to end
+  madvise(data, (size_t)info.st_size, MADV_SEQUENTIAL);
+
+  mData = (const char *)data;
+  mSize = (size_t)info.st_size;
+
+  return true;
+}
+
+void MemoryMappedFile::close()
+{
+  if (mData != NULL && mData != gEmptyContent)
+    munmap((void *)mData, mSize);
+
+  mData = NULL;
+  mSize = 0;
+}
+
+#endif //_WIN32
+
+const char * MemoryMappedFile::getData() const
+{
+  return mData;
+}
+
+size_t MemoryMappedFile::getSize() const
+{
+  return mSize;
+}
+
+}; //namespace libargvcodec
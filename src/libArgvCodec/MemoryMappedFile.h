@@ -0,0 +1,68 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef MEMORYMAPPEDFILE_H
+#define MEMORYMAPPEDFILE_H
+
+#include <cstddef> //for size_t
+
+namespace libargvcodec
+{
+
+  /// <summary>Read-only view of a file mapped in memory.</summary>
+  class MemoryMappedFile
+  {
+  public:
+    MemoryMappedFile();
+    virtual ~MemoryMappedFile();
+
+    /// <summary>Maps the given file in memory.</summary>
+    /// <param name="iPath">The path of the file.</param>
+    /// <returns>Returns true if the file is mapped. Returns false otherwise.</returns>
+    bool open(const char * iPath);
+
+    /// <summary>Unmaps the file.</summary>
+    void close();
+
+    /// <summary>Returns the content of the file. The content is not NULL terminated.</summary>
+    const char * getData() const;
+
+    /// <summary>Returns the size of the file in bytes.</summary>
+    size_t getSize() const;
+
+  private:
+    MemoryMappedFile(const MemoryMappedFile &);
+    MemoryMappedFile & operator=(const MemoryMappedFile &);
+
+    const char * mData;
+    size_t mSize;
+#ifdef _WIN32
+    void * mFile;
+    void * mMapping;
+#endif
+  };
+
+}; //namespace libargvcodec
+
+#endif //MEMORYMAPPEDFILE_H
@@ -0,0 +1,136 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "libargvcodec/MonotonicMemoryResource.h"
+
+#include <new> //for std::bad_alloc
+
+namespace libargvcodec
+{
+
+/// <summary>Header of a chunk allocated from the upstream resource. The chunks form a linked list.</summary>
+struct MonotonicMemoryResource::Chunk
+{
+  Chunk * next;
+  size_t size;
+};
+
+static const size_t CHUNK_ALIGNMENT = sizeof(void*) * 2;
+static const size_t MAX_CHUNK_SIZE = (size_t)-1;
+
+MonotonicMemoryResource::MonotonicMemoryResource(IMemoryResource * iUpstream) :
+  mUpstream(iUpstream != NULL ? iUpstream : getDefaultMemoryResource()),
+  mBuffer(NULL),
+  mBufferSize(0),
+  mChunks(NULL)
+{
+  release();
+}
+
+MonotonicMemoryResource::MonotonicMemoryResource(void * iBuffer, size_t iSize, IMemoryResource * iUpstream) :
+  mUpstream(iUpstream != NULL ? iUpstream : getDefaultMemoryResource()),
+  mBuffer(static_cast<char *>(iBuffer)),
+  mBufferSize(iBuffer != NULL ? iSize : 0),
+  mChunks(NULL)
+{
+  release();
+}
+
+MonotonicMemoryResource::~MonotonicMemoryResource()
+{
+  release();
+}
+
+void * MonotonicMemoryResource::allocate(size_t iSize, size_t iAlignment)
+{
+  if (iAlignment == 0)
+    iAlignment = 1;
+
+  //align the current pointer
+  size_t padding = (iAlignment - ((size_t)mCurrent & (iAlignment - 1))) & (iAlignment - 1);
+  if (mCurrent == NULL || padding > (size_t)(mEnd - mCurrent) || iSize > (size_t)(mEnd - mCurrent) - padding)
+  {
+    //the current block is full, allocate a new chunk
+    const size_t minSize = sizeof(Chunk) + iAlignment + iSize;
+    if (minSize < iSize)
+      throw std::bad_alloc();
+    size_t chunkSize = mNextChunkSize;
+    while (chunkSize < minSize)
+    {
+      //doubling the size would overflow
+      if (chunkSize > MAX_CHUNK_SIZE / 2)
+        throw std::bad_alloc();
+      chunkSize *= 2;
+    }
+    mNextChunkSize = (chunkSize <= MAX_CHUNK_SIZE / 2 ? chunkSize * 2 : chunkSize);
+
+    Chunk * chunk = static_cast<Chunk *>(mUpstream->allocate(chunkSize, CHUNK_ALIGNMENT));
+    chunk->next = mChunks;
+    chunk->size = chunkSize;
+    mChunks = chunk;
+    mNumChunks++;
+
+    mCurrent = reinterpret_cast<char *>(chunk) + sizeof(Chunk);
+    mEnd = reinterpret_cast<char *>(chunk) + chunkSize;
+    padding = (iAlignment - ((size_t)mCurrent & (iAlignment - 1))) & (iAlignment - 1);
+  }
+
+  char * block = mCurrent + padding;
+  mCurrent = block + iSize;
+  mNumBytes += padding + iSize;
+  return block;
+}
+
+void MonotonicMemoryResource::deallocate(void * /*iPointer*/, size_t /*iSize*/, size_t /*iAlignment*/)
+{
+  //memory is released all at once
+}
+
+void MonotonicMemoryResource::release()
+{
+  while (mChunks != NULL)
+  {
+    Chunk * next = mChunks->next;
+    mUpstream->deallocate(mChunks, mChunks->size, CHUNK_ALIGNMENT);
+    mChunks = next;
+  }
+
+  mCurrent = mBuffer;
+  mEnd = mBuffer + mBufferSize;
+  mNextChunkSize = (mBufferSize > DEFAULT_CHUNK_SIZE ? mBufferSize : DEFAULT_CHUNK_SIZE);
+  mNumBytes = 0;
+  mNumChunks = 0;
+}
+
+size_t MonotonicMemoryResource::getNumBytes() const
+{
+  return mNumBytes;
+}
+
+size_t MonotonicMemoryResource::getNumChunks() const
+{
+  return mNumChunks;
+}
+
+}; //namespace libargvcodec
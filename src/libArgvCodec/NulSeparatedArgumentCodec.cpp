@@ -0,0 +1,173 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "libargvcodec/NulSeparatedArgumentCodec.h"
+#include "StatsScope.h"
+
+#include "rapidassist/process.h"
+
+#include <cstring> //for memchr()
+
+namespace libargvcodec
+{
+
+/// <summary>Appends the NULL separated arguments of a blob to a list. The list is grown once.</summary>
+static void appendArgumentVector(const char * iData, size_t iSize, ArgumentList::StringList & ioArguments)
+{
+  const char * end = iData + iSize;
+
+  //count the arguments
+  size_t numArguments = 0;
+  for(const char * position = iData; position < end; numArguments++)
+  {
+    const char * terminator = (const char *)memchr(position, '\0', end - position);
+    position = (terminator != NULL ? terminator + 1 : end);
+  }
+
+  ioArguments.reserve(ioArguments.size() + numArguments);
+  for(const char * position = iData; position < end; )
+  {
+    const char * terminator = (const char *)memchr(position, '\0', end - position);
+    if (terminator == NULL)
+      terminator = end;
+    ioArguments.push_back(std::string(position, terminator));
+    position = terminator + 1;
+  }
+}
+
+NulSeparatedArgumentCodec::NulSeparatedArgumentCodec()
+{
+}
+
+NulSeparatedArgumentCodec::~NulSeparatedArgumentCodec()
+{
+}
+
+//IArgumentEncoder
+std::string NulSeparatedArgumentCodec::encodeArgument(const char * iValue) const
+{
+  LIBARGVCODEC_STATS_SCOPE();
+  if (iValue == NULL)
+    return std::string();
+  return std::string(iValue);
+}
+
+std::string NulSeparatedArgumentCodec::encodeCommandLine(const ArgumentList & iArguments) const
+{
+  LIBARGVCODEC_STATS_SCOPE();
+
+  //compute the size of the command line to allocate once
+  size_t size = 0;
+  for(int i=1; i<iArguments.getArgc(); i++) //skip first element since it refers to the actual .exe that was launched
+  {
+    size += strlen(iArguments.getArgument(i)) + 1;
+  }
+
+  std::string cmdline;
+  cmdline.reserve(size);
+  for(int i=1; i<iArguments.getArgc(); i++)
+  {
+    const char * argValue = iArguments.getArgument(i);
+    cmdline.append(argValue, strlen(argValue) + 1); //including the NULL terminator
+  }
+
+  return cmdline;
+}
+
+void NulSeparatedArgumentCodec::appendEncodedArgument(const char * iValue, ResourceString & ioOutput) const
+{
+  LIBARGVCODEC_STATS_SCOPE();
+  if (iValue != NULL)
+    ioOutput.append(iValue);
+}
+
+//IArgumentDecoder
+std::string NulSeparatedArgumentCodec::decodeArgument(const char * iValue) const
+{
+  LIBARGVCODEC_STATS_SCOPE();
+  if (iValue == NULL)
+    return std::string();
+  return std::string(iValue);
+}
+
+ArgumentList NulSeparatedArgumentCodec::decodeCommandLine(const char * iValue) const
+{
+  LIBARGVCODEC_STATS_SCOPE();
+  ArgumentList arglist;
+  if (iValue == NULL)
+    return arglist;
+
+  //find the empty argument which terminates the list
+  const char * end = iValue;
+  while (*end != '\0')
+  {
+    end += strlen(end) + 1;
+  }
+
+  ArgumentList::StringList args;
+  args.push_back(ra::process::getCurrentProcessPath());
+  appendArgumentVector(iValue, (size_t)(end - iValue), args);
+  arglist.init(args);
+
+  return arglist;
+}
+
+bool NulSeparatedArgumentCodec::decodeArgumentVector(const char * iData, size_t iSize, ArgumentList & oArguments) const
+{
+  LIBARGVCODEC_STATS_SCOPE();
+  if (iData == NULL)
+    return false;
+
+  ArgumentList::StringList args;
+  appendArgumentVector(iData, iSize, args);
+  oArguments.init(args);
+  return true;
+}
+
+bool NulSeparatedArgumentCodec::decodeArgumentVector(const char * iData, size_t iSize, IArgumentHandler & iHandler) const
+{
+  LIBARGVCODEC_STATS_SCOPE();
+  if (iData == NULL)
+    return false;
+
+  const char * position = iData;
+  const char * end = iData + iSize;
+  while (position < end)
+  {
+    const char * terminator = (const char *)memchr(position, '\0', end - position);
+    if (terminator == NULL)
+    {
+      //the last argument is not NULL terminated
+      const std::string last(position, end);
+      iHandler.onArgument(last.c_str(), last.size());
+      break;
+    }
+    iHandler.onArgument(position, (size_t)(terminator - position));
+    position = terminator + 1;
+  }
+
+  return true;
+}
+
+}; //namespace libargvcodec
@@ -0,0 +1,147 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "ParallelFor.h"
+
+#include <thread>
+#include <mutex>
+#include <deque>
+#include <vector>
+
+namespace libargvcodec
+{
+
+struct WorkQueue
+{
+  std::mutex mutex;
+  std::deque<size_t> tasks;
+};
+
+static bool popTask(WorkQueue & iQueue, bool iFront, size_t & oTask)
+{
+  std::lock_guard<std::mutex> lock(iQueue.mutex);
+  if (iQueue.tasks.empty())
+    return false;
+  if (iFront)
+  {
+    oTask = iQueue.tasks.front();
+    iQueue.tasks.pop_front();
+  }
+  else
+  {
+    oTask = iQueue.tasks.back();
+    iQueue.tasks.pop_back();
+  }
+  return true;
+}
+
+static void runWorker(std::vector<WorkQueue> * iQueues, int iThread, ParallelTask * iTask)
+{
+  std::vector<WorkQueue> & queues = *iQueues;
+  const int numThreads = (int)queues.size();
+
+  size_t task = 0;
+  for(;;)
+  {
+    //own tasks first, in order
+    if (popTask(queues[iThread], true, task))
+    {
+      iTask->run(task, iThread);
+      continue;
+    }
+
+    //steal from the end of the other queues.
+    //no task is added once started, so all queues are empty when nothing can be stolen.
+    bool stolen = false;
+    for(int i=1; i<numThreads && !stolen; i++)
+    {
+      stolen = popTask(queues[(iThread + i) % numThreads], false, task);
+    }
+    if (!stolen)
+      return;
+    iTask->run(task, iThread);
+  }
+}
+
+int getDefaultNumThreads()
+{
+  unsigned int numThreads = std::thread::hardware_concurrency();
+  if (numThreads == 0)
+    return 1;
+  return (int)numThreads;
+}
+
+int getNumThreads(size_t iNumTasks, int iNumThreads)
+{
+  int numThreads = (iNumThreads > 0 ? iNumThreads : getDefaultNumThreads());
+  if ((size_t)numThreads > iNumTasks)
+    numThreads = (int)iNumTasks;
+  if (numThreads < 1)
+    numThreads = 1;
+  return numThreads;
+}
+
+void parallelFor(size_t iNumTasks, int iNumThreads, ParallelTask & iTask)
+{
+  const int numThreads = getNumThreads(iNumTasks, iNumThreads);
+
+  //no need for threads
+  if (numThreads == 1)
+  {
+    for(size_t i=0; i<iNumTasks; i++)
+      iTask.run(i, 0);
+    return;
+  }
+
+  //distribute contiguous ranges of tasks
+  std::vector<WorkQueue> queues(numThreads);
+  for(int i=0; i<numThreads; i++)
+  {
+    size_t first = (iNumTasks * i) / numThreads;
+    size_t last  = (iNumTasks * (i+1)) / numThreads;
+    for(size_t j=first; j<last; j++)
+      queues[i].tasks.push_back(j);
+  }
+
+  //the calling thread is worker 0
+  std::vector<std::thread> threads;
+  for(int i=1; i<numThreads; i++)
+  {
+    try
+    {
+      threads.push_back(std::thread(runWorker, &queues, i, &iTask));
+    }
+    catch(...)
+    {
+      //the tasks of this worker will be stolen by the running workers
+      break;
+    }
+  }
+  runWorker(&queues, 0, &iTask);
+
+  for(size_t i=0; i<threads.size(); i++)
+    threads[i].join();
+}
+
+}; //namespace libargvcodec
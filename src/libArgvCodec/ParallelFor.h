@@ -0,0 +1,65 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef PARALLELFOR_H
+#define PARALLELFOR_H
+
+#include <cstddef> //for size_t
+
+namespace libargvcodec
+{
+
+  /// <summary>A task which is executed in parallel by parallelFor().</summary>
+  class ParallelTask
+  {
+  public:
+    virtual ~ParallelTask() {}
+
+    /// <summary>Executes a single task.</summary>
+    /// <param name="iTask">The index of the task.</param>
+    /// <param name="iThread">The index of the thread which executes the task. Always smaller than the number of threads.</param>
+    virtual void run(size_t iTask, int iThread) = 0;
+  };
+
+  /// <summary>Returns the number of threads to use when the user does not specify one.</summary>
+  int getDefaultNumThreads();
+
+  /// <summary>Returns the number of threads which will be used by parallelFor() for the given number of tasks.</summary>
+  /// <param name="iNumTasks">The number of tasks.</param>
+  /// <param name="iNumThreads">The requested number of threads. Use 0 for the default number of threads.</param>
+  int getNumThreads(size_t iNumTasks, int iNumThreads);
+
+  /// <summary>
+  /// Executes tasks [0, iNumTasks) on multiple threads and waits for all tasks to complete.
+  /// Each thread starts with a contiguous range of tasks and steals tasks from the other threads when done.
+  /// The calling thread is also used for executing tasks.
+  /// </summary>
+  /// <param name="iNumTasks">The number of tasks.</param>
+  /// <param name="iNumThreads">The requested number of threads. Use 0 for the default number of threads.</param>
+  /// <param name="iTask">The task to execute.</param>
+  void parallelFor(size_t iNumTasks, int iNumThreads, ParallelTask & iTask);
+
+}; //namespace libargvcodec
+
+#endif //PARALLELFOR_H
@@ -0,0 +1,232 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "libargvcodec/ParallelSpawner.h"
+
+#ifdef _WIN32
+#   include "libargvcodec/CreateProcessArgumentCodec.h"
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN // Exclude rarely-used stuff from Windows headers
+#   endif /* WIN32_LEAN_AND_MEAN */
+#   include <Windows.h>
+#else
+#   include <spawn.h>
+#   include <sys/wait.h>
+#   include <errno.h>
+#   include <unistd.h>
+extern char ** environ;
+#endif
+
+#include <deque>
+
+namespace libargvcodec
+{
+
+#ifdef _WIN32
+
+struct RunningProcess
+{
+  HANDLE handle;
+  size_t index;
+};
+
+static void waitForProcess(std::deque<RunningProcess> & ioRunning, ParallelSpawner::ExitCodeList & oExitCodes)
+{
+  //wait for any process to exit
+  HANDLE handles[MAXIMUM_WAIT_OBJECTS];
+  for(size_t i=0; i<ioRunning.size(); i++)
+    handles[i] = ioRunning[i].handle;
+  DWORD result = WaitForMultipleObjects((DWORD)ioRunning.size(), handles, FALSE, INFINITE);
+  size_t offset = 0;
+  if (result >= WAIT_OBJECT_0 && result < WAIT_OBJECT_0 + ioRunning.size())
+    offset = result - WAIT_OBJECT_0;
+  else
+    WaitForSingleObject(handles[0], INFINITE);
+
+  RunningProcess p = ioRunning[offset];
+  DWORD exitCode = 0;
+  if (GetExitCodeProcess(p.handle, &exitCode))
+    oExitCodes[p.index] = (int)exitCode;
+  CloseHandle(p.handle);
+  ioRunning.erase(ioRunning.begin() + offset);
+}
+
+bool ParallelSpawner::run(const ArgumentListVector & iProcesses, int iMaxProcesses, ExitCodeList & oExitCodes)
+{
+  oExitCodes.assign(iProcesses.size(), -1);
+  if (iMaxProcesses < 1)
+    return false;
+  if (iMaxProcesses > MAXIMUM_WAIT_OBJECTS)
+    iMaxProcesses = MAXIMUM_WAIT_OBJECTS;
+
+  CreateProcessArgumentCodec codec;
+  std::deque<RunningProcess> running;
+  bool success = true;
+  for(size_t i=0; i<iProcesses.size() && success; i++)
+  {
+    if ((int)running.size() >= iMaxProcesses)
+      waitForProcess(running, oExitCodes);
+
+    const ArgumentList & arguments = iProcesses[i];
+    if (arguments.getArgc() < 1)
+    {
+      success = false;
+      break;
+    }
+
+    //the command line also contains the executable
+    std::string cmdLine = codec.encodeArgument(arguments.getArgument(0));
+    std::string args = codec.encodeCommandLine(arguments);
+    if (!args.empty())
+      cmdLine.append(1, ' ').append(args);
+
+    std::vector<char> buffer(cmdLine.begin(), cmdLine.end());
+    buffer.push_back('\0');
+
+    STARTUPINFOA si;
+    ZeroMemory(&si, sizeof(si));
+    si.cb = sizeof(si);
+    PROCESS_INFORMATION pi;
+    ZeroMemory(&pi, sizeof(pi));
+    if (!CreateProcessA(NULL, &buffer[0], NULL, NULL, FALSE, 0, NULL, NULL, &si, &pi))
+    {
+      success = false;
+      break;
+    }
+    CloseHandle(pi.hThread);
+
+    RunningProcess p;
+    p.handle = pi.hProcess;
+    p.index = i;
+    running.push_back(p);
+  }
+
+  while(!running.empty())
+    waitForProcess(running, oExitCodes);
+
+  return success;
+}
+
+#else
+
+struct RunningProcess
+{
+  pid_t pid;
+  size_t index;
+};
+
+static int getExitCode(int iStatus)
+{
+  if (WIFEXITED(iStatus))
+    return WEXITSTATUS(iStatus);
+  return -1;
+}
+
+static bool isRunning(const std::deque<RunningProcess> & iRunning, pid_t iPid)
+{
+  for(size_t i=0; i<iRunning.size(); i++)
+  {
+    if (iRunning[i].pid == iPid)
+      return true;
+  }
+  return false;
+}
+
+static void waitForProcess(std::deque<RunningProcess> & ioRunning, ParallelSpawner::ExitCodeList & oExitCodes)
+{
+  //waitpid(-1) would also reap the children of the application.
+  //Check all processes without blocking, then wait for any child to exit without reaping it
+  //and check again until one of the processes has exited.
+  while(true)
+  {
+    for(size_t i=0; i<ioRunning.size(); i++)
+    {
+      int status = 0;
+      pid_t pid = waitpid(ioRunning[i].pid, &status, WNOHANG);
+      if (pid == ioRunning[i].pid || (pid < 0 && errno != EINTR))
+      {
+        oExitCodes[ioRunning[i].index] = (pid < 0 ? -1 : getExitCode(status));
+        ioRunning.erase(ioRunning.begin() + i);
+        return;
+      }
+    }
+
+    siginfo_t info;
+    info.si_pid = 0;
+    int result = waitid(P_ALL, 0, &info, WEXITED | WNOWAIT);
+    if (result < 0 && errno == EINTR)
+      continue;
+    if (result == 0 && isRunning(ioRunning, info.si_pid))
+      continue; //reaped by the next check
+
+    //an exited child of the application stays waitable and would be returned again.
+    //poll the processes instead.
+    usleep(1000);
+  }
+}
+
+bool ParallelSpawner::run(const ArgumentListVector & iProcesses, int iMaxProcesses, ExitCodeList & oExitCodes)
+{
+  oExitCodes.assign(iProcesses.size(), -1);
+  if (iMaxProcesses < 1)
+    return false;
+
+  std::deque<RunningProcess> running;
+  bool success = true;
+  for(size_t i=0; i<iProcesses.size() && success; i++)
+  {
+    if ((int)running.size() >= iMaxProcesses)
+      waitForProcess(running, oExitCodes);
+
+    const ArgumentList & arguments = iProcesses[i];
+    if (arguments.getArgc() < 1)
+    {
+      success = false;
+      break;
+    }
+
+    //the argv array of an ArgumentList is NULL terminated
+    char ** argv = arguments.getArgv();
+    pid_t pid = 0;
+    if (posix_spawnp(&pid, argv[0], NULL, NULL, argv, environ) != 0)
+    {
+      success = false;
+      break;
+    }
+
+    RunningProcess p;
+    p.pid = pid;
+    p.index = i;
+    running.push_back(p);
+  }
+
+  while(!running.empty())
+    waitForProcess(running, oExitCodes);
+
+  return success;
+}
+
+#endif //_WIN32
+
+}; //namespace libargvcodec
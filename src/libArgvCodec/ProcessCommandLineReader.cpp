@@ -0,0 +1,179 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "libargvcodec/ProcessCommandLineReader.h"
+#include "libargvcodec/NulSeparatedArgumentCodec.h"
+#include "StatsScope.h"
+
+#include <algorithm> //for std::sort()
+#include <cstdio>    //for snprintf()
+
+#ifdef __linux__
+#   include <sys/types.h>
+#   include <dirent.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#   include <errno.h>
+#endif
+
+namespace libargvcodec
+{
+
+ProcessCommandLineReader::ProcessCommandLineReader() :
+  mBuffer(DEFAULT_BUFFER_SIZE)
+{
+}
+
+ProcessCommandLineReader::~ProcessCommandLineReader()
+{
+}
+
+#ifdef __linux__
+
+bool ProcessCommandLineReader::isSupported()
+{
+  return true;
+}
+
+bool ProcessCommandLineReader::readCommandLine(int iPid, size_t & oSize)
+{
+  oSize = 0;
+
+  char path[64];
+  snprintf(path, sizeof(path), "/proc/%d/cmdline", iPid);
+
+  int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return false;
+
+  //read until the end of the file, growing the buffer for huge argument vectors
+  bool success = true;
+  while (true)
+  {
+    if (oSize == mBuffer.size())
+      mBuffer.resize(mBuffer.size() * 2);
+
+    ssize_t count = ::read(fd, &mBuffer[oSize], mBuffer.size() - oSize);
+    if (count < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      success = false;
+      break;
+    }
+    if (count == 0)
+      break; //end of file
+    oSize += (size_t)count;
+  }
+
+  ::close(fd);
+  return success;
+}
+
+bool ProcessCommandLineReader::read(int iPid, ArgumentList & oArguments)
+{
+  LIBARGVCODEC_STATS_SCOPE();
+  size_t size = 0;
+  if (!readCommandLine(iPid, size))
+    return false;
+
+  NulSeparatedArgumentCodec codec;
+  return codec.decodeArgumentVector(&mBuffer[0], size, oArguments);
+}
+
+bool ProcessCommandLineReader::readAll(std::vector<int> & oPids, DecodedCommandLines & oCommandLines)
+{
+  LIBARGVCODEC_STATS_SCOPE();
+  oPids.clear();
+  oCommandLines.clear();
+
+  //list the processes
+  DIR * dir = opendir("/proc");
+  if (dir == NULL)
+    return false;
+
+  std::vector<int> pids;
+  struct dirent * entry = NULL;
+  while ((entry = readdir(dir)) != NULL)
+  {
+    const char * name = entry->d_name;
+    int pid = 0;
+    bool numeric = (*name != '\0');
+    for(; *name != '\0' && numeric; name++)
+    {
+      numeric = (*name >= '0' && *name <= '9');
+      pid = pid*10 + (*name - '0');
+    }
+    if (numeric)
+      pids.push_back(pid);
+  }
+  closedir(dir);
+
+  std::sort(pids.begin(), pids.end());
+
+  //decode the arguments of all processes in the same instance
+  NulSeparatedArgumentCodec codec;
+  oPids.reserve(pids.size());
+  for(size_t i=0; i<pids.size(); i++)
+  {
+    size_t size = 0;
+    if (!readCommandLine(pids[i], size))
+      continue; //the process has terminated
+
+    codec.decodeArgumentVector(&mBuffer[0], size, oCommandLines);
+    oCommandLines.endCommandLine();
+    oPids.push_back(pids[i]);
+  }
+
+  return true;
+}
+
+#else
+
+bool ProcessCommandLineReader::isSupported()
+{
+  return false;
+}
+
+bool ProcessCommandLineReader::readCommandLine(int /*iPid*/, size_t & oSize)
+{
+  oSize = 0;
+  return false;
+}
+
+bool ProcessCommandLineReader::read(int /*iPid*/, ArgumentList & /*oArguments*/)
+{
+  return false;
+}
+
+bool ProcessCommandLineReader::readAll(std::vector<int> & oPids, DecodedCommandLines & oCommandLines)
+{
+  oPids.clear();
+  oCommandLines.clear();
+  return false;
+}
+
+#endif
+
+}; //namespace libargvcodec
@@ -0,0 +1,139 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "libargvcodec/ResponseFileEncoder.h"
+
+#include <cstdio> //for fopen()
+
+#ifndef _WIN32
+#include <unistd.h> //for sysconf()
+#endif
+
+namespace libargvcodec
+{
+
+ResponseFileEncoder::ResponseFileEncoder(const IArgumentEncoder & iEncoder) :
+  mEncoder(iEncoder)
+{
+}
+
+ResponseFileEncoder::~ResponseFileEncoder()
+{
+}
+
+size_t ResponseFileEncoder::getSystemMaxLength()
+{
+#ifdef _WIN32
+  return CREATE_PROCESS_MAX_LENGTH;
+#else
+  long argMax = sysconf(_SC_ARG_MAX);
+  if (argMax <= 0)
+    return 4096; //minimum value of _POSIX_ARG_MAX
+  return (size_t)argMax;
+#endif
+}
+
+static bool writeFile(const char * iPath, const std::string & iContent)
+{
+  FILE * f = fopen(iPath, "wb");
+  if (f == NULL)
+    return false;
+
+  //the content is already buffered. Write it with a single system call.
+  setvbuf(f, NULL, _IONBF, 0);
+  size_t written = fwrite(iContent.data(), 1, iContent.size(), f);
+  bool closed = (fclose(f) == 0);
+
+  return (written == iContent.size() && closed);
+}
+
+bool ResponseFileEncoder::encodeCommandLine(const ArgumentList & iArguments, size_t iMaxLength, const char * iResponseFilePath, std::string & oCommandLine, std::string & oResponseFilePath)
+{
+  oCommandLine.clear();
+  oResponseFilePath.clear();
+
+  if (iResponseFilePath == NULL || iResponseFilePath[0] == '\0')
+    return false;
+
+  //length required to reference the response file in the command line
+  const std::string responseFileArgument = mEncoder.encodeArgument((std::string("@") + iResponseFilePath).c_str());
+  const size_t reservedLength = responseFileArgument.size() + 1; //including a separator
+
+  //keep arguments in the command line while they fit.
+  //remember the last position where the response file argument would also fit.
+  int firstOverflowIndex = 1;
+  size_t overflowCmdLineLength = 0;
+  int i = 1; //skip first element since it refers to the actual .exe that was launched
+  for(; i<iArguments.getArgc(); i++)
+  {
+    const std::string arg = mEncoder.encodeArgument(iArguments.getArgument(i));
+    const size_t separatorLength = (oCommandLine.empty() ? 0 : 1);
+    if (oCommandLine.size() + separatorLength + arg.size() > iMaxLength)
+      break;
+
+    if (!oCommandLine.empty())
+      oCommandLine.append(1, ' ');
+    oCommandLine.append(arg);
+
+    if (oCommandLine.size() + reservedLength <= iMaxLength)
+    {
+      firstOverflowIndex = i+1;
+      overflowCmdLineLength = oCommandLine.size();
+    }
+  }
+
+  //all arguments fit in the command line?
+  if (i == iArguments.getArgc())
+    return true;
+
+  //move the remaining arguments to the response file
+  oCommandLine.resize(overflowCmdLineLength);
+  if (oCommandLine.size() + (oCommandLine.empty() ? 0 : 1) + responseFileArgument.size() > iMaxLength)
+  {
+    oCommandLine.clear();
+    return false;
+  }
+
+  std::string content;
+  for(int j=firstOverflowIndex; j<iArguments.getArgc(); j++)
+  {
+    content.append(mEncoder.encodeArgument(iArguments.getArgument(j)));
+    content.append(1, '\n');
+  }
+
+  if (!writeFile(iResponseFilePath, content))
+  {
+    oCommandLine.clear();
+    return false;
+  }
+
+  if (!oCommandLine.empty())
+    oCommandLine.append(1, ' ');
+  oCommandLine.append(responseFileArgument);
+  oResponseFilePath = iResponseFilePath;
+
+  return true;
+}
+
+}; //namespace libargvcodec
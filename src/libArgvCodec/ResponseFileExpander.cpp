@@ -0,0 +1,153 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "ResponseFileExpander.h"
+#include "MemoryMappedFile.h"
+
+#include <cstdlib> //for realpath(), _fullpath(), free()
+#include <algorithm> //for std::find()
+
+namespace libargvcodec
+{
+
+static std::string getCanonicalPath(const char * iPath)
+{
+  std::string path = iPath;
+#ifdef _WIN32
+  char * canonical = _fullpath(NULL, iPath, 0);
+#else
+  char * canonical = realpath(iPath, NULL);
+#endif
+  if (canonical != NULL)
+  {
+    path = canonical;
+    free(canonical);
+  }
+  return path;
+}
+
+ResponseFileExpander::ResponseFileExpander() :
+  mTarget(NULL)
+{
+}
+
+ResponseFileExpander::~ResponseFileExpander()
+{
+}
+
+bool ResponseFileExpander::expand(IArgumentStreamDecoder & iDecoder, ArgumentList & ioArguments)
+{
+  mFiles.clear();
+
+  ArgumentList::StringList arguments;
+  arguments.reserve(ioArguments.getArgc());
+  for(int i=0; i<ioArguments.getArgc(); i++)
+  {
+    const std::string arg = ioArguments.getArgument(i);
+
+    //skip first element since it refers to the actual .exe that was launched
+    if (i == 0)
+      arguments.push_back(arg);
+    else if (!expandArgument(iDecoder, arg, arguments))
+      return false;
+  }
+
+  //the list is rebuilt once
+  ioArguments.init(arguments);
+  return true;
+}
+
+void ResponseFileExpander::onArgument(const char * iValue, size_t iLength)
+{
+  if (mTarget != NULL)
+    mTarget->push_back(std::string(iValue, iLength));
+}
+
+bool ResponseFileExpander::expandArgument(IArgumentStreamDecoder & iDecoder, const std::string & iArgument, ArgumentList::StringList & oArguments)
+{
+  if (iArgument.size() < 2 || iArgument[0] != '@')
+  {
+    oArguments.push_back(iArgument);
+    return true;
+  }
+
+  const std::string path = getCanonicalPath(iArgument.c_str() + 1);
+  if (std::find(mFiles.begin(), mFiles.end(), path) != mFiles.end())
+    return false; //the file includes itself
+
+  ArgumentList::StringList fileArguments;
+  if (!decodeFile(iDecoder, path.c_str(), fileArguments))
+    return false;
+
+  //expand nested response files
+  mFiles.push_back(path);
+  for(size_t i=0; i<fileArguments.size(); i++)
+  {
+    if (!expandArgument(iDecoder, fileArguments[i], oArguments))
+      return false;
+  }
+  mFiles.pop_back();
+
+  return true;
+}
+
+bool ResponseFileExpander::decodeFile(IArgumentStreamDecoder & iDecoder, const char * iPath, ArgumentList::StringList & oArguments)
+{
+  MemoryMappedFile file;
+  if (!file.open(iPath))
+    return false;
+
+  const char * data = file.getData();
+  const char * end = data + file.getSize();
+
+  //skip UTF-8 byte order mark
+  if (end - data >= 3 && data[0] == '\xEF' && data[1] == '\xBB' && data[2] == '\xBF')
+    data += 3;
+
+  mTarget = &oArguments;
+  iDecoder.reset();
+
+  //new lines are argument separators in response files.
+  //feed each line to the decoder and replace new lines by a space.
+  bool success = true;
+  while(success && data < end)
+  {
+    const char * lineEnd = data;
+    while(lineEnd < end && *lineEnd != '\n' && *lineEnd != '\r')
+      lineEnd++;
+
+    success = iDecoder.feed(data, lineEnd - data);
+    if (lineEnd == end)
+      break;
+    success = success && iDecoder.feed(" ", 1);
+
+    data = lineEnd + 1;
+  }
+  success = iDecoder.finish() && success;
+
+  mTarget = NULL;
+  return success;
+}
+
+}; //namespace libargvcodec
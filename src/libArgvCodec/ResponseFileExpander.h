@@ -0,0 +1,63 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef RESPONSEFILEEXPANDER_H
+#define RESPONSEFILEEXPANDER_H
+
+#include "libargvcodec/ArgumentList.h"
+#include "libargvcodec/IArgumentStreamDecoder.h"
+
+namespace libargvcodec
+{
+
+  /// <summary>
+  /// Replaces @file arguments by the arguments decoded from the content of the file.
+  /// The files are mapped in memory and decoded with a stream decoder without being copied.
+  /// </summary>
+  class ResponseFileExpander : public IArgumentHandler
+  {
+  public:
+    ResponseFileExpander();
+    virtual ~ResponseFileExpander();
+
+    /// <summary>Expands all response files of the given list except the first argument.</summary>
+    /// <param name="iDecoder">The stream decoder of the response files. The decoder's handler must be this instance.</param>
+    /// <param name="ioArguments">The list of arguments to expand.</param>
+    /// <returns>Returns true if all response files are expanded. Returns false if a file can not be read or if a file includes itself.</returns>
+    bool expand(IArgumentStreamDecoder & iDecoder, ArgumentList & ioArguments);
+
+    //IArgumentHandler
+    virtual void onArgument(const char * iValue, size_t iLength);
+
+  private:
+    bool expandArgument(IArgumentStreamDecoder & iDecoder, const std::string & iArgument, ArgumentList::StringList & oArguments);
+    bool decodeFile(IArgumentStreamDecoder & iDecoder, const char * iPath, ArgumentList::StringList & oArguments);
+
+    ArgumentList::StringList * mTarget;
+    ArgumentList::StringList mFiles; //the files being expanded, used for detecting cycles
+  };
+
+}; //namespace libargvcodec
+
+#endif //RESPONSEFILEEXPANDER_H
@@ -0,0 +1,81 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "SharedDecoder.h"
+#include "TraceScope.h"
+#include "rapidassist/process.h"
+
+#include <cstring> //for strlen()
+
+namespace libargvcodec
+{
+
+DecodedCommandLinesPtr decodeShared(const StreamArgumentDecoder & iDecoder, DecodedCommandLineCache * iCache, const char * iValue)
+{
+  if (iValue == NULL)
+    return DecodedCommandLinesPtr();
+
+  DecodedCommandLinesPtr decoded;
+  if (iCache != NULL && iCache->lookup(iDecoder, iValue, decoded))
+    return decoded;
+
+  LIBARGVCODEC_TRACE_PHASE(accumulateTimer, PHASE_ACCUMULATE);
+  LIBARGVCODEC_TRACE_BEGIN(accumulateTimer);
+  const size_t length = strlen(iValue);
+  std::shared_ptr<DecodedCommandLines> commandLines(new DecodedCommandLines());
+  IArgumentStreamDecoder * decoder = iDecoder.createStreamDecoder(*commandLines);
+  decoder->feed(iValue, length);
+  decoder->finish();
+  delete decoder;
+  commandLines->endCommandLine();
+  LIBARGVCODEC_TRACE_END(accumulateTimer, commandLines->getArgc(0), length);
+  decoded = commandLines;
+
+  if (iCache != NULL)
+    iCache->insert(iDecoder, iValue, decoded);
+  return decoded;
+}
+
+ArgumentList toArgumentList(const DecodedCommandLinesPtr & iDecoded)
+{
+  ArgumentList arglist;
+  if (iDecoded == NULL)
+    return arglist;
+
+  const size_t argc = iDecoded->getArgc(0);
+  ArgumentList::StringList args;
+  args.reserve(argc + 1);
+
+  //insert local .exe path
+  args.push_back(ra::process::getCurrentProcessPath());
+  for(size_t i=0; i<argc; i++)
+  {
+    args.push_back(std::string(iDecoded->getArgument(0, i), iDecoded->getArgumentLength(0, i)));
+  }
+
+  arglist.init(args);
+  return arglist;
+}
+
+}; //namespace libargvcodec
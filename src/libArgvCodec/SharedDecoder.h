@@ -0,0 +1,50 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef SHAREDDECODER_H
+#define SHAREDDECODER_H
+
+#include "libargvcodec/DecodedCommandLines.h"
+#include "libargvcodec/DecodedCommandLineCache.h"
+#include "libargvcodec/ArgumentList.h"
+#include "libargvcodec/StreamArgumentDecoder.h"
+
+namespace libargvcodec
+{
+
+  /// <summary>Decodes a command line into a shared snapshot with a stream decoder of the given decoder.</summary>
+  /// <param name="iDecoder">The decoder which creates the stream decoder. Used as the dialect of the cache entries.</param>
+  /// <param name="iCache">The cache of decoded command lines. Use NULL to always decode the command line.</param>
+  /// <param name="iValue">The command line to decode.</param>
+  /// <returns>Returns the decoded arguments of the command line. Returns a NULL pointer if iValue is NULL.</returns>
+  DecodedCommandLinesPtr decodeShared(const StreamArgumentDecoder & iDecoder, DecodedCommandLineCache * iCache, const char * iValue);
+
+  /// <summary>Builds the argument list of the first command line of a snapshot. The current executable path is inserted as the first argument.</summary>
+  /// <param name="iDecoded">The decoded arguments.</param>
+  /// <returns>Returns the argument list. Returns an empty list if iDecoded is a NULL pointer.</returns>
+  ArgumentList toArgumentList(const DecodedCommandLinesPtr & iDecoded);
+
+}; //namespace libargvcodec
+
+#endif //SHAREDDECODER_H
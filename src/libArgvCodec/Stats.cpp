@@ -0,0 +1,147 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "StatsScope.h"
+
+namespace libargvcodec
+{
+namespace stats
+{
+
+#ifdef LIBARGVCODEC_STATS
+
+/// <summary>Counters of a thread. Must be trivially constructible since it is used by the allocation functions.</summary>
+struct ThreadCounters
+{
+  int depth;
+  Counters total;
+  Counters callStart;
+  Counters lastCall;
+};
+
+static thread_local ThreadCounters gThreadCounters;
+
+ApiScope::ApiScope()
+{
+  ThreadCounters & counters = gThreadCounters;
+  if (counters.depth++ == 0)
+  {
+    counters.total.calls++;
+    counters.callStart = counters.total;
+  }
+}
+
+ApiScope::~ApiScope()
+{
+  ThreadCounters & counters = gThreadCounters;
+  if (--counters.depth == 0)
+  {
+    counters.lastCall.calls = 1;
+    counters.lastCall.allocations = counters.total.allocations - counters.callStart.allocations;
+    counters.lastCall.bytes = counters.total.bytes - counters.callStart.bytes;
+    counters.lastCall.argvRebuilds = counters.total.argvRebuilds - counters.callStart.argvRebuilds;
+  }
+}
+
+void onAllocation(size_t iSize)
+{
+  ThreadCounters & counters = gThreadCounters;
+  if (counters.depth > 0)
+  {
+    counters.total.allocations++;
+    counters.total.bytes += iSize;
+  }
+}
+
+void onArgvRebuild()
+{
+  gThreadCounters.total.argvRebuilds++;
+}
+
+bool isEnabled()
+{
+  return true;
+}
+
+void getCounters(Counters & oCounters)
+{
+  oCounters = gThreadCounters.total;
+}
+
+void getLastCallCounters(Counters & oCounters)
+{
+  oCounters = gThreadCounters.lastCall;
+}
+
+void resetCounters()
+{
+  ThreadCounters & counters = gThreadCounters;
+  const Counters zero = {0, 0, 0, 0};
+  counters.total = zero;
+  counters.callStart = zero;
+  counters.lastCall = zero;
+}
+
+#else
+
+ApiScope::ApiScope()
+{
+}
+
+ApiScope::~ApiScope()
+{
+}
+
+void onAllocation(size_t /*iSize*/)
+{
+}
+
+void onArgvRebuild()
+{
+}
+
+bool isEnabled()
+{
+  return false;
+}
+
+void getCounters(Counters & oCounters)
+{
+  const Counters zero = {0, 0, 0, 0};
+  oCounters = zero;
+}
+
+void getLastCallCounters(Counters & oCounters)
+{
+  getCounters(oCounters);
+}
+
+void resetCounters()
+{
+}
+
+#endif //LIBARGVCODEC_STATS
+
+}; //namespace stats
+}; //namespace libargvcodec
@@ -0,0 +1,87 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "StatsScope.h"
+
+#ifdef LIBARGVCODEC_STATS
+
+//Replacement of the global allocation functions for counting the allocations of the library.
+//The functions are in their own translation unit: a program which already replaces the
+//allocation functions does not link this object file from the static library.
+
+#include <stdlib.h>
+#include <new>
+
+static void * countedAlloc(size_t iSize)
+{
+  libargvcodec::stats::onAllocation(iSize);
+  void * p = malloc(iSize == 0 ? 1 : iSize);
+  if (p == NULL)
+    throw std::bad_alloc();
+  return p;
+}
+
+void * operator new(size_t iSize)
+{
+  return countedAlloc(iSize);
+}
+
+void * operator new[](size_t iSize)
+{
+  return countedAlloc(iSize);
+}
+
+void * operator new(size_t iSize, const std::nothrow_t &) noexcept
+{
+  libargvcodec::stats::onAllocation(iSize);
+  return malloc(iSize == 0 ? 1 : iSize);
+}
+
+void * operator new[](size_t iSize, const std::nothrow_t &) noexcept
+{
+  libargvcodec::stats::onAllocation(iSize);
+  return malloc(iSize == 0 ? 1 : iSize);
+}
+
+void operator delete(void * p) noexcept
+{
+  free(p);
+}
+
+void operator delete[](void * p) noexcept
+{
+  free(p);
+}
+
+void operator delete(void * p, const std::nothrow_t &) noexcept
+{
+  free(p);
+}
+
+void operator delete[](void * p, const std::nothrow_t &) noexcept
+{
+  free(p);
+}
+
+#endif //LIBARGVCODEC_STATS
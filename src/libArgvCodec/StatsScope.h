@@ -0,0 +1,61 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef STATSSCOPE_H
+#define STATSSCOPE_H
+
+#include "libargvcodec/Stats.h"
+
+namespace libargvcodec
+{
+  namespace stats
+  {
+
+    /// <summary>Counts the allocations of the current thread while a public method is running.</summary>
+    /// <remarks>Scopes can be nested. Only the outermost scope counts as a call.</remarks>
+    class ApiScope
+    {
+    public:
+      ApiScope();
+      ~ApiScope();
+    };
+
+    /// <summary>Called by the global allocation functions of the library.</summary>
+    void onAllocation(size_t iSize);
+
+    /// <summary>Called when the argv array of an ArgumentList is rebuilt.</summary>
+    void onArgvRebuild();
+
+  }; //namespace stats
+}; //namespace libargvcodec
+
+#ifdef LIBARGVCODEC_STATS
+#   define LIBARGVCODEC_STATS_SCOPE() libargvcodec::stats::ApiScope libargvcodec_stats_scope
+#   define LIBARGVCODEC_STATS_ARGV_REBUILD() libargvcodec::stats::onArgvRebuild()
+#else
+#   define LIBARGVCODEC_STATS_SCOPE()
+#   define LIBARGVCODEC_STATS_ARGV_REBUILD()
+#endif
+
+#endif //STATSSCOPE_H
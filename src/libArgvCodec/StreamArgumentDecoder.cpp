@@ -0,0 +1,75 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "libargvcodec/StreamArgumentDecoder.h"
+#include "ResponseFileExpander.h"
+#include "BatchDecoder.h"
+#include "SharedDecoder.h"
+#include "StatsScope.h"
+
+namespace libargvcodec
+{
+
+StreamArgumentDecoder::StreamArgumentDecoder() :
+  mDecodeCache(NULL)
+{
+}
+
+StreamArgumentDecoder::~StreamArgumentDecoder()
+{
+}
+
+bool StreamArgumentDecoder::expandResponseFiles(ArgumentList & ioArguments) const
+{
+  LIBARGVCODEC_STATS_SCOPE();
+  ResponseFileExpander expander;
+  IArgumentStreamDecoder * decoder = createStreamDecoder(expander);
+  bool success = expander.expand(*decoder, ioArguments);
+  delete decoder;
+  return success;
+}
+
+bool StreamArgumentDecoder::decodeBatch(const char * const * iCommandLines, size_t iCount, DecodedCommandLines & oResult, int iNumThreads) const
+{
+  LIBARGVCODEC_STATS_SCOPE();
+  return libargvcodec::decodeBatch(*this, iCommandLines, iCount, iNumThreads, oResult);
+}
+
+DecodedCommandLinesPtr StreamArgumentDecoder::decodeShared(const char * iValue) const
+{
+  LIBARGVCODEC_STATS_SCOPE();
+  return libargvcodec::decodeShared(*this, mDecodeCache, iValue);
+}
+
+void StreamArgumentDecoder::setDecodeCache(DecodedCommandLineCache * iCache)
+{
+  mDecodeCache = iCache;
+}
+
+DecodedCommandLineCache * StreamArgumentDecoder::getDecodeCache() const
+{
+  return mDecodeCache;
+}
+
+}; //namespace libargvcodec
@@ -0,0 +1,48 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef TERMINALARGUMENTCODECCORE_H
+#define TERMINALARGUMENTCODECCORE_H
+
+#include "ArgumentClassifier.h"
+#include <string>
+
+namespace libargvcodec
+{
+
+  /// <summary>Encoding implementation of Linux terminal arguments which is shared with the multi-dialect encoder.</summary>
+  class TerminalArgumentCodecCore
+  {
+  public:
+    /// <summary>Encodes an argument which is already classified and appends the result to the given string.</summary>
+    /// <param name="iValue">The argument to encode. Can be NULL if the argument is classified as empty.</param>
+    /// <param name="iClass">The classification of the argument.</param>
+    /// <param name="ioOutput">The string which receives the encoded argument. Either a std::string or a ResourceString.</param>
+    template <typename String>
+    static void appendEncodedArgument(const char * iValue, const ArgumentClass & iClass, String & ioOutput);
+  };
+
+}; //namespace libargvcodec
+
+#endif //TERMINALARGUMENTCODECCORE_H
@@ -0,0 +1,223 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "libargvcodec/TerminalStreamDecoder.h"
+
+namespace libargvcodec
+{
+
+enum TerminalDecoderState
+{
+  STATE_NORMAL,
+  STATE_NORMAL_BACKSLASH,         //after a \ character outside a string
+  STATE_DOUBLE_QUOTES,
+  STATE_DOUBLE_QUOTES_BACKSLASH,  //after a \ character inside a double-quotes string
+  STATE_SINGLE_QUOTE,
+  STATE_SINGLE_QUOTE_BACKSLASH,   //after a \ character inside a single-quote string
+};
+
+static inline bool isTerminalSeparator(const char c)
+{
+  return (c == '\0' || c == ' ' || c == '\t');
+}
+
+static inline bool isTerminalSpecialShellCharacter(const char c)
+{
+  return (c == '$' || c == '`');
+}
+
+TerminalStreamDecoder::TerminalStreamDecoder(IArgumentHandler & iHandler, IMemoryResource * iResource) :
+  mHandler(iHandler),
+  mAccumulator(ResourceString::allocator_type(iResource))
+{
+  reset();
+}
+
+TerminalStreamDecoder::~TerminalStreamDecoder()
+{
+}
+
+void TerminalStreamDecoder::reset()
+{
+  mAccumulator.clear();
+  mState = STATE_NORMAL;
+  mIsStringEmpty = false;
+  mIsEmptyArgument = false;
+}
+
+bool TerminalStreamDecoder::feed(const char * iBuffer, size_t iLength)
+{
+  if (iBuffer == NULL && iLength > 0)
+    return false;
+
+  for(size_t i=0; i<iLength; i++)
+  {
+    process(iBuffer[i]);
+  }
+
+  return true;
+}
+
+bool TerminalStreamDecoder::finish()
+{
+  switch(mState)
+  {
+  case STATE_NORMAL_BACKSLASH:
+    //a trailing \ character outside a string escapes nothing and is omitted
+    break;
+  case STATE_DOUBLE_QUOTES_BACKSLASH:
+  case STATE_SINGLE_QUOTE_BACKSLASH:
+    mAccumulator.push_back('\\');
+    break;
+  default:
+    break;
+  };
+
+  flush();
+  reset();
+
+  return true;
+}
+
+void TerminalStreamDecoder::flush()
+{
+  if (!mAccumulator.empty())
+  {
+    mHandler.onArgument(mAccumulator.c_str(), mAccumulator.size());
+    mAccumulator.clear();
+  }
+  else if (mIsEmptyArgument)
+  {
+    mIsEmptyArgument = false;
+
+    //flush an empty string as an argument
+    mHandler.onArgument("", 0);
+  }
+}
+
+inline void TerminalStreamDecoder::process(const char c)
+{
+  switch(mState)
+  {
+  case STATE_NORMAL:
+    if (c == '\"' || c == '\'')
+    {
+      //Rule 2.2. Double quotes character `"` starts/ends a string. The `"` character is omitted from the argument.
+      //Rule 2.3: Single quote character `'` also starts/ends a string. The `'` character is omitted from the argument.
+      mState = (c == '\"' ? STATE_DOUBLE_QUOTES : STATE_SINGLE_QUOTE);
+      mIsStringEmpty = true;
+      mIsEmptyArgument = false;
+    }
+    else if (isTerminalSeparator(c))
+    {
+      //Rule 1.1: [space] or tab characters are argument delimiters/separators but *ONLY* when outside a string.
+      flush();
+    }
+    else if (c == '\\')
+    {
+      //Rule 4.1. The character `\` must be escaped with `\` (resulting in `\\`) when outside a string.
+      //Rule 4.2: Characters escaped with `\` are literal characters.
+      mState = STATE_NORMAL_BACKSLASH;
+    }
+    else
+    {
+      //Rule 7: All other characters must be read as plain text.
+      mAccumulator.push_back(c);
+    }
+    break;
+  case STATE_NORMAL_BACKSLASH:
+    mState = STATE_NORMAL;
+    if (c == '\0')
+    {
+      //the \ character escapes nothing and is omitted
+      process(c);
+    }
+    else
+    {
+      //Rule 4.2: Characters escaped with `\` are literal characters.
+      mAccumulator.push_back(c);
+    }
+    break;
+  case STATE_DOUBLE_QUOTES:
+  case STATE_SINGLE_QUOTE:
+    {
+      const bool isDoubleQuotes = (mState == STATE_DOUBLE_QUOTES);
+      const char stringCharacter = (isDoubleQuotes ? '\"' : '\'');
+      if (c == stringCharacter)
+      {
+        //ends the string
+        mState = STATE_NORMAL;
+
+        //Rule 6.1: Empty arguments must be specified with `""` and must be surrounded by argument delimiters or located at the start or the end of the command line.
+        //Rule 6.2: Empty arguments can also be specified with `''`.
+        mIsEmptyArgument = mIsStringEmpty;
+      }
+      else if (c == '\\')
+      {
+        mState = (isDoubleQuotes ? STATE_DOUBLE_QUOTES_BACKSLASH : STATE_SINGLE_QUOTE_BACKSLASH);
+        mIsStringEmpty = false;
+      }
+      else
+      {
+        //Rule 3.2: Single-quote  characters inside a double-quotes string must be interpreted literally and does not requires escaping.
+        //Rule 3.3: Double-quotes characters inside a single-quote  string must be interpreted literally and does not requires escaping.
+        mAccumulator.push_back(c);
+        mIsStringEmpty = false;
+      }
+    }
+    break;
+  case STATE_DOUBLE_QUOTES_BACKSLASH:
+    mState = STATE_DOUBLE_QUOTES;
+    if (c == '\"' || c == '\\' || isTerminalSpecialShellCharacter(c))
+    {
+      //Rule 3.4: Double quote  characters inside a double quotes string must be escaped with `\` to be properly interpreted.
+      //Rule 4.4: Two consecutive `\` characters in a double-quotes string must be interpreted as a literal `\` character.
+      //Rule 5.3: The shell characters `$`, and `` ` `` (backtick) are special shell characters and must *always* be escapsed with `\`.
+      mAccumulator.push_back(c);
+    }
+    else
+    {
+      //literal \ character
+      mAccumulator.push_back('\\');
+      process(c);
+    }
+    break;
+  case STATE_SINGLE_QUOTE_BACKSLASH:
+    mState = STATE_SINGLE_QUOTE;
+    if (isTerminalSpecialShellCharacter(c))
+    {
+      //Rule 5.3: The shell characters `$`, and `` ` `` (backtick) are special shell characters and must *always* be escapsed with `\`.
+      mAccumulator.push_back(c);
+    }
+    else
+    {
+      //Rule 4.5: The character `\` does not requires escaping when inside a single-quote string.
+      mAccumulator.push_back('\\');
+      process(c);
+    }
+    break;
+  };
+}
+
+}; //namespace libargvcodec
@@ -0,0 +1,126 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef TRACESCOPE_H
+#define TRACESCOPE_H
+
+#include "libargvcodec/Tracing.h"
+
+#include <atomic>
+#include <chrono>
+
+namespace libargvcodec
+{
+  namespace tracing
+  {
+
+    /// <summary>The number of enabled sinks. Trace points are skipped when zero.</summary>
+    extern std::atomic<int> gNumSinks;
+
+    /// <summary>Returns true if the next event of the given phase must be traced according to the sampling interval.</summary>
+    /// <remarks>Each phase has its own counter so that timers created back to back are sampled independently.</remarks>
+    bool sample(Phase iPhase);
+
+    /// <summary>Sends an event to the enabled sinks.</summary>
+    void emit(const Event & iEvent);
+
+    /// <summary>Returns a monotonic timestamp in nanoseconds.</summary>
+    inline uint64_t getTimestamp()
+    {
+      return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /// <summary>
+    /// Measures the time spent in a phase. The phase can be entered multiple times
+    /// (once per argument for instance). A single event is sent when the timer goes out of scope.
+    /// </summary>
+    /// <remarks>The sizes given to LIBARGVCODEC_TRACE_END() are only evaluated when the timer is active.</remarks>
+    class PhaseTimer
+    {
+    public:
+      inline PhaseTimer(Phase iPhase) :
+        mActive(gNumSinks.load(std::memory_order_relaxed) > 0 && sample(iPhase)),
+        mEnded(false),
+        mStart(0)
+      {
+        mEvent.phase = iPhase;
+        mEvent.duration = 0;
+        mEvent.numArguments = 0;
+        mEvent.numBytes = 0;
+      }
+
+      inline ~PhaseTimer()
+      {
+        if (mActive && mEnded)
+          emit(mEvent);
+      }
+
+      inline bool isActive() const
+      {
+        return mActive;
+      }
+
+      inline void begin()
+      {
+        if (mActive)
+          mStart = getTimestamp();
+      }
+
+      inline void end(size_t iNumArguments, size_t iNumBytes)
+      {
+        if (mActive)
+        {
+          mEvent.duration += getTimestamp() - mStart;
+          mEvent.numArguments += iNumArguments;
+          mEvent.numBytes += iNumBytes;
+          mEnded = true;
+        }
+      }
+
+    private:
+      PhaseTimer(const PhaseTimer &);
+      PhaseTimer & operator=(const PhaseTimer &);
+
+      bool mActive;
+      bool mEnded;
+      uint64_t mStart;
+      Event mEvent;
+    };
+
+  }; //namespace tracing
+}; //namespace libargvcodec
+
+#ifdef LIBARGVCODEC_TRACING
+#   define LIBARGVCODEC_TRACE_PHASE(name, phase) libargvcodec::tracing::PhaseTimer name(libargvcodec::tracing::phase)
+#   define LIBARGVCODEC_TRACE_BEGIN(name) name.begin()
+#   define LIBARGVCODEC_TRACE_END(name, numArguments, numBytes) do { if (name.isActive()) name.end(numArguments, numBytes); } while(0)
+#   define LIBARGVCODEC_TRACE_MARK(name, value) const size_t name = (value)
+#else
+#   define LIBARGVCODEC_TRACE_PHASE(name, phase)
+#   define LIBARGVCODEC_TRACE_BEGIN(name)
+#   define LIBARGVCODEC_TRACE_END(name, numArguments, numBytes)
+#   define LIBARGVCODEC_TRACE_MARK(name, value)
+#endif
+
+#endif //TRACESCOPE_H
@@ -0,0 +1,239 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "TraceScope.h"
+
+#include <memory>
+#include <mutex>
+
+namespace libargvcodec
+{
+namespace tracing
+{
+
+std::atomic<int> gNumSinks(0);
+
+const char * getPhaseName(Phase iPhase)
+{
+  switch(iPhase)
+  {
+  case PHASE_CLASSIFY:
+    return "classify";
+  case PHASE_ESCAPE:
+    return "escape";
+  case PHASE_ACCUMULATE:
+    return "accumulate";
+  case PHASE_ARGUMENT_LIST_INIT:
+    return "argumentlist_init";
+  default:
+    return "unknown";
+  };
+}
+
+#ifdef LIBARGVCODEC_TRACING
+
+/// <summary>
+/// Single producer single consumer ring buffer of a thread.
+/// The owner thread is the only writer of head and the collector is the only writer of tail.
+/// </summary>
+struct RingBuffer
+{
+  RingBuffer() : head(0), tail(0), dropped(0), alive(true)
+  {
+  }
+
+  Event events[RING_BUFFER_CAPACITY];
+  std::atomic<size_t> head;
+  std::atomic<size_t> tail;
+  std::atomic<size_t> dropped;
+  std::atomic<bool> alive;
+};
+typedef std::shared_ptr<RingBuffer> RingBufferPtr;
+
+/// <summary>Owns the ring buffer of a thread. The buffer is kept by the registry until its events are collected.</summary>
+struct ThreadRingBuffer
+{
+  ~ThreadRingBuffer()
+  {
+    if (buffer)
+      buffer->alive.store(false, std::memory_order_release);
+  }
+
+  RingBufferPtr buffer;
+};
+
+static std::atomic<Callback> gCallback(NULL);
+static std::atomic<void *> gUserData(NULL);
+static std::atomic<bool> gRingBufferEnabled(false);
+static std::atomic<size_t> gSamplingInterval(1);
+
+static std::mutex gRegistryMutex;
+static std::vector<RingBufferPtr> gRegistry;
+
+static thread_local ThreadRingBuffer gThreadRingBuffer;
+static thread_local size_t gSampleCounters[NUM_PHASES] = {};
+
+static void updateNumSinks()
+{
+  int numSinks = 0;
+  if (gCallback.load() != NULL)
+    numSinks++;
+  if (gRingBufferEnabled.load())
+    numSinks++;
+  gNumSinks.store(numSinks);
+}
+
+static RingBuffer & getThreadRingBuffer()
+{
+  RingBufferPtr & buffer = gThreadRingBuffer.buffer;
+  if (!buffer)
+  {
+    buffer.reset(new RingBuffer());
+    std::lock_guard<std::mutex> lock(gRegistryMutex);
+    gRegistry.push_back(buffer);
+  }
+  return *buffer;
+}
+
+static void push(RingBuffer & ioBuffer, const Event & iEvent)
+{
+  const size_t head = ioBuffer.head.load(std::memory_order_relaxed);
+  const size_t tail = ioBuffer.tail.load(std::memory_order_acquire);
+  if (head - tail >= RING_BUFFER_CAPACITY)
+  {
+    ioBuffer.dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  ioBuffer.events[head % RING_BUFFER_CAPACITY] = iEvent;
+  ioBuffer.head.store(head + 1, std::memory_order_release);
+}
+
+bool sample(Phase iPhase)
+{
+  const size_t interval = gSamplingInterval.load(std::memory_order_relaxed);
+  if (interval <= 1)
+    return true;
+  return (gSampleCounters[iPhase]++ % interval) == 0;
+}
+
+void emit(const Event & iEvent)
+{
+  Callback callback = gCallback.load(std::memory_order_acquire);
+  if (callback != NULL)
+    callback(iEvent, gUserData.load(std::memory_order_relaxed));
+
+  if (gRingBufferEnabled.load(std::memory_order_relaxed))
+    push(getThreadRingBuffer(), iEvent);
+}
+
+bool isEnabled()
+{
+  return true;
+}
+
+void setCallback(Callback iCallback, void * iUserData)
+{
+  gUserData.store(iUserData);
+  gCallback.store(iCallback);
+  updateNumSinks();
+}
+
+void setRingBufferEnabled(bool iEnabled)
+{
+  gRingBufferEnabled.store(iEnabled);
+  updateNumSinks();
+}
+
+size_t collectEvents(std::vector<Event> & oEvents)
+{
+  size_t dropped = 0;
+
+  std::lock_guard<std::mutex> lock(gRegistryMutex);
+  for(size_t i=0; i<gRegistry.size(); )
+  {
+    RingBuffer & buffer = *gRegistry[i];
+
+    //read the flag first: a dead thread will not write more events
+    const bool alive = buffer.alive.load(std::memory_order_acquire);
+
+    const size_t head = buffer.head.load(std::memory_order_acquire);
+    const size_t tail = buffer.tail.load(std::memory_order_relaxed);
+    for(size_t j=tail; j<head; j++)
+    {
+      oEvents.push_back(buffer.events[j % RING_BUFFER_CAPACITY]);
+    }
+    buffer.tail.store(head, std::memory_order_release);
+    dropped += buffer.dropped.exchange(0, std::memory_order_relaxed);
+
+    if (alive)
+      i++;
+    else
+      gRegistry.erase(gRegistry.begin() + i);
+  }
+
+  return dropped;
+}
+
+void setSamplingInterval(size_t iInterval)
+{
+  gSamplingInterval.store(iInterval);
+}
+
+#else
+
+bool sample(Phase /*iPhase*/)
+{
+  return false;
+}
+
+void emit(const Event & /*iEvent*/)
+{
+}
+
+bool isEnabled()
+{
+  return false;
+}
+
+void setCallback(Callback /*iCallback*/, void * /*iUserData*/)
+{
+}
+
+void setRingBufferEnabled(bool /*iEnabled*/)
+{
+}
+
+size_t collectEvents(std::vector<Event> & /*oEvents*/)
+{
+  return 0;
+}
+
+void setSamplingInterval(size_t /*iInterval*/)
+{
+}
+
+#endif //LIBARGVCODEC_TRACING
+
+}; //namespace tracing
+}; //namespace libargvcodec
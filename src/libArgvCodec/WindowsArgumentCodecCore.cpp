@@ -0,0 +1,620 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "WindowsArgumentCodecCore.h"
+#include "StringListHandler.h"
+#include "TraceScope.h"
+#include "rapidassist/process.h"
+
+#include <cstring> //for strlen()
+
+namespace libargvcodec
+{
+
+//
+// Decoder state machine.
+//
+// The command line is decoded one character at a time with a table-driven
+// state machine. Each character is mapped to a character class using a
+// per-dialect classification table. The transition table then gives, for each
+// state and character class, the action to execute and the next state.
+// Character sequences that require a lookahead (\" or ^" or "") are handled
+// with intermediate states instead.
+//
+
+enum DecoderClass
+{
+  CLASS_PLAIN,
+  CLASS_SEPARATOR,
+  CLASS_QUOTE,
+  CLASS_BACKSLASH,
+  CLASS_CARET,
+  CLASS_END, //end of the command line
+  NUM_CLASSES
+};
+
+enum DecoderState
+{
+  STATE_NORMAL,
+  STATE_NORMAL_CARET,                   //after a ^ character
+  STATE_NORMAL_BACKSLASH,               //after a sequence of \ characters
+  STATE_NORMAL_BACKSLASH_CARET,         //after a sequence of \ characters followed by a ^ character
+  STATE_STRING,
+  STATE_STRING_QUOTE,                   //after a " character
+  STATE_STRING_BACKSLASH,               //after a sequence of \ characters
+  STATE_CARET_STRING,
+  STATE_CARET_STRING_CARET,             //after a ^ character
+  STATE_CARET_STRING_QUOTE,             //after a " character
+  STATE_CARET_STRING_BACKSLASH,         //after a sequence of \ characters
+  STATE_CARET_STRING_BACKSLASH_CARET,   //after a sequence of \ characters followed by a ^ character
+  NUM_STATES
+};
+
+enum DecoderAction
+{
+  ACTION_NONE,                  //wait for the next character
+  ACTION_APPEND,                //Rule 8. Append the character to the argument
+  ACTION_FLUSH,                 //Rule 1. Ends the current argument
+  ACTION_OPEN,                  //Rule 1.1. and 4. Starts a string or a caret-string
+  ACTION_CLOSE,                 //Rule 1.1. and 4. Ends a string or a caret-string
+  ACTION_CLOSE_REPLAY,          //Rule 1.1. Ends a string and process the character again
+  ACTION_CARET,                 //Rule 5.2. A ^ character outside a string
+  ACTION_REPLAY,                //Rule 5.2. and 5.3. Skip the ^ character and process the character again
+  ACTION_BACKSLASH,             //Rule 3. Count a \ character
+  ACTION_BACKSLASH_LITERAL,     //Rule 3. Unescaped \ characters
+  ACTION_BACKSLASH_QUOTE,       //Rule 2., 2.1. and 3. Escaped \ characters followed by a " character
+  ACTION_BACKSLASH_QUOTE_CLOSE, //Rule 9.1. Same as ACTION_BACKSLASH_QUOTE inside a caret-string
+};
+
+struct DecoderTransition
+{
+  unsigned char action;
+  unsigned char next;
+};
+
+#define P CLASS_PLAIN
+#define S CLASS_SEPARATOR
+#define Q CLASS_QUOTE
+#define B CLASS_BACKSLASH
+#define C CLASS_CARET
+
+//Character classes of the Windows Command Prompt.
+const unsigned char CmdPromptDialect::CHARACTER_CLASSES[256] = {
+  S, P, P, P, P, P, P, P, P, S, P, P, P, P, P, P,  //0x00
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0x10
+  S, P, Q, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0x20
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0x30
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0x40
+  P, P, P, P, P, P, P, P, P, P, P, P, B, P, C, P,  //0x50
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0x60
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0x70
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0x80
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0x90
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0xA0
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0xB0
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0xC0
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0xD0
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0xE0
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0xF0
+};
+
+//Character classes of the CreateProcess() api.
+//The ^ character is a plain character since there is no such thing as shell characters.
+const unsigned char CreateProcessDialect::CHARACTER_CLASSES[256] = {
+  S, P, P, P, P, P, P, P, P, S, P, P, P, P, P, P,  //0x00
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0x10
+  S, P, Q, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0x20
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0x30
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0x40
+  P, P, P, P, P, P, P, P, P, P, P, P, B, P, P, P,  //0x50
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0x60
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0x70
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0x80
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0x90
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0xA0
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0xB0
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0xC0
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0xD0
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0xE0
+  P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,  //0xF0
+};
+
+#undef P
+#undef S
+#undef Q
+#undef B
+#undef C
+
+#define T(action, state) { ACTION_##action, STATE_##state }
+
+static const DecoderTransition gTransitions[NUM_STATES][NUM_CLASSES] = {
+  //            CLASS_PLAIN                               CLASS_SEPARATOR                           CLASS_QUOTE                                       CLASS_BACKSLASH                             CLASS_CARET                                           CLASS_END
+  /*NORMAL*/  { T(APPEND, NORMAL),                        T(FLUSH, NORMAL),                         T(OPEN, STRING),                                  T(BACKSLASH, NORMAL_BACKSLASH),             T(CARET, NORMAL_CARET),                               T(FLUSH, NORMAL)                           },
+  /*N_CARET*/ { T(REPLAY, NORMAL),                        T(REPLAY, NORMAL),                        T(OPEN, CARET_STRING),                            T(REPLAY, NORMAL),                          T(APPEND, NORMAL),                                    T(REPLAY, NORMAL)                          },
+  /*N_BS*/    { T(BACKSLASH_LITERAL, NORMAL),             T(BACKSLASH_LITERAL, NORMAL),             T(BACKSLASH_QUOTE, NORMAL),                       T(BACKSLASH, NORMAL_BACKSLASH),             T(NONE, NORMAL_BACKSLASH_CARET),                      T(BACKSLASH_LITERAL, NORMAL)               },
+  /*N_BS_C*/  { T(BACKSLASH_LITERAL, NORMAL_CARET),       T(BACKSLASH_LITERAL, NORMAL_CARET),       T(BACKSLASH_QUOTE, NORMAL_CARET),                 T(BACKSLASH, NORMAL_BACKSLASH),             T(BACKSLASH_LITERAL, NORMAL_CARET),                   T(BACKSLASH_LITERAL, NORMAL_CARET)         },
+  /*STR*/     { T(APPEND, STRING),                        T(APPEND, STRING),                        T(NONE, STRING_QUOTE),                            T(BACKSLASH, STRING_BACKSLASH),             T(APPEND, STRING),                                    T(FLUSH, STRING)                           },
+  /*S_QUOTE*/ { T(CLOSE_REPLAY, NORMAL),                  T(CLOSE_REPLAY, NORMAL),                  T(APPEND, STRING),                                T(CLOSE_REPLAY, NORMAL),                    T(CLOSE_REPLAY, NORMAL),                              T(CLOSE_REPLAY, NORMAL)                    },
+  /*S_BS*/    { T(BACKSLASH_LITERAL, STRING),             T(BACKSLASH_LITERAL, STRING),             T(BACKSLASH_QUOTE, STRING),                       T(BACKSLASH, STRING_BACKSLASH),             T(BACKSLASH_LITERAL, STRING),                         T(BACKSLASH_LITERAL, STRING)               },
+  /*C_STR*/   { T(APPEND, CARET_STRING),                  T(APPEND, CARET_STRING),                  T(NONE, CARET_STRING_QUOTE),                      T(BACKSLASH, CARET_STRING_BACKSLASH),       T(NONE, CARET_STRING_CARET),                          T(FLUSH, CARET_STRING)                     },
+  /*C_CARET*/ { T(REPLAY, CARET_STRING),                  T(REPLAY, CARET_STRING),                  T(CLOSE, NORMAL),                                 T(REPLAY, CARET_STRING),                    T(APPEND, CARET_STRING),                              T(REPLAY, CARET_STRING)                    },
+  /*C_QUOTE*/ { T(CLOSE_REPLAY, NORMAL),                  T(CLOSE_REPLAY, NORMAL),                  T(APPEND, CARET_STRING),                          T(CLOSE_REPLAY, NORMAL),                    T(CLOSE_REPLAY, NORMAL),                              T(CLOSE_REPLAY, NORMAL)                    },
+  /*C_BS*/    { T(BACKSLASH_LITERAL, CARET_STRING),       T(BACKSLASH_LITERAL, CARET_STRING),       T(BACKSLASH_QUOTE_CLOSE, CARET_STRING),           T(BACKSLASH, CARET_STRING_BACKSLASH),       T(NONE, CARET_STRING_BACKSLASH_CARET),                T(BACKSLASH_LITERAL, CARET_STRING)         },
+  /*C_BS_C*/  { T(BACKSLASH_LITERAL, CARET_STRING_CARET), T(BACKSLASH_LITERAL, CARET_STRING_CARET), T(BACKSLASH_QUOTE, CARET_STRING_CARET),           T(BACKSLASH, CARET_STRING_BACKSLASH),       T(BACKSLASH_LITERAL, CARET_STRING_CARET),             T(BACKSLASH_LITERAL, CARET_STRING_CARET)   },
+};
+
+#undef T
+
+//State to return to after an odd number of \ characters followed by a " character (Rule 2. and 2.1.)
+static const unsigned char gBaseStates[NUM_STATES] = {
+  STATE_NORMAL,       //STATE_NORMAL
+  STATE_NORMAL,       //STATE_NORMAL_CARET
+  STATE_NORMAL,       //STATE_NORMAL_BACKSLASH
+  STATE_NORMAL,       //STATE_NORMAL_BACKSLASH_CARET
+  STATE_STRING,       //STATE_STRING
+  STATE_STRING,       //STATE_STRING_QUOTE
+  STATE_STRING,       //STATE_STRING_BACKSLASH
+  STATE_CARET_STRING, //STATE_CARET_STRING
+  STATE_CARET_STRING, //STATE_CARET_STRING_CARET
+  STATE_CARET_STRING, //STATE_CARET_STRING_QUOTE
+  STATE_CARET_STRING, //STATE_CARET_STRING_BACKSLASH
+  STATE_CARET_STRING, //STATE_CARET_STRING_BACKSLASH_CARET
+};
+
+template <typename Dialect>
+std::string WindowsArgumentCodecCore<Dialect>::encodeArgument(const char * iValue)
+{
+  LIBARGVCODEC_TRACE_PHASE(classifyTimer, PHASE_CLASSIFY);
+  LIBARGVCODEC_TRACE_PHASE(escapeTimer, PHASE_ESCAPE);
+
+  LIBARGVCODEC_TRACE_BEGIN(classifyTimer);
+  ArgumentClass argumentClass;
+  classifyArgument(iValue, argumentClass);
+  LIBARGVCODEC_TRACE_END(classifyTimer, 1, argumentClass.length);
+
+  LIBARGVCODEC_TRACE_BEGIN(escapeTimer);
+  std::string escapedArg;
+  appendEncodedArgument(iValue, argumentClass, escapedArg);
+  LIBARGVCODEC_TRACE_END(escapeTimer, 1, escapedArg.size());
+  return escapedArg;
+}
+
+template <typename Dialect>
+void WindowsArgumentCodecCore<Dialect>::appendEncodedArgument(const char * iValue, ResourceString & ioOutput)
+{
+  LIBARGVCODEC_TRACE_PHASE(classifyTimer, PHASE_CLASSIFY);
+  LIBARGVCODEC_TRACE_PHASE(escapeTimer, PHASE_ESCAPE);
+
+  LIBARGVCODEC_TRACE_BEGIN(classifyTimer);
+  ArgumentClass argumentClass;
+  classifyArgument(iValue, argumentClass);
+  LIBARGVCODEC_TRACE_END(classifyTimer, 1, argumentClass.length);
+
+  LIBARGVCODEC_TRACE_BEGIN(escapeTimer);
+  LIBARGVCODEC_TRACE_MARK(escapeStart, ioOutput.size());
+  appendEncodedArgument(iValue, argumentClass, ioOutput);
+  LIBARGVCODEC_TRACE_END(escapeTimer, 1, ioOutput.size() - escapeStart);
+}
+
+template <typename Dialect>
+template <typename String>
+void WindowsArgumentCodecCore<Dialect>::appendEncodedArgument(const char * iValue, const ArgumentClass & iClass, String & ioOutput)
+{
+  //http://blogs.msdn.com/b/twistylittlepassagesallalike/archive/2011/04/23/everyone-quotes-arguments-the-wrong-way.aspx
+  //http://stackoverflow.com/questions/2393384/escape-string-for-process-start
+  //http://stackoverflow.com/questions/5510343/escape-command-line-arguments-in-c-sharp/6040946#6040946
+
+  //Rule 6. Deal with empty argument ASAP
+  if (iClass.length == 0)
+  {
+    ioOutput.append("\"\"");
+    return;
+  }
+
+  //check flags
+
+  //Rule 1.1.
+  bool isStringArgument = iClass.hasSpaces;
+
+  //Rule 5.1.
+  bool hasShellCharacters_ = Dialect::SUPPORTS_SHELL_CHARACTERS && iClass.hasCmdPromptShellCharacters;
+
+  //Optimization...
+  //Encode shell characters with a caret characters if argument is not a string and does not contains " or \ characters
+  //otherwise, encode using a string
+  //ie: test&whoami should be encoded as test^&whoami instead of "test&whoami"
+  isStringArgument = isStringArgument || ( hasShellCharacters_ && (iClass.hasDoubleQuotes || iClass.hasBackslashes) ); 
+  
+  //Rule 4.
+  bool isCaretStringArgument = false; // isStringArgument && hasShellCharacters_;
+
+  //deal with flags
+  if (isCaretStringArgument)
+  {
+    //Rule 4.
+    //starts a caret-string command
+    ioOutput.append("^\"");
+  }
+  else if (isStringArgument)
+  {
+    //Rule 1.
+    //starts a string command
+    ioOutput.append(1, '\"');
+  }
+
+  size_t numBackslashes = 0;
+  //for each characters
+  for(size_t i=0; i<iClass.length; i++)
+  {
+    char c = iValue[i];
+
+    if (Dialect::isShellCharacter(c))
+    {
+      //Rule 3.
+      //Unescaped \ characters
+      //flush backslashes accumulator
+      ioOutput.append( numBackslashes, '\\' );
+      numBackslashes = 0;
+
+      //escape character
+      if (isStringArgument && !isCaretStringArgument)
+      {
+        if (c == '%')
+        {
+          //Rule 5.1 (EXCEPTION).
+          //The `%` character cannot be escaped when inside a string. To prevent environment string expansion with the `%` character (for example `%TEMP%`), the string can be closed right after the `%` character. The following characters should be inserted in the same string. For example, the character sequence `%TEMP%` in a string must be escaped as `"%"TEMP%""`.
+          ioOutput.append(1, c);
+          ioOutput.append(1, '\"');
+        }
+        else
+        {
+          //Rule 5.1.
+          //special shell character inside a string which is safe to *NOT* escape
+          ioOutput.append(1, c);
+        }
+      }
+      else
+      {
+        //Rule 5.2.
+        //not a string or using a caret-string. Must escape
+        ioOutput.append(1, '^');
+        ioOutput.append(1, c);
+      }
+    }
+    else if (c == '\"')
+    {
+      //must always escape
+      //choosing to always use \" as escaping method
+
+      //Rule 3.
+      //flush backslashes first
+      ioOutput.append( (2*numBackslashes), '\\' );
+      numBackslashes = 0;
+
+      if (isCaretStringArgument)
+      {
+        //Rule 2.1.
+        ioOutput.append(1, '\\');
+        ioOutput.append(1, '^');
+        ioOutput.append(1, c);
+      }
+      else if (isStringArgument)
+      {
+        //Rule 2.
+        //escaped " character (using "" for escaping)
+        ioOutput.append(1, c);
+        ioOutput.append(1, c);
+      }
+      else
+      {
+        //Rule 2.
+        //escaped " character (using \" for escaping)
+        ioOutput.append(1, '\\');
+        ioOutput.append(1, c);
+      }
+    }
+    else if(c == '\\')
+    {
+      //Rule 3.
+      //accumulate
+      numBackslashes++;
+    }
+    else
+    {
+      //Rule 3.
+      //Unescaped \ characters
+      //flush backslashes accumulator
+      ioOutput.append( numBackslashes, '\\' );
+      numBackslashes = 0;
+
+      //Rule 1.
+      //plain character
+      ioOutput.append( 1, c );
+      numBackslashes = 0;
+    }
+  }
+
+  //Rule 3.
+  //Unescaped \ characters
+  //flush backslashes accumulator
+  const size_t numTrailingBackslashes = numBackslashes;
+  ioOutput.append( numBackslashes, '\\' );
+  numBackslashes = 0;
+
+  //deal with flags
+  if (isCaretStringArgument)
+  {
+    //Rule 3.
+    //but watch out for arguments that ends with \ character
+    ioOutput.append(numTrailingBackslashes, '\\');
+
+    //Rule 4.
+    //ends the caret-string command
+    ioOutput.append("^\"");
+  }
+  else if (isStringArgument)
+  {
+    //Rule 3.
+    //but watch out for arguments that ends with \ character
+    ioOutput.append(numTrailingBackslashes, '\\');
+
+    //Rule 1.
+    //ends the string command
+    ioOutput.append(1, '\"');
+  }
+  //else
+  // no problem
+}
+
+template <typename Dialect>
+std::string WindowsArgumentCodecCore<Dialect>::encodeCommandLine(const ArgumentList & iArguments)
+{
+  LIBARGVCODEC_TRACE_PHASE(classifyTimer, PHASE_CLASSIFY);
+  LIBARGVCODEC_TRACE_PHASE(escapeTimer, PHASE_ESCAPE);
+  std::string cmdLine;
+
+  for(int i=1; i<iArguments.getArgc(); i++) //skip first element since it refers to the actual .exe that was launched
+  {
+    const char * argValue = iArguments.getArgument(i);
+
+    LIBARGVCODEC_TRACE_BEGIN(classifyTimer);
+    ArgumentClass argumentClass;
+    classifyArgument(argValue, argumentClass);
+    LIBARGVCODEC_TRACE_END(classifyTimer, 1, argumentClass.length);
+
+    LIBARGVCODEC_TRACE_BEGIN(escapeTimer);
+    LIBARGVCODEC_TRACE_MARK(escapeStart, cmdLine.size());
+    appendEncodedArgument(argValue, argumentClass, cmdLine);
+    LIBARGVCODEC_TRACE_END(escapeTimer, 1, cmdLine.size() - escapeStart);
+
+    //add a space between arguments (except the last one)
+    bool isLastArgument = !(i+1<iArguments.getArgc());
+    if (!isLastArgument)
+      cmdLine.append(" ");
+  }
+
+  return cmdLine;
+}
+
+template <typename Dialect>
+std::string WindowsArgumentCodecCore<Dialect>::decodeArgument(const char * iValue)
+{
+  ArgumentList arglist = decodeCommandLine(iValue);
+  if (arglist.getArgc() >= 2) //at least a exe name and an argument
+  {
+    std::string arg = arglist.getArgument(1);
+    return arg;
+  }
+
+  return std::string();
+}
+
+template <typename Dialect>
+ArgumentList WindowsArgumentCodecCore<Dialect>::decodeCommandLine(const char * iValue)
+{
+  ArgumentList arglist;
+
+  ArgumentList::StringList args;
+  bool success = parseCmdLine(iValue, args);
+  if (success)
+  {
+    //insert local .exe path
+    args.insert( args.begin(), ra::process::getCurrentProcessPath() );
+
+    arglist.init(args);
+  }
+
+  return arglist;
+}
+
+template <typename Dialect>
+bool WindowsArgumentCodecCore<Dialect>::hasShellCharacters(const char * iValue)
+{
+  if (iValue == NULL || !Dialect::SUPPORTS_SHELL_CHARACTERS)
+    return false;
+
+  for(const char * c = iValue; *c != '\0'; c++)
+  {
+    if (Dialect::isShellCharacter(*c))
+      return true;
+  }
+  return false;
+}
+
+template <typename Dialect>
+bool WindowsArgumentCodecCore<Dialect>::parseCmdLine(const char * iCmdLine, ArgumentList::StringList & oArguments)
+{
+  if (iCmdLine == NULL)
+    return false;
+
+  oArguments.clear();
+
+  LIBARGVCODEC_TRACE_PHASE(accumulateTimer, PHASE_ACCUMULATE);
+  LIBARGVCODEC_TRACE_BEGIN(accumulateTimer);
+  const size_t length = strlen(iCmdLine);
+  StringListHandler handler(oArguments);
+  WindowsStreamDecoderCore<Dialect> decoder;
+  decoder.feed(iCmdLine, length, handler);
+  decoder.finish(handler);
+  LIBARGVCODEC_TRACE_END(accumulateTimer, oArguments.size(), length);
+
+  return true;
+}
+
+template <typename Dialect>
+WindowsStreamDecoderCore<Dialect>::WindowsStreamDecoderCore(IMemoryResource * iResource) :
+  mAccumulator(ResourceString::allocator_type(iResource))
+{
+  reset();
+}
+
+template <typename Dialect>
+void WindowsStreamDecoderCore<Dialect>::reset()
+{
+  mAccumulator.clear();
+  mNumBackslashes = 0;
+  mIsJuxtaposedString = false;
+  mIsValidEmptyArgument = false;
+  mState = STATE_NORMAL;
+}
+
+template <typename Dialect>
+void WindowsStreamDecoderCore<Dialect>::feed(const char * iBuffer, size_t iLength, IArgumentHandler & iHandler)
+{
+  for(size_t i=0; i<iLength; i++)
+  {
+    const char c = iBuffer[i];
+    process(c, Dialect::CHARACTER_CLASSES[(unsigned char)c], iHandler);
+  }
+}
+
+template <typename Dialect>
+void WindowsStreamDecoderCore<Dialect>::finish(IArgumentHandler & iHandler)
+{
+  process('\0', CLASS_END, iHandler);
+  reset();
+}
+
+template <typename Dialect>
+inline void WindowsStreamDecoderCore<Dialect>::process(const char c, const unsigned char iCharacterClass, IArgumentHandler & iHandler)
+{
+  bool replay = true;
+  while(replay)
+  {
+    replay = false;
+
+    const DecoderTransition & transition = gTransitions[mState][iCharacterClass];
+    unsigned char next = transition.next;
+
+    //string ending flags are only valid for the character that follows the end of the string
+    const bool juxtaposed = mIsJuxtaposedString;
+    const bool emptyArgument = mIsValidEmptyArgument;
+    mIsJuxtaposedString = false;
+    mIsValidEmptyArgument = false;
+
+    switch(transition.action)
+    {
+    case ACTION_NONE:
+      break;
+    case ACTION_APPEND:
+      mAccumulator.push_back(c);
+      break;
+    case ACTION_FLUSH:
+      if (!mAccumulator.empty())
+      {
+        iHandler.onArgument(mAccumulator.c_str(), mAccumulator.size());
+        mAccumulator.clear();
+      }
+      else if (emptyArgument)
+      {
+        //Rule 6. insert an empty argument
+        iHandler.onArgument("", 0);
+      }
+      break;
+    case ACTION_OPEN:
+      if (juxtaposed)
+        mAccumulator.push_back('\"');
+      break;
+    case ACTION_CLOSE_REPLAY:
+      replay = true;
+      //fall through
+    case ACTION_CLOSE:
+      mIsJuxtaposedString = true;
+      mIsValidEmptyArgument = mAccumulator.empty();
+      break;
+    case ACTION_CARET:
+      //the ^ character may start a juxtaposed caret-string
+      mIsJuxtaposedString = juxtaposed;
+      break;
+    case ACTION_REPLAY:
+      replay = true;
+      break;
+    case ACTION_BACKSLASH:
+      mNumBackslashes++;
+      break;
+    case ACTION_BACKSLASH_LITERAL:
+      mAccumulator.append(mNumBackslashes, '\\');
+      mNumBackslashes = 0;
+      replay = true;
+      break;
+    case ACTION_BACKSLASH_QUOTE:
+    case ACTION_BACKSLASH_QUOTE_CLOSE:
+      mAccumulator.append(mNumBackslashes/2, '\\');
+      if (mNumBackslashes%2 == 0)
+      {
+        //the " character (or ^" characters) is not escaped
+        replay = true;
+      }
+      else if (transition.action == ACTION_BACKSLASH_QUOTE)
+      {
+        //escaped " character
+        mAccumulator.push_back('\"');
+        next = gBaseStates[next];
+      }
+      else
+      {
+        //Rule 9.1. The \" sequence ends the caret-string and the " character starts a juxtaposed string
+        mIsJuxtaposedString = true;
+        next = STATE_NORMAL;
+        replay = true;
+      }
+      mNumBackslashes = 0;
+      break;
+    };
+
+    mState = next;
+  }
+}
+
+//explicit instantiation of the supported dialects
+template class WindowsArgumentCodecCore<CmdPromptDialect>;
+template class WindowsArgumentCodecCore<CreateProcessDialect>;
+template void WindowsArgumentCodecCore<CmdPromptDialect>::appendEncodedArgument(const char *, const ArgumentClass &, std::string &);
+template void WindowsArgumentCodecCore<CmdPromptDialect>::appendEncodedArgument(const char *, const ArgumentClass &, ResourceString &);
+template void WindowsArgumentCodecCore<CreateProcessDialect>::appendEncodedArgument(const char *, const ArgumentClass &, std::string &);
+template void WindowsArgumentCodecCore<CreateProcessDialect>::appendEncodedArgument(const char *, const ArgumentClass &, ResourceString &);
+template class WindowsStreamDecoderCore<CmdPromptDialect>;
+template class WindowsStreamDecoderCore<CreateProcessDialect>;
+
+}; //namespace libargvcodec
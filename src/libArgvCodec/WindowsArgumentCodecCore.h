@@ -0,0 +1,164 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef WINDOWSARGUMENTCODECCORE_H
+#define WINDOWSARGUMENTCODECCORE_H
+
+#include "libargvcodec/ArgumentList.h"
+#include "libargvcodec/IArgumentHandler.h"
+#include "libargvcodec/ResourceAllocator.h"
+#include "ArgumentClassifier.h"
+#include <string>
+
+namespace libargvcodec
+{
+
+  /// <summary>Compile-time dialect policy of the Windows Command Prompt.</summary>
+  struct CmdPromptDialect
+  {
+    /// <summary>Defines if the dialect supports shell characters.</summary>
+    static const bool SUPPORTS_SHELL_CHARACTERS = true;
+
+    /// <summary>Character classification table of the decoder.</summary>
+    static const unsigned char CHARACTER_CLASSES[256];
+
+    /// <summary>Returns true if the given character is a shell character.</summary>
+    /// <param name="c">The given character to test.</param>
+    /// <returns>Returns true if the given character is a shell character. Returns false otherwise.</returns>
+    static inline bool isShellCharacter(const char c)
+    {
+      switch(c)
+      {
+      case '^':
+      case '&':
+      case '|':
+      case '(':
+      case ')':
+      case '<':
+      case '>':
+      case '%': // % is a special character, not a shell character. It must be escaped to protect against "%PATH%" constructions. The character is a shell character in batch files.
+        return true;
+      default:
+        return false;
+      };
+    }
+  };
+
+  /// <summary>Compile-time dialect policy of the Windows CreateProcess() api.</summary>
+  struct CreateProcessDialect
+  {
+    /// <summary>Defines if the dialect supports shell characters.</summary>
+    static const bool SUPPORTS_SHELL_CHARACTERS = false;
+
+    /// <summary>Character classification table of the decoder.</summary>
+    static const unsigned char CHARACTER_CLASSES[256];
+
+    /// <summary>Returns true if the given character is a shell character.</summary>
+    /// <param name="c">The given character to test.</param>
+    /// <returns>Always returns false. There is no such thing as shell characters.</returns>
+    static inline bool isShellCharacter(const char /*c*/)
+    {
+      return false;
+    }
+  };
+
+  /// <summary>
+  /// Encoding and decoding implementation of Windows command lines.
+  /// The dialect is a compile-time policy which allows the compiler to inline the shell characters checks.
+  /// The CmdPromptArgumentCodec and CreateProcessArgumentCodec classes are thin wrappers over this class.
+  /// </summary>
+  template <typename Dialect>
+  class WindowsArgumentCodecCore
+  {
+  public:
+    static std::string encodeArgument(const char * iValue);
+    static std::string encodeCommandLine(const ArgumentList & iArguments);
+
+    /// <summary>Encodes an argument which is already classified and appends the result to the given string.</summary>
+    /// <param name="iValue">The argument to encode. Must not be NULL.</param>
+    /// <param name="iClass">The classification of the argument.</param>
+    /// <param name="ioOutput">The string which receives the encoded argument. Either a std::string or a ResourceString.</param>
+    template <typename String>
+    static void appendEncodedArgument(const char * iValue, const ArgumentClass & iClass, String & ioOutput);
+
+    /// <summary>Encodes an argument and appends the result to the given string.</summary>
+    /// <param name="iValue">The argument to encode.</param>
+    /// <param name="ioOutput">The string which receives the encoded argument.</param>
+    static void appendEncodedArgument(const char * iValue, ResourceString & ioOutput);
+    static std::string decodeArgument(const char * iValue);
+    static ArgumentList decodeCommandLine(const char * iValue);
+
+    /// <summary>Returns true if the given string has at least one shell character.</summary>
+    /// <param name="iValue">The given string to test.</param>
+    /// <returns>Returns true if the given string has at least one shell character. Returns false otherwise.</returns>
+    static bool hasShellCharacters(const char * iValue);
+
+    /// <summary>Parses a command line string into a list of arguments.</summary>
+    /// <param name="iCmdLine">The command line string to parse.</param>
+    /// <param name="oArguments">The output list of arguments.</param>
+    /// <returns>Returns true on parse success. Returns false otherwise.</returns>
+    static bool parseCmdLine(const char * iCmdLine, ArgumentList::StringList & oArguments);
+  };
+
+  /// <summary>
+  /// Incremental decoder of Windows command lines.
+  /// The state of the decoder is kept between calls to feed() which allows a command line to be decoded in chunks.
+  /// </summary>
+  template <typename Dialect>
+  class WindowsStreamDecoderCore
+  {
+  public:
+    /// <summary>Creates a decoder.</summary>
+    /// <param name="iResource">The source of memory of the accumulator. Use NULL to allocate from the global heap.</param>
+    WindowsStreamDecoderCore(IMemoryResource * iResource = NULL);
+
+    /// <summary>Resets the decoder to decode a new command line.</summary>
+    void reset();
+
+    /// <summary>Decodes the next chunk of a command line. A NULL character is an argument separator.</summary>
+    /// <param name="iBuffer">The chunk of the command line.</param>
+    /// <param name="iLength">The length of the chunk in bytes.</param>
+    /// <param name="iHandler">The handler of the completed arguments.</param>
+    void feed(const char * iBuffer, size_t iLength, IArgumentHandler & iHandler);
+
+    /// <summary>Ends the command line and resets the decoder.</summary>
+    /// <param name="iHandler">The handler of the completed arguments.</param>
+    void finish(IArgumentHandler & iHandler);
+
+  private:
+    inline void process(const char c, const unsigned char iCharacterClass, IArgumentHandler & iHandler);
+
+    ResourceString mAccumulator;
+    size_t mNumBackslashes;
+    bool mIsJuxtaposedString;   //Rule 7. true if the previous character ended a string or a caret-string
+    bool mIsValidEmptyArgument; //Rule 6. true if the previous character ended an empty string or caret-string
+    unsigned char mState;
+  };
+
+  typedef WindowsArgumentCodecCore<CmdPromptDialect>      CmdPromptCodecCore;
+  typedef WindowsArgumentCodecCore<CreateProcessDialect>  CreateProcessCodecCore;
+
+}; //namespace libargvcodec
+
+#endif //WINDOWSARGUMENTCODECCORE_H
@@ -0,0 +1,141 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "BenchmarkUtils.h"
+
+#include <benchmark/benchmark.h>
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+using namespace libargvcodec;
+
+//Arguments of the ArgumentList benchmarks: number of option and value pairs.
+static void setListArguments(benchmark::internal::Benchmark * b)
+{
+  b->ArgName("options");
+  b->RangeMultiplier(4)->Range(4, 4096);
+  b->Complexity();
+}
+
+static void BM_ArgumentList_FindOption(benchmark::State & state)
+{
+  const ArgumentList arglist = buildOptions((size_t)state.range(0));
+
+  //search a missing option to scan the whole list
+  resetStatsCounters();
+  for (auto _ : state)
+  {
+    bool found = arglist.findOption("--missing");
+    benchmark::DoNotOptimize(found);
+  }
+  setStatsCounters(state);
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_ArgumentList_FindOption)->Apply(setListArguments);
+
+static void BM_ArgumentList_FindValue(benchmark::State & state)
+{
+  const ArgumentList arglist = buildOptions((size_t)state.range(0));
+
+  //the last value requires scanning the whole list
+  char name[64];
+  sprintf(name, "--value%d=", (int)state.range(0) - 1);
+
+  resetStatsCounters();
+  for (auto _ : state)
+  {
+    int index = 0;
+    std::string value;
+    bool found = arglist.findValue(name, index, value);
+    benchmark::DoNotOptimize(found);
+  }
+  setStatsCounters(state);
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_ArgumentList_FindValue)->Apply(setListArguments);
+
+static void BM_ArgumentList_ExtractOption(benchmark::State & state)
+{
+  const size_t numOptions = (size_t)state.range(0);
+  const ArgumentList arglist = buildOptions(numOptions);
+
+  //extract all options, from the first to the last
+  std::vector<std::string> names;
+  for(size_t i=0; i<numOptions; i++)
+  {
+    char name[64];
+    sprintf(name, "--option%d", (int)i);
+    names.push_back(name);
+  }
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    ArgumentList copy = arglist;
+    state.ResumeTiming();
+
+    for(size_t i=0; i<names.size(); i++)
+    {
+      bool extracted = copy.extractOption(names[i].c_str());
+      benchmark::DoNotOptimize(extracted);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * numOptions);
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_ArgumentList_ExtractOption)->Apply(setListArguments);
+
+static void BM_ArgumentList_ExtractValue(benchmark::State & state)
+{
+  const size_t numOptions = (size_t)state.range(0);
+  const ArgumentList arglist = buildOptions(numOptions);
+
+  //extract all values, from the first to the last
+  std::vector<std::string> names;
+  for(size_t i=0; i<numOptions; i++)
+  {
+    char name[64];
+    sprintf(name, "--value%d=", (int)i);
+    names.push_back(name);
+  }
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    ArgumentList copy = arglist;
+    state.ResumeTiming();
+
+    for(size_t i=0; i<names.size(); i++)
+    {
+      std::string value;
+      bool extracted = copy.extractValue(names[i].c_str(), value);
+      benchmark::DoNotOptimize(extracted);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * numOptions);
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_ArgumentList_ExtractValue)->Apply(setListArguments);
@@ -0,0 +1,94 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "BenchmarkUtils.h"
+#include "libargvcodec/CmdPromptArgumentCodec.h"
+#include "libargvcodec/CreateProcessArgumentCodec.h"
+#include "libargvcodec/TerminalArgumentCodec.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+using namespace libargvcodec;
+
+//Arguments of the codec benchmarks: number of arguments, length of each argument and escape density (percentage).
+static void setCodecArguments(benchmark::internal::Benchmark * b)
+{
+  b->ArgNames(std::vector<std::string>{"args", "length", "escapes"});
+  b->ArgsProduct({
+    {1, 16, 256},
+    {8, 64, 512},
+    {0, 10, 50},
+  });
+}
+
+template <typename Codec>
+static void BM_EncodeCommandLine(benchmark::State & state)
+{
+  const Codec codec;
+  const ArgumentList arglist = buildArguments((size_t)state.range(0), (size_t)state.range(1), (int)state.range(2));
+
+  size_t numBytes = 0;
+  resetStatsCounters();
+  for (auto _ : state)
+  {
+    std::string cmdline = codec.encodeCommandLine(arglist);
+    numBytes += cmdline.size();
+    benchmark::DoNotOptimize(cmdline);
+  }
+  setStatsCounters(state);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(numBytes);
+}
+
+template <typename Codec>
+static void BM_DecodeCommandLine(benchmark::State & state)
+{
+  const Codec codec;
+  const ArgumentList arglist = buildArguments((size_t)state.range(0), (size_t)state.range(1), (int)state.range(2));
+
+  //decode the arguments only. The first argument is replaced by the current executable path.
+  ArgumentList args = arglist;
+  args.remove(0);
+  const std::string cmdline = codec.encodeCommandLine(args);
+
+  resetStatsCounters();
+  for (auto _ : state)
+  {
+    ArgumentList decoded = codec.decodeCommandLine(cmdline.c_str());
+    benchmark::DoNotOptimize(decoded);
+  }
+  setStatsCounters(state);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * cmdline.size());
+}
+
+BENCHMARK_TEMPLATE(BM_EncodeCommandLine, CmdPromptArgumentCodec)->Apply(setCodecArguments);
+BENCHMARK_TEMPLATE(BM_EncodeCommandLine, CreateProcessArgumentCodec)->Apply(setCodecArguments);
+BENCHMARK_TEMPLATE(BM_EncodeCommandLine, TerminalArgumentCodec)->Apply(setCodecArguments);
+BENCHMARK_TEMPLATE(BM_DecodeCommandLine, CmdPromptArgumentCodec)->Apply(setCodecArguments);
+BENCHMARK_TEMPLATE(BM_DecodeCommandLine, CreateProcessArgumentCodec)->Apply(setCodecArguments);
+BENCHMARK_TEMPLATE(BM_DecodeCommandLine, TerminalArgumentCodec)->Apply(setCodecArguments);
@@ -0,0 +1,122 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "BenchmarkUtils.h"
+#include "CorpusGenerator.h"
+#include "libargvcodec/CmdPromptArgumentCodec.h"
+#include "libargvcodec/CreateProcessArgumentCodec.h"
+#include "libargvcodec/TerminalArgumentCodec.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+using namespace libargvcodec;
+
+static const uint64_t CORPUS_SEED = 0x6172677663646563ULL;
+static const size_t CORPUS_COUNT = 64;
+
+//Arguments of the corpus benchmarks: kind of command lines and size of each command line in bytes.
+static void setCorpusArguments(benchmark::internal::Benchmark * b)
+{
+  b->ArgNames(std::vector<std::string>{"kind", "size"});
+  b->ArgsProduct({
+    benchmark::CreateDenseRange(0, CorpusGenerator::NUM_KINDS - 1, 1),
+    {256, 4096, 65536},
+  });
+}
+
+static std::vector<ArgumentList> generateCorpus(benchmark::State & state)
+{
+  CorpusGenerator::StringListArray corpus;
+  CorpusGenerator generator(CORPUS_SEED);
+  generator.generateCorpus((CorpusGenerator::Kind)state.range(0), CORPUS_COUNT, (size_t)state.range(1), corpus);
+  state.SetLabel(CorpusGenerator::getKindName((CorpusGenerator::Kind)state.range(0)));
+
+  std::vector<ArgumentList> arglists(corpus.size());
+  for(size_t i=0; i<corpus.size(); i++)
+  {
+    corpus[i].insert(corpus[i].begin(), "benchmark.exe");
+    arglists[i].init(corpus[i]);
+  }
+  return arglists;
+}
+
+template <typename Codec>
+static void BM_EncodeCorpus(benchmark::State & state)
+{
+  const Codec codec;
+  const std::vector<ArgumentList> arglists = generateCorpus(state);
+
+  size_t numBytes = 0;
+  resetStatsCounters();
+  for (auto _ : state)
+  {
+    for(size_t i=0; i<arglists.size(); i++)
+    {
+      std::string cmdline = codec.encodeCommandLine(arglists[i]);
+      numBytes += cmdline.size();
+      benchmark::DoNotOptimize(cmdline);
+    }
+  }
+  setStatsCounters(state);
+  state.SetItemsProcessed(state.iterations() * arglists.size());
+  state.SetBytesProcessed(numBytes);
+}
+
+template <typename Codec>
+static void BM_DecodeCorpus(benchmark::State & state)
+{
+  const Codec codec;
+  const std::vector<ArgumentList> arglists = generateCorpus(state);
+
+  std::vector<std::string> cmdlines;
+  size_t size = 0;
+  for(size_t i=0; i<arglists.size(); i++)
+  {
+    cmdlines.push_back(codec.encodeCommandLine(arglists[i]));
+    size += cmdlines.back().size();
+  }
+
+  resetStatsCounters();
+  for (auto _ : state)
+  {
+    for(size_t i=0; i<cmdlines.size(); i++)
+    {
+      ArgumentList decoded = codec.decodeCommandLine(cmdlines[i].c_str());
+      benchmark::DoNotOptimize(decoded);
+    }
+  }
+  setStatsCounters(state);
+  state.SetItemsProcessed(state.iterations() * cmdlines.size());
+  state.SetBytesProcessed(state.iterations() * size);
+}
+
+BENCHMARK_TEMPLATE(BM_EncodeCorpus, CmdPromptArgumentCodec)->Apply(setCorpusArguments);
+BENCHMARK_TEMPLATE(BM_EncodeCorpus, CreateProcessArgumentCodec)->Apply(setCorpusArguments);
+BENCHMARK_TEMPLATE(BM_EncodeCorpus, TerminalArgumentCodec)->Apply(setCorpusArguments);
+BENCHMARK_TEMPLATE(BM_DecodeCorpus, CmdPromptArgumentCodec)->Apply(setCorpusArguments);
+BENCHMARK_TEMPLATE(BM_DecodeCorpus, CreateProcessArgumentCodec)->Apply(setCorpusArguments);
+BENCHMARK_TEMPLATE(BM_DecodeCorpus, TerminalArgumentCodec)->Apply(setCorpusArguments);
@@ -0,0 +1,96 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "BenchmarkUtils.h"
+#include "libargvcodec/Stats.h"
+
+#include <stdio.h>
+
+using namespace libargvcodec;
+
+static const char SPECIAL_CHARACTERS[] = " \"\\'&|^<>$`*";
+
+ArgumentList buildArguments(size_t iNumArguments, size_t iArgumentLength, int iEscapeDensity)
+{
+  //fixed seed linear congruential generator for reproducible arguments
+  unsigned int seed = 12345;
+
+  ArgumentList::StringList args;
+  args.push_back("benchmark.exe");
+  for(size_t i=0; i<iNumArguments; i++)
+  {
+    std::string arg;
+    arg.reserve(iArgumentLength);
+    for(size_t j=0; j<iArgumentLength; j++)
+    {
+      seed = seed * 1103515245 + 12345;
+      const unsigned int r = (seed >> 16);
+      if ((int)(r % 100) < iEscapeDensity)
+        arg += SPECIAL_CHARACTERS[r % (sizeof(SPECIAL_CHARACTERS) - 1)];
+      else
+        arg += (char)('a' + r % 26);
+    }
+    args.push_back(arg);
+  }
+
+  ArgumentList arglist;
+  arglist.init(args);
+  return arglist;
+}
+
+ArgumentList buildOptions(size_t iNumOptions)
+{
+  ArgumentList::StringList args;
+  args.push_back("benchmark.exe");
+  for(size_t i=0; i<iNumOptions; i++)
+  {
+    char option[64];
+    char value[64];
+    sprintf(option, "--option%d", (int)i);
+    sprintf(value, "--value%d=%d", (int)i, (int)i);
+    args.push_back(option);
+    args.push_back(value);
+  }
+
+  ArgumentList arglist;
+  arglist.init(args);
+  return arglist;
+}
+
+void resetStatsCounters()
+{
+  stats::resetCounters();
+}
+
+void setStatsCounters(benchmark::State & state)
+{
+  if (!stats::isEnabled())
+    return;
+
+  stats::Counters counters;
+  stats::getCounters(counters);
+  state.counters["allocs"] = benchmark::Counter((double)counters.allocations, benchmark::Counter::kAvgIterations);
+  state.counters["alloc_bytes"] = benchmark::Counter((double)counters.bytes, benchmark::Counter::kAvgIterations);
+  state.counters["argv_rebuilds"] = benchmark::Counter((double)counters.argvRebuilds, benchmark::Counter::kAvgIterations);
+}
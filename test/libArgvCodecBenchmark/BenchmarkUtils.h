@@ -0,0 +1,53 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef BENCHMARKUTILS_H
+#define BENCHMARKUTILS_H
+
+#include "libargvcodec/ArgumentList.h"
+
+#include <benchmark/benchmark.h>
+
+/// <summary>Builds a list of arguments for encoding benchmarks.</summary>
+/// <remarks>The arguments are always the same for the same parameters.</remarks>
+/// <param name="iNumArguments">The number of arguments, not including the executable name.</param>
+/// <param name="iArgumentLength">The length of each argument in bytes.</param>
+/// <param name="iEscapeDensity">The percentage (0 to 100) of characters of each argument which need to be escaped or quoted (spaces, quotes, backslashes and shell characters).</param>
+/// <returns>Returns the argument list. The first argument is the executable name.</returns>
+libargvcodec::ArgumentList buildArguments(size_t iNumArguments, size_t iArgumentLength, int iEscapeDensity);
+
+/// <summary>Builds a list of options and values for ArgumentList benchmarks.</summary>
+/// <remarks>The list contains the executable name followed by pairs of "--optionN" and "--valueN=N" arguments.</remarks>
+/// <param name="iNumOptions">The number of option and value pairs.</param>
+/// <returns>Returns the argument list.</returns>
+libargvcodec::ArgumentList buildOptions(size_t iNumOptions);
+
+/// <summary>Resets the allocation counters of the library. Call before the benchmark loop.</summary>
+void resetStatsCounters();
+
+/// <summary>Adds the average allocation counters of the library per iteration to the results of a benchmark. Call after the benchmark loop.</summary>
+/// <remarks>The counters are only added if the library is built with the LIBARGVCODEC_ENABLE_STATS option.</remarks>
+void setStatsCounters(benchmark::State & state);
+
+#endif //BENCHMARKUTILS_H
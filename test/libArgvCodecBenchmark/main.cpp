@@ -0,0 +1,117 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "rapidassist/gtesthelp.h"
+#include "libargvcodec/Tracing.h"
+
+static bool hasArgument(int argc, char* argv[], const char * iPrefix)
+{
+  for(int i=1; i<argc; i++)
+  {
+    if (strncmp(argv[i], iPrefix, strlen(iPrefix)) == 0)
+      return true;
+  }
+  return false;
+}
+
+static void onTraceEvent(const libargvcodec::tracing::Event & iEvent, void * /*iUserData*/)
+{
+  benchmark::DoNotOptimize(iEvent);
+}
+
+/// <summary>
+/// Enables the trace sink given with the --trace=callback or --trace=ringbuffer argument
+/// and the sampling interval given with the --trace_sampling=N argument. The arguments are removed.
+/// </summary>
+static bool enableTracing(std::vector<char*> & ioArgs)
+{
+  for(size_t i=1; i<ioArgs.size(); i++)
+  {
+    const char * value = ioArgs[i];
+    const bool isSampling = (strncmp(value, "--trace_sampling=", 17) == 0);
+    if (!isSampling && strncmp(value, "--trace=", 8) != 0)
+      continue;
+
+    if (!libargvcodec::tracing::isEnabled())
+    {
+      printf("The library is not built with the LIBARGVCODEC_ENABLE_TRACING option.\n");
+      return false;
+    }
+
+    value = strchr(value, '=') + 1;
+    if (isSampling)
+      libargvcodec::tracing::setSamplingInterval((size_t)atoi(value));
+    else if (strcmp(value, "callback") == 0)
+      libargvcodec::tracing::setCallback(&onTraceEvent, NULL);
+    else if (strcmp(value, "ringbuffer") == 0)
+      libargvcodec::tracing::setRingBufferEnabled(true); //events are dropped once the ring buffer is full
+    else
+    {
+      printf("Unknown trace sink '%s'.\n", value);
+      return false;
+    }
+    ioArgs.erase(ioArgs.begin() + i);
+    i--;
+  }
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  //save the results to a json file to allow comparing runs (see tools/compare.py of Google Benchmark)
+  std::string outputFile = "libargvcodecbenchmark";
+  if (ra::gtesthelp::isProcessorX86())
+    outputFile += ".x86";
+  else if (ra::gtesthelp::isProcessorX64())
+    outputFile += ".x64";
+  outputFile += (ra::gtesthelp::isDebugCode() ? ".debug.json" : ".release.json");
+
+  std::string outArgument = "--benchmark_out=" + outputFile;
+  std::string outFormatArgument = "--benchmark_out_format=json";
+
+  std::vector<char*> args(argv, argv + argc);
+  if (!enableTracing(args))
+    return 1;
+  if (!hasArgument(argc, argv, "--benchmark_out="))
+    args.push_back(&outArgument[0]);
+  if (!hasArgument(argc, argv, "--benchmark_out_format="))
+    args.push_back(&outFormatArgument[0]);
+  args.push_back(NULL);
+
+  int numArgs = (int)args.size() - 1;
+  benchmark::Initialize(&numArgs, &args[0]);
+  if (benchmark::ReportUnrecognizedArguments(numArgs, &args[0]))
+    return 1;
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
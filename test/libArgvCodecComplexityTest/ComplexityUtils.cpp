@@ -0,0 +1,154 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "ComplexityUtils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+#include <atomic>
+
+static std::atomic<bool> gCountingEnabled(false);
+static std::atomic<size_t> gNumAllocations(0);
+static std::atomic<size_t> gNumAllocatedBytes(0);
+
+static void * countedAlloc(size_t iSize)
+{
+  if (gCountingEnabled.load(std::memory_order_relaxed))
+  {
+    gNumAllocations.fetch_add(1, std::memory_order_relaxed);
+    gNumAllocatedBytes.fetch_add(iSize, std::memory_order_relaxed);
+  }
+  void * p = malloc(iSize == 0 ? 1 : iSize);
+  if (p == NULL)
+    throw std::bad_alloc();
+  return p;
+}
+
+//replace all global allocation functions of the executable.
+//the instrumented build of the library (LIBARGVCODEC_ENABLE_STATS) also replaces them in an object file which is not linked if all of them are defined here.
+void * operator new(size_t iSize)
+{
+  return countedAlloc(iSize);
+}
+
+void * operator new[](size_t iSize)
+{
+  return countedAlloc(iSize);
+}
+
+void * operator new(size_t iSize, const std::nothrow_t &) noexcept
+{
+  try
+  {
+    return countedAlloc(iSize);
+  }
+  catch(const std::bad_alloc &)
+  {
+    return NULL;
+  }
+}
+
+void * operator new[](size_t iSize, const std::nothrow_t &) noexcept
+{
+  try
+  {
+    return countedAlloc(iSize);
+  }
+  catch(const std::bad_alloc &)
+  {
+    return NULL;
+  }
+}
+
+void operator delete(void * p) noexcept
+{
+  free(p);
+}
+
+void operator delete[](void * p) noexcept
+{
+  free(p);
+}
+
+void operator delete(void * p, const std::nothrow_t &) noexcept
+{
+  free(p);
+}
+
+void operator delete[](void * p, const std::nothrow_t &) noexcept
+{
+  free(p);
+}
+
+void startCountingAllocations()
+{
+  gNumAllocations = 0;
+  gNumAllocatedBytes = 0;
+  gCountingEnabled = true;
+}
+
+void stopCountingAllocations(AllocationCounts & oCounts)
+{
+  gCountingEnabled = false;
+  oCounts.allocations = gNumAllocations;
+  oCounts.bytes = gNumAllocatedBytes;
+}
+
+static bool isLinearGrowth(size_t iPrevious, size_t iCurrent)
+{
+  //allow a few constant allocations when the previous count is very small
+  return (double)iCurrent <= 2.5 * (double)iPrevious + 4.0;
+}
+
+bool isLinear(ScaledOperation & iOperation, size_t iSize, std::string & oDetails)
+{
+  static const int NUM_SIZES = 4;
+
+  oDetails.clear();
+  bool linear = true;
+  AllocationCounts previous = {0, 0};
+  for(int i=0; i<NUM_SIZES; i++)
+  {
+    const size_t size = iSize << i;
+    iOperation.setup(size);
+
+    AllocationCounts counts;
+    startCountingAllocations();
+    iOperation.run();
+    stopCountingAllocations(counts);
+
+    char line[128];
+    sprintf(line, "size=%lu allocations=%lu bytes=%lu\n", (unsigned long)size, (unsigned long)counts.allocations, (unsigned long)counts.bytes);
+    oDetails += line;
+
+    if (i > 0)
+    {
+      linear = linear && isLinearGrowth(previous.allocations, counts.allocations);
+      linear = linear && isLinearGrowth(previous.bytes, counts.bytes);
+    }
+    previous = counts;
+  }
+  return linear;
+}
@@ -0,0 +1,69 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef COMPLEXITYUTILS_H
+#define COMPLEXITYUTILS_H
+
+#include <stddef.h>
+#include <string>
+
+/// <summary>Number of memory allocations and allocated bytes counted while measuring an operation.</summary>
+struct AllocationCounts
+{
+  size_t allocations;
+  size_t bytes;
+};
+
+/// <summary>Starts counting the allocations of all threads. The counters are reset.</summary>
+void startCountingAllocations();
+
+/// <summary>Stops counting allocations and returns the counters.</summary>
+void stopCountingAllocations(AllocationCounts & oCounts);
+
+/// <summary>An operation which can be measured with inputs of different sizes.</summary>
+class ScaledOperation
+{
+public:
+  virtual ~ScaledOperation() {}
+
+  /// <summary>Prepares the input of the operation. The allocations of this method are not counted.</summary>
+  /// <param name="iSize">The size of the input (number of arguments or number of bytes).</param>
+  virtual void setup(size_t iSize) = 0;
+
+  /// <summary>Runs the operation on the prepared input.</summary>
+  virtual void run() = 0;
+};
+
+/// <summary>
+/// Measures the allocations of an operation with inputs of size n, 2n, 4n and 8n.
+/// The growth is linear if doubling the input size does not increase the number of allocations
+/// and the number of allocated bytes by more than a factor of 2.5 (4 for quadratic growth).
+/// </summary>
+/// <param name="iOperation">The operation to measure.</param>
+/// <param name="iSize">The smallest input size (n).</param>
+/// <param name="oDetails">The counters measured at each size, for error messages.</param>
+/// <returns>Returns true if the growth is at most linear. Returns false otherwise.</returns>
+bool isLinear(ScaledOperation & iOperation, size_t iSize, std::string & oDetails);
+
+#endif //COMPLEXITYUTILS_H
@@ -0,0 +1,278 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "TestArgumentListComplexity.h"
+#include "ComplexityUtils.h"
+#include "libargvcodec/ArgumentList.h"
+
+#include <stdio.h>
+#include <memory>
+
+using namespace libargvcodec;
+
+//smallest number (n) of option and value pairs
+static const size_t LIST_INPUT_SIZE = 256;
+
+void TestArgumentListComplexity::SetUp()
+{
+}
+
+void TestArgumentListComplexity::TearDown()
+{
+}
+
+/// <summary>Base class of the ArgumentList operations. The list contains n pairs of "--optionN" and "--valueN=N" arguments followed by n pairs of "--next" and "value" arguments.</summary>
+/// <remarks>
+/// All options and all values have the same length to prevent the small string optimization from changing the number of allocations with the size of the list.
+/// The list is created again for each size since the capacity of the previous list would change the number of allocations.
+/// </remarks>
+class ArgumentListOperation : public ScaledOperation
+{
+public:
+  virtual void setup(size_t iSize)
+  {
+    mSize = iSize;
+    ArgumentList::StringList arguments;
+    arguments.push_back("foo.exe");
+    for(size_t i=0; i<iSize; i++)
+    {
+      char option[64];
+      char value[64];
+      sprintf(option, "--option%06d", (int)i);
+      sprintf(value, "--value%06d=%06d", (int)i, (int)i);
+      arguments.push_back(option);
+      arguments.push_back(value);
+    }
+    for(size_t i=0; i<iSize; i++)
+    {
+      arguments.push_back("--next");
+      arguments.push_back("value");
+    }
+    mArguments.reset(new ArgumentList());
+    mArguments->init(arguments);
+  }
+
+protected:
+  size_t mSize;
+  std::unique_ptr<ArgumentList> mArguments;
+};
+
+class InitOperation : public ArgumentListOperation
+{
+public:
+  virtual void run()
+  {
+    ArgumentList copy;
+    copy.init(mArguments->getArgc(), mArguments->getArgv());
+  }
+};
+
+class CopyOperation : public ArgumentListOperation
+{
+public:
+  virtual void run()
+  {
+    ArgumentList copy(*mArguments);
+  }
+};
+
+class FindIndexOperation : public ArgumentListOperation
+{
+public:
+  virtual void run()
+  {
+    mArguments->findIndex("--missing", false);
+  }
+};
+
+class FindOptionOperation : public ArgumentListOperation
+{
+public:
+  virtual void run()
+  {
+    mArguments->findOption("--missing");
+  }
+};
+
+class FindValueOperation : public ArgumentListOperation
+{
+public:
+  virtual void run()
+  {
+    int index = 0;
+    std::string value;
+    mArguments->findValue("--missing=", index, value);
+  }
+};
+
+class FindNextValueOperation : public ArgumentListOperation
+{
+public:
+  virtual void run()
+  {
+    int index = 0;
+    std::string value;
+    mArguments->findNextValue("--next", index, value);
+  }
+};
+
+class ExtractOptionOperation : public ArgumentListOperation
+{
+public:
+  virtual void run()
+  {
+    mArguments->extractOption("--option000000");
+  }
+};
+
+class ExtractValueOperation : public ArgumentListOperation
+{
+public:
+  virtual void run()
+  {
+    std::string value;
+    mArguments->extractValue("--value000000=", value);
+  }
+};
+
+class ExtractNextValueOperation : public ArgumentListOperation
+{
+public:
+  virtual void run()
+  {
+    std::string value;
+    mArguments->extractNextValue("--next", value);
+  }
+};
+
+/// <summary>Extracts all options in a loop like an application parsing its command line.</summary>
+class RepeatedExtractOptionOperation : public ArgumentListOperation
+{
+public:
+  virtual void run()
+  {
+    for(size_t i=0; i<mSize; i++)
+    {
+      char option[64];
+      sprintf(option, "--option%06d", (int)i);
+      mArguments->extractOption(option);
+    }
+  }
+};
+
+class RepeatedExtractValueOperation : public ArgumentListOperation
+{
+public:
+  virtual void run()
+  {
+    std::string value;
+    for(size_t i=0; i<mSize; i++)
+    {
+      char name[64];
+      sprintf(name, "--value%06d=", (int)i);
+      mArguments->extractValue(name, value);
+    }
+  }
+};
+
+class RepeatedExtractNextValueOperation : public ArgumentListOperation
+{
+public:
+  virtual void run()
+  {
+    std::string value;
+    while(mArguments->extractNextValue("--next", value))
+    {
+    }
+  }
+};
+
+class InsertOperation : public ArgumentListOperation
+{
+public:
+  virtual void run()
+  {
+    mArguments->insert(1, "--inserted");
+  }
+};
+
+class RemoveOperation : public ArgumentListOperation
+{
+public:
+  virtual void run()
+  {
+    mArguments->remove(1);
+  }
+};
+
+class ReplaceOperation : public ArgumentListOperation
+{
+public:
+  virtual void run()
+  {
+    mArguments->replace(1, "--replaced");
+  }
+};
+
+#define ASSERT_LINEAR(operation) \
+  { \
+    operation op; \
+    std::string details; \
+    ASSERT_TRUE(isLinear(op, LIST_INPUT_SIZE, details)) << #operation << "\n" << details; \
+  }
+
+TEST_F(TestArgumentListComplexity, testConstruction)
+{
+  ASSERT_LINEAR(InitOperation);
+  ASSERT_LINEAR(CopyOperation);
+}
+
+TEST_F(TestArgumentListComplexity, testFind)
+{
+  ASSERT_LINEAR(FindIndexOperation);
+  ASSERT_LINEAR(FindOptionOperation);
+  ASSERT_LINEAR(FindValueOperation);
+  ASSERT_LINEAR(FindNextValueOperation);
+}
+
+TEST_F(TestArgumentListComplexity, testExtract)
+{
+  ASSERT_LINEAR(ExtractOptionOperation);
+  ASSERT_LINEAR(ExtractValueOperation);
+  ASSERT_LINEAR(ExtractNextValueOperation);
+}
+
+TEST_F(TestArgumentListComplexity, testRepeatedExtract)
+{
+  ASSERT_LINEAR(RepeatedExtractOptionOperation);
+  ASSERT_LINEAR(RepeatedExtractValueOperation);
+  ASSERT_LINEAR(RepeatedExtractNextValueOperation);
+}
+
+TEST_F(TestArgumentListComplexity, testModify)
+{
+  ASSERT_LINEAR(InsertOperation);
+  ASSERT_LINEAR(RemoveOperation);
+  ASSERT_LINEAR(ReplaceOperation);
+}
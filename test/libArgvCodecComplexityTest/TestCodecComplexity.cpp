@@ -0,0 +1,231 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "TestCodecComplexity.h"
+#include "ComplexityUtils.h"
+#include "CorpusGenerator.h"
+#include "libargvcodec/CmdPromptArgumentCodec.h"
+#include "libargvcodec/CreateProcessArgumentCodec.h"
+#include "libargvcodec/TerminalArgumentCodec.h"
+
+using namespace libargvcodec;
+
+//smallest size (n) of the inputs in bytes
+static const size_t CODEC_INPUT_SIZE = 4096;
+static const uint64_t CORPUS_SEED = 41;
+
+void TestCodecComplexity::SetUp()
+{
+}
+
+void TestCodecComplexity::TearDown()
+{
+}
+
+static ArgumentList generateArguments(CorpusGenerator::Kind iKind, size_t iSize)
+{
+  CorpusGenerator generator(CORPUS_SEED);
+  CorpusGenerator::StringList arguments;
+  generator.generate(iKind, iSize, arguments);
+  arguments.insert(arguments.begin(), "foo.exe");
+
+  ArgumentList arglist;
+  arglist.init(arguments);
+  return arglist;
+}
+
+template <typename Codec>
+class EncodeArgumentOperation : public ScaledOperation
+{
+public:
+  virtual void setup(size_t iSize)
+  {
+    mArguments = generateArguments(CorpusGenerator::HUGE_ARGUMENT, iSize);
+  }
+  virtual void run()
+  {
+    mCodec.encodeArgument(mArguments.getArgument(1));
+  }
+private:
+  const Codec mCodec;
+  ArgumentList mArguments;
+};
+
+template <typename Codec>
+class EncodeCommandLineOperation : public ScaledOperation
+{
+public:
+  EncodeCommandLineOperation(CorpusGenerator::Kind iKind) : mKind(iKind) {}
+  virtual void setup(size_t iSize)
+  {
+    mArguments = generateArguments(mKind, iSize);
+  }
+  virtual void run()
+  {
+    mCodec.encodeCommandLine(mArguments);
+  }
+private:
+  const Codec mCodec;
+  const CorpusGenerator::Kind mKind;
+  ArgumentList mArguments;
+};
+
+template <typename Codec>
+class DecodeArgumentOperation : public ScaledOperation
+{
+public:
+  virtual void setup(size_t iSize)
+  {
+    ArgumentList arglist = generateArguments(CorpusGenerator::HUGE_ARGUMENT, iSize);
+    mCmdLine = mCodec.encodeArgument(arglist.getArgument(1));
+  }
+  virtual void run()
+  {
+    mCodec.decodeArgument(mCmdLine.c_str());
+  }
+private:
+  const Codec mCodec;
+  std::string mCmdLine;
+};
+
+template <typename Codec>
+class DecodeCommandLineOperation : public ScaledOperation
+{
+public:
+  DecodeCommandLineOperation(CorpusGenerator::Kind iKind) : mKind(iKind) {}
+  virtual void setup(size_t iSize)
+  {
+    mCmdLine = mCodec.encodeCommandLine(generateArguments(mKind, iSize));
+  }
+  virtual void run()
+  {
+    mCodec.decodeCommandLine(mCmdLine.c_str());
+  }
+private:
+  const Codec mCodec;
+  const CorpusGenerator::Kind mKind;
+  std::string mCmdLine;
+};
+
+template <typename Codec>
+class DecodeBatchOperation : public ScaledOperation
+{
+public:
+  virtual void setup(size_t iSize)
+  {
+    //iSize command lines of a few arguments
+    CorpusGenerator generator(CORPUS_SEED);
+    mCmdLines.clear();
+    for(size_t i=0; i<iSize / 16; i++)
+    {
+      CorpusGenerator::StringList arguments;
+      generator.generate(CorpusGenerator::COMPILER_INVOCATION, 64, arguments);
+      arguments.insert(arguments.begin(), "foo.exe");
+      ArgumentList arglist;
+      arglist.init(arguments);
+      mCmdLines.push_back(mCodec.encodeCommandLine(arglist));
+    }
+    mPointers.clear();
+    for(size_t i=0; i<mCmdLines.size(); i++)
+    {
+      mPointers.push_back(mCmdLines[i].c_str());
+    }
+  }
+  virtual void run()
+  {
+    DecodedCommandLines decoded;
+    mCodec.decodeBatch(&mPointers[0], mPointers.size(), decoded, 1);
+  }
+private:
+  const Codec mCodec;
+  std::vector<std::string> mCmdLines;
+  std::vector<const char *> mPointers;
+};
+
+/// <summary>Allocates n*n bytes. Used for validating the detection of super-linear growth.</summary>
+class QuadraticOperation : public ScaledOperation
+{
+public:
+  virtual void setup(size_t iSize)
+  {
+    mSize = iSize;
+  }
+  virtual void run()
+  {
+    for(size_t i=0; i<mSize; i++)
+    {
+      std::string value(mSize, 'a');
+    }
+  }
+private:
+  size_t mSize;
+};
+
+TEST_F(TestCodecComplexity, testQuadraticGrowthDetection)
+{
+  QuadraticOperation op;
+  std::string details;
+  ASSERT_FALSE(isLinear(op, 256, details)) << details;
+}
+
+template <typename Codec>
+void testCodecComplexity(const char * iCodecName)
+{
+  std::string details;
+
+  EncodeArgumentOperation<Codec> encodeArgument;
+  ASSERT_TRUE(isLinear(encodeArgument, CODEC_INPUT_SIZE, details)) << iCodecName << "::encodeArgument()\n" << details;
+
+  DecodeArgumentOperation<Codec> decodeArgument;
+  ASSERT_TRUE(isLinear(decodeArgument, CODEC_INPUT_SIZE, details)) << iCodecName << "::decodeArgument()\n" << details;
+
+  DecodeBatchOperation<Codec> decodeBatch;
+  ASSERT_TRUE(isLinear(decodeBatch, CODEC_INPUT_SIZE, details)) << iCodecName << "::decodeBatch()\n" << details;
+
+  for(int k=0; k<CorpusGenerator::NUM_KINDS; k++)
+  {
+    const CorpusGenerator::Kind kind = (CorpusGenerator::Kind)k;
+
+    EncodeCommandLineOperation<Codec> encodeCommandLine(kind);
+    ASSERT_TRUE(isLinear(encodeCommandLine, CODEC_INPUT_SIZE, details)) << iCodecName << "::encodeCommandLine() with " << CorpusGenerator::getKindName(kind) << " arguments\n" << details;
+
+    DecodeCommandLineOperation<Codec> decodeCommandLine(kind);
+    ASSERT_TRUE(isLinear(decodeCommandLine, CODEC_INPUT_SIZE, details)) << iCodecName << "::decodeCommandLine() with " << CorpusGenerator::getKindName(kind) << " arguments\n" << details;
+  }
+}
+
+TEST_F(TestCodecComplexity, testCmdPromptArgumentCodec)
+{
+  testCodecComplexity<CmdPromptArgumentCodec>("CmdPromptArgumentCodec");
+}
+
+TEST_F(TestCodecComplexity, testCreateProcessArgumentCodec)
+{
+  testCodecComplexity<CreateProcessArgumentCodec>("CreateProcessArgumentCodec");
+}
+
+TEST_F(TestCodecComplexity, testTerminalArgumentCodec)
+{
+  testCodecComplexity<TerminalArgumentCodec>("TerminalArgumentCodec");
+}
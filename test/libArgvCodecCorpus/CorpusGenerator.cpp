@@ -0,0 +1,259 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "CorpusGenerator.h"
+
+#include <stdio.h>
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof(a[0]))
+
+static const char * gKindNames[] = {
+  "compiler",
+  "paths",
+  "adversarial",
+  "huge",
+  "mixed",
+};
+
+static const char * gWords[] = {
+  "src", "include", "lib", "build", "common", "core", "utils", "net", "io", "render",
+  "Program Files", "My Documents", "third party", "x64", "Release", "Debug", "obj", "gen",
+};
+
+static const char * gExtensions[] = {
+  ".cpp", ".h", ".c", ".o", ".obj", ".txt", ".json", "",
+};
+
+static const char * gUnixFlags[] = {
+  "-O2", "-O3", "-g", "-Wall", "-Wextra", "-Werror", "-fPIC", "-std=c++11", "-pthread", "-c",
+};
+
+static const char * gWindowsFlags[] = {
+  "/O2", "/Od", "/Zi", "/W4", "/WX", "/EHsc", "/MD", "/MT", "/nologo", "/c",
+};
+
+static const char gAdversarialCharacters[] = "\"\"\"\\\\\\\\  \t'&|^<>$`*()%!;";
+
+CorpusGenerator::CorpusGenerator(uint64_t iSeed)
+{
+  setSeed(iSeed);
+}
+
+void CorpusGenerator::setSeed(uint64_t iSeed)
+{
+  mState = iSeed;
+}
+
+const char * CorpusGenerator::getKindName(Kind iKind)
+{
+  if (iKind < 0 || iKind >= NUM_KINDS)
+    return NULL;
+  return gKindNames[iKind];
+}
+
+uint64_t CorpusGenerator::next()
+{
+  //SplitMix64
+  uint64_t z = (mState += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+size_t CorpusGenerator::nextIndex(size_t iMax)
+{
+  return (size_t)(next() % iMax);
+}
+
+bool CorpusGenerator::nextPercent(int iPercent)
+{
+  return (int)nextIndex(100) < iPercent;
+}
+
+const char * CorpusGenerator::pick(const char * const * iValues, size_t iCount)
+{
+  return iValues[nextIndex(iCount)];
+}
+
+std::string CorpusGenerator::nextIdentifier(size_t iMinLength, size_t iMaxLength)
+{
+  const size_t length = iMinLength + nextIndex(iMaxLength - iMinLength + 1);
+  std::string identifier;
+  for(size_t i=0; i<length; i++)
+  {
+    const size_t r = nextIndex(36);
+    identifier += (char)(r < 26 ? 'a' + r : '0' + (r - 26));
+  }
+  return identifier;
+}
+
+std::string CorpusGenerator::nextUnixPath()
+{
+  std::string path = (nextPercent(50) ? "/home/" : "./");
+  const size_t depth = 1 + nextIndex(6);
+  for(size_t i=0; i<depth; i++)
+  {
+    path += (nextPercent(70) ? nextIdentifier(2, 10) : std::string(pick(gWords, ARRAY_SIZE(gWords))));
+    path += '/';
+  }
+  path += nextIdentifier(3, 12);
+  path += pick(gExtensions, ARRAY_SIZE(gExtensions));
+  return path;
+}
+
+std::string CorpusGenerator::nextWindowsPath()
+{
+  std::string path = (nextPercent(80) ? "C:\\" : "\\\\server\\share\\");
+  const size_t depth = 1 + nextIndex(6);
+  for(size_t i=0; i<depth; i++)
+  {
+    path += (nextPercent(70) ? nextIdentifier(2, 10) : std::string(pick(gWords, ARRAY_SIZE(gWords))));
+    path += '\\';
+  }
+
+  //directories end with a backslash which must be escaped before a closing quote
+  if (nextPercent(20))
+    return path;
+
+  path += nextIdentifier(3, 12);
+  path += pick(gExtensions, ARRAY_SIZE(gExtensions));
+  return path;
+}
+
+std::string CorpusGenerator::nextCompilerArgument(bool iWindows)
+{
+  char buffer[64];
+  switch(nextIndex(6))
+  {
+  case 0:
+    return (iWindows ? "/I" + nextWindowsPath() : "-I" + nextUnixPath());
+  case 1:
+    sprintf(buffer, "%d", (int)nextIndex(1000));
+    return (iWindows ? "/D" : "-D") + nextIdentifier(4, 16) + "=" + buffer;
+  case 2:
+    //string defines require quotes in the value
+    return (iWindows ? "/D" : "-D") + nextIdentifier(4, 16) + "=\"" + nextIdentifier(2, 8) + " " + nextIdentifier(2, 8) + "\"";
+  case 3:
+    return (iWindows ? pick(gWindowsFlags, ARRAY_SIZE(gWindowsFlags)) : pick(gUnixFlags, ARRAY_SIZE(gUnixFlags)));
+  case 4:
+    return (iWindows ? "/Fo" + nextWindowsPath() : "-o" + nextUnixPath());
+  default:
+    return (iWindows ? nextWindowsPath() : nextUnixPath());
+  };
+}
+
+std::string CorpusGenerator::nextPathArgument()
+{
+  return (nextPercent(50) ? nextWindowsPath() : nextUnixPath());
+}
+
+std::string CorpusGenerator::nextAdversarialArgument()
+{
+  const size_t length = nextIndex(32);
+  std::string argument;
+  for(size_t i=0; i<length; i++)
+  {
+    const size_t r = nextIndex(100);
+    if (r < 20)
+    {
+      //runs of backslashes followed by a double quote
+      argument.append(1 + nextIndex(5), '\\');
+      argument += '"';
+    }
+    else if (r < 80)
+      argument += gAdversarialCharacters[nextIndex(sizeof(gAdversarialCharacters) - 1)];
+    else
+      argument += (char)('a' + nextIndex(26));
+  }
+  return argument;
+}
+
+std::string CorpusGenerator::nextHugeArgument(size_t iSize)
+{
+  std::string argument;
+  argument.reserve(iSize);
+  while(argument.size() < iSize)
+  {
+    const size_t r = nextIndex(100);
+    if (r < 90)
+      argument += (char)('a' + nextIndex(26));
+    else if (r < 95)
+      argument += ' ';
+    else if (r < 98)
+      argument += '\\';
+    else
+      argument += '"';
+  }
+  return argument;
+}
+
+void CorpusGenerator::generate(Kind iKind, size_t iSize, StringList & oArguments)
+{
+  oArguments.clear();
+  if (iKind == HUGE_ARGUMENT)
+  {
+    oArguments.push_back(nextHugeArgument(iSize));
+    return;
+  }
+
+  const bool windows = nextPercent(50);
+  size_t size = 0;
+  while(size < iSize)
+  {
+    Kind kind = iKind;
+    if (kind == MIXED)
+      kind = (Kind)nextIndex(HUGE_ARGUMENT + 1);
+
+    std::string argument;
+    switch(kind)
+    {
+    case COMPILER_INVOCATION:
+      argument = nextCompilerArgument(windows);
+      break;
+    case PATH_LIST:
+      argument = nextPathArgument();
+      break;
+    case HUGE_ARGUMENT:
+      //keep huge arguments of mixed command lines at a fraction of the requested size
+      argument = nextHugeArgument(iSize / 4 + 1);
+      break;
+    default:
+      argument = nextAdversarialArgument();
+      break;
+    };
+
+    size += argument.size() + 1; //count the argument separator
+    oArguments.push_back(argument);
+  }
+}
+
+void CorpusGenerator::generateCorpus(Kind iKind, size_t iCount, size_t iSize, StringListArray & oCorpus)
+{
+  oCorpus.clear();
+  oCorpus.resize(iCount);
+  for(size_t i=0; i<iCount; i++)
+  {
+    generate(iKind, iSize, oCorpus[i]);
+  }
+}
@@ -0,0 +1,102 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef CORPUSGENERATOR_H
+#define CORPUSGENERATOR_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Deterministic generator of realistic command lines for tests and benchmarks.
+/// The same seed always generates the same arguments on all platforms and compilers.
+/// </summary>
+/// <remarks>
+/// The generator uses its own pseudo-random number generator (SplitMix64) instead of the standard
+/// distributions because the latter are implementation defined.
+/// The generated arguments never contain NULL, \r or \n characters.
+/// </remarks>
+class CorpusGenerator
+{
+public:
+  typedef std::vector<std::string> StringList;
+  typedef std::vector<StringList> StringListArray;
+
+  enum Kind
+  {
+    /// <summary>Compiler invocations with include paths, defines, flags and source files.</summary>
+    COMPILER_INVOCATION,
+    /// <summary>Long lists of Windows and Unix paths, some with spaces and trailing backslashes.</summary>
+    PATH_LIST,
+    /// <summary>Arguments dense in quotes, backslashes, whitespace and shell characters.</summary>
+    ADVERSARIAL,
+    /// <summary>A single huge argument.</summary>
+    HUGE_ARGUMENT,
+    /// <summary>A mix of arguments of all other kinds.</summary>
+    MIXED,
+    NUM_KINDS
+  };
+
+  /// <summary>Creates a generator.</summary>
+  /// <param name="iSeed">The seed of the generator.</param>
+  CorpusGenerator(uint64_t iSeed);
+
+  /// <summary>Restarts the sequence of the generator with the given seed.</summary>
+  void setSeed(uint64_t iSeed);
+
+  /// <summary>Returns the name of the given kind of command line. Returns NULL if iKind is out of range.</summary>
+  static const char * getKindName(Kind iKind);
+
+  /// <summary>Generates the arguments of a single command line.</summary>
+  /// <param name="iKind">The kind of command line.</param>
+  /// <param name="iSize">The approximate size of all arguments in bytes. The arguments are at least iSize bytes long.</param>
+  /// <param name="oArguments">The generated arguments, not including the executable name.</param>
+  void generate(Kind iKind, size_t iSize, StringList & oArguments);
+
+  /// <summary>Generates multiple command lines of the given kind.</summary>
+  /// <param name="iKind">The kind of command lines.</param>
+  /// <param name="iCount">The number of command lines.</param>
+  /// <param name="iSize">The approximate size of the arguments of each command line in bytes.</param>
+  /// <param name="oCorpus">The generated command lines.</param>
+  void generateCorpus(Kind iKind, size_t iCount, size_t iSize, StringListArray & oCorpus);
+
+private:
+  uint64_t next();
+  size_t nextIndex(size_t iMax);
+  bool nextPercent(int iPercent);
+  const char * pick(const char * const * iValues, size_t iCount);
+
+  std::string nextIdentifier(size_t iMinLength, size_t iMaxLength);
+  std::string nextUnixPath();
+  std::string nextWindowsPath();
+  std::string nextCompilerArgument(bool iWindows);
+  std::string nextPathArgument();
+  std::string nextAdversarialArgument();
+  std::string nextHugeArgument(size_t iSize);
+
+  uint64_t mState;
+};
+
+#endif //CORPUSGENERATOR_H
@@ -0,0 +1,170 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "TestArgDecoder.h"
+#include "libargvcodec/ArgumentList.h"
+#include "libargvcodec/TerminalArgumentCodec.h"
+#include "TestUtils.h"
+
+#include <cstdio>
+
+using namespace libargvcodec;
+
+static const char * gInputFile = "argdecoder.input.tmp";
+
+void TestArgDecoder::SetUp()
+{
+}
+
+void TestArgDecoder::TearDown()
+{
+  remove(gInputFile);
+}
+
+#ifndef _WIN32
+/// <summary>Runs argdecoder with the terminal dialect on the given input.</summary>
+static bool runDecoder(const std::string & iInput, const char * iDelimiter, const char * iFormat, const char * iThreads, std::string & oOutput, int & oExitCode)
+{
+  if (!writeBinaryFile(gInputFile, iInput))
+    return false;
+
+  ra::strings::StringVector arguments;
+  arguments.push_back(std::string("--input=") + gInputFile);
+  arguments.push_back("--dialect=terminal");
+  arguments.push_back(std::string("--delimiter=") + iDelimiter);
+  arguments.push_back(std::string("--format=") + iFormat);
+  arguments.push_back(std::string("--threads=") + iThreads);
+  return runTool("argdecoder", arguments, oOutput, oExitCode);
+}
+
+TEST_F(TestArgDecoder, testCountFraming)
+{
+  //each command line starts with its number of arguments, which makes empty arguments and empty command lines unambiguous
+  std::string output;
+  int exit_code = -1;
+  ASSERT_TRUE( runDecoder("a \"\"\n\n'b c'\n", "newline", "nul", "1", output, exit_code) );
+  ASSERT_EQ(0, exit_code);
+
+  std::string expected;
+  expected.append("2\0a\0\0", 5);
+  expected.append("0\0", 2);
+  expected.append("1\0b c\0", 6);
+  ASSERT_EQ(expected, output);
+}
+
+TEST_F(TestArgDecoder, testDelimiters)
+{
+  std::string output;
+  int exit_code = -1;
+
+  //CRLF line endings are stripped and the last command line does not require a delimiter
+  ASSERT_TRUE( runDecoder("a b\r\nc\r\nd", "newline", "nul", "1", output, exit_code) );
+  ASSERT_EQ(0, exit_code);
+  std::string expected;
+  expected.append("2\0a\0b\0", 6);
+  expected.append("1\0c\0", 4);
+  expected.append("1\0d\0", 4);
+  ASSERT_EQ(expected, output);
+
+  //newlines and carriage returns are part of the command lines with the nul delimiter
+  ASSERT_TRUE( runDecoder(std::string("'a\nb\r'\0c\0", 9), "nul", "nul", "1", output, exit_code) );
+  ASSERT_EQ(0, exit_code);
+  expected.clear();
+  expected.append("1\0a\nb\r\0", 7);
+  expected.append("1\0c\0", 4);
+  ASSERT_EQ(expected, output);
+}
+
+TEST_F(TestArgDecoder, testJsonFormat)
+{
+  //control characters are escaped and bytes which are not valid UTF-8 are replaced by U+FFFD
+  std::string output;
+  int exit_code = -1;
+  ASSERT_TRUE( runDecoder("a \"b\\\"c\" 'd\te' \xff\xc3\xa9 \xc3\n\n", "newline", "json", "1", output, exit_code) );
+  ASSERT_EQ(0, exit_code);
+  ASSERT_EQ(std::string("[\"a\",\"b\\\"c\",\"d\\te\",\"\\ufffd\xc3\xa9\",\"\\ufffd\"]\n[]\n"), output);
+}
+
+TEST_F(TestArgDecoder, testLongCommandLine)
+{
+  //a command line longer than multiple reads of the input
+  static const size_t LONG_ARGUMENT_SIZE = 3*1024*1024 + 17;
+  const std::string long_argument(LONG_ARGUMENT_SIZE, 'x');
+
+  std::string input;
+  input.append(long_argument).append(" y\n");
+  input.append("z\n");
+
+  std::string output;
+  int exit_code = -1;
+  ASSERT_TRUE( runDecoder(input, "newline", "nul", "1", output, exit_code) );
+  ASSERT_EQ(0, exit_code);
+
+  std::string expected;
+  expected.append("2", 2);
+  expected.append(long_argument).append(1, '\0');
+  expected.append("y", 2);
+  expected.append("1\0z\0", 4);
+  ASSERT_TRUE( expected == output );
+}
+
+TEST_F(TestArgDecoder, testMultipleBatches)
+{
+  //more command lines than a single batch, decoded with one and multiple threads
+  static const size_t NUM_COMMAND_LINES = 40000;
+  TerminalArgumentCodec codec;
+
+  std::string input;
+  std::string expected;
+  for(size_t i=0; i<NUM_COMMAND_LINES; i++)
+  {
+    char value[64];
+    sprintf(value, "value %d", (int)i);
+
+    ArgumentList arguments;
+    arguments.insert("foo");
+    arguments.insert(value);
+    arguments.insert("a\"b");
+    input.append(codec.encodeCommandLine(arguments)).append(1, '\n');
+
+    //the first argument is not part of the command line
+    expected.append("2", 2);
+    for(int j=1; j<arguments.getArgc(); j++)
+    {
+      expected.append(arguments.getArgument(j));
+      expected.append(1, '\0');
+    }
+  }
+
+  std::string output;
+  int exit_code = -1;
+  ASSERT_TRUE( runDecoder(input, "newline", "nul", "1", output, exit_code) );
+  ASSERT_EQ(0, exit_code);
+  ASSERT_TRUE( expected == output );
+
+  ASSERT_TRUE( runDecoder(input, "newline", "nul", "4", output, exit_code) );
+  ASSERT_EQ(0, exit_code);
+  ASSERT_TRUE( expected == output );
+}
+#endif //_WIN32
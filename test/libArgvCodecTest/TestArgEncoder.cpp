@@ -0,0 +1,150 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "TestArgEncoder.h"
+#include "libargvcodec/ArgumentList.h"
+#include "libargvcodec/CmdPromptArgumentCodec.h"
+#include "libargvcodec/CreateProcessArgumentCodec.h"
+#include "libargvcodec/TerminalArgumentCodec.h"
+#include "TestUtils.h"
+
+#include <cstdio>
+
+using namespace libargvcodec;
+
+static const char * gInputFile = "argencoder.input.tmp";
+
+void TestArgEncoder::SetUp()
+{
+}
+
+void TestArgEncoder::TearDown()
+{
+  remove(gInputFile);
+}
+
+#ifndef _WIN32
+/// <summary>Runs argencoder in batch mode on the given input.</summary>
+static bool runBatch(const std::string & iInput, const char * iDialect, const char * iDelimiter, const char * iThreads, std::string & oOutput, int & oExitCode)
+{
+  if (!writeBinaryFile(gInputFile, iInput))
+    return false;
+
+  ra::strings::StringVector arguments;
+  arguments.push_back("--batch");
+  arguments.push_back(std::string("--input=") + gInputFile);
+  arguments.push_back(std::string("--dialect=") + iDialect);
+  arguments.push_back(std::string("--delimiter=") + iDelimiter);
+  arguments.push_back(std::string("--threads=") + iThreads);
+  return runTool("argencoder", arguments, oOutput, oExitCode);
+}
+
+TEST_F(TestArgEncoder, testBatchCountFraming)
+{
+  //argument lists framed like the nul output of argdecoder, including empty arguments and an empty list
+  std::string input;
+  input.append("2\0a\0\0", 5);
+  input.append("0\0", 2);
+  input.append("1\0b c\0", 6);
+
+  std::string output;
+  int exit_code = -1;
+  ASSERT_TRUE( runBatch(input, "terminal", "nul", "1", output, exit_code) );
+  ASSERT_EQ(0, exit_code);
+
+  std::string expected;
+  expected.append("a \"\"\0", 5);
+  expected.append("\0", 1);
+  expected.append("\"b c\"\0", 6);
+  ASSERT_EQ(expected, output);
+}
+
+TEST_F(TestArgEncoder, testBatchNewlineDelimiter)
+{
+  //CRLF line endings are tolerated and the last argument does not require a delimiter
+  std::string output;
+  int exit_code = -1;
+  ASSERT_TRUE( runBatch("2\r\na\r\nb\n1\nc", "terminal", "newline", "1", output, exit_code) );
+  ASSERT_EQ(0, exit_code);
+  ASSERT_EQ(std::string("a b\nc\n"), output);
+}
+
+TEST_F(TestArgEncoder, testBatchInvalidInput)
+{
+  std::string output;
+  int exit_code = -1;
+
+  //truncated argument list
+  ASSERT_TRUE( runBatch(std::string("2\0a\0", 4), "terminal", "nul", "1", output, exit_code) );
+  ASSERT_NE(0, exit_code);
+
+  //invalid argument count
+  ASSERT_TRUE( runBatch(std::string("a\0", 2), "terminal", "nul", "1", output, exit_code) );
+  ASSERT_NE(0, exit_code);
+}
+
+TEST_F(TestArgEncoder, testBatchAllDialects)
+{
+  //more argument lists than a single batch. The command lines of the three dialects are interleaved for each list.
+  static const size_t NUM_LISTS = 10000;
+  CmdPromptArgumentCodec cmdPrompt;
+  CreateProcessArgumentCodec createProcess;
+  TerminalArgumentCodec terminal;
+
+  std::string input;
+  std::string expected;
+  for(size_t i=0; i<NUM_LISTS; i++)
+  {
+    char value[64];
+    sprintf(value, "value %d", (int)i);
+
+    ArgumentList arguments;
+    arguments.insert("foo.exe");
+    arguments.insert(value);
+    arguments.insert("a\"b");
+    arguments.insert("");
+
+    input.append("3\0", 2);
+    for(int j=1; j<arguments.getArgc(); j++)
+    {
+      input.append(arguments.getArgument(j));
+      input.append(1, '\0');
+    }
+
+    expected.append(cmdPrompt.encodeCommandLine(arguments)).append(1, '\0');
+    expected.append(createProcess.encodeCommandLine(arguments)).append(1, '\0');
+    expected.append(terminal.encodeCommandLine(arguments)).append(1, '\0');
+  }
+
+  std::string output;
+  int exit_code = -1;
+  ASSERT_TRUE( runBatch(input, "all", "nul", "1", output, exit_code) );
+  ASSERT_EQ(0, exit_code);
+  ASSERT_TRUE( expected == output );
+
+  ASSERT_TRUE( runBatch(input, "all", "nul", "4", output, exit_code) );
+  ASSERT_EQ(0, exit_code);
+  ASSERT_TRUE( expected == output );
+}
+#endif //_WIN32
@@ -0,0 +1,140 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "TestArgumentStreamEncoder.h"
+#include "libargvcodec/ArgumentStreamEncoder.h"
+#include "libargvcodec/CallbackOutputSink.h"
+#include "libargvcodec/FileOutputSink.h"
+#include "libargvcodec/CmdPromptArgumentCodec.h"
+#include "libargvcodec/CreateProcessArgumentCodec.h"
+#include "libargvcodec/TerminalArgumentCodec.h"
+#include "TestUtils.h"
+
+using namespace libargvcodec;
+
+void TestArgumentStreamEncoder::SetUp()
+{
+}
+
+void TestArgumentStreamEncoder::TearDown()
+{
+}
+
+bool appendToString(const char * iBuffer, size_t iLength, void * iUserData)
+{
+  std::string * str = (std::string *)iUserData;
+  str->append(iBuffer, iLength);
+  return true;
+}
+
+void testEncoderTestFile(IArgumentEncoder & iEncoder, const std::string & iTestFile)
+{
+  TEST_DATA_LIST items;
+  bool file_loaded = loadCommandLineTestFile(iTestFile, items);
+  ASSERT_TRUE( file_loaded );
+
+  for(size_t i=0; i<items.size(); i++)
+  {
+    const TEST_DATA & td = items[i];
+
+    //build an ArgumentList
+    ArgumentList arglist;
+    {
+      ra::strings::StringVector tmp_arguments = td.arguments;
+      tmp_arguments.insert(tmp_arguments.begin(), "showargs");
+      arglist.init(tmp_arguments);
+    }
+
+    std::string expected_cmdline = iEncoder.encodeCommandLine(arglist);
+
+    //use a tiny buffer to force multiple writes per argument
+    std::string actual_cmdline;
+    {
+      CallbackOutputSink sink(&appendToString, &actual_cmdline, 3);
+      ArgumentStreamEncoder encoder(iEncoder, sink);
+      ASSERT_TRUE( encoder.encodeCommandLine(arglist) );
+      ASSERT_TRUE( encoder.flush() );
+    }
+
+    ASSERT_EQ(expected_cmdline, actual_cmdline);
+  }
+}
+
+TEST_F(TestArgumentStreamEncoder, testEncodeCommandLine_testfile)
+{
+  CmdPromptArgumentCodec cmdprompt;
+  testEncoderTestFile(cmdprompt, "Test.CommandLines.Windows.txt");
+
+  CreateProcessArgumentCodec createprocess;
+  testEncoderTestFile(createprocess, "Test.CommandLines.Windows.txt");
+
+  TerminalArgumentCodec terminal;
+  testEncoderTestFile(terminal, "Test.CommandLines.Linux.txt");
+}
+
+TEST_F(TestArgumentStreamEncoder, testEncodeArgument)
+{
+  TerminalArgumentCodec codec;
+
+  std::string cmdline;
+  CallbackOutputSink sink(&appendToString, &cmdline);
+  ArgumentStreamEncoder encoder(codec, sink);
+
+  ASSERT_TRUE( encoder.encodeArgument("a b") );
+  ASSERT_TRUE( encoder.encodeArgument("") );
+  ASSERT_TRUE( encoder.encodeArgument("c") );
+  ASSERT_TRUE( cmdline.empty() ); //not flushed yet
+  ASSERT_TRUE( encoder.flush() );
+  ASSERT_EQ(std::string("\"a b\" \"\" c"), cmdline);
+
+  //start a new command line
+  cmdline.clear();
+  encoder.reset();
+  ASSERT_TRUE( encoder.encodeArgument("d") );
+  ASSERT_TRUE( encoder.flush() );
+  ASSERT_EQ(std::string("d"), cmdline);
+}
+
+TEST_F(TestArgumentStreamEncoder, testFileOutputSink)
+{
+  FILE * f = tmpfile();
+  ASSERT_TRUE( f != NULL );
+
+  TerminalArgumentCodec codec;
+  {
+    FileOutputSink sink(f);
+    ArgumentStreamEncoder encoder(codec, sink);
+    for(int i=0; i<1000; i++)
+    {
+      ASSERT_TRUE( encoder.encodeArgument("file name.txt") );
+    }
+    ASSERT_TRUE( encoder.flush() );
+  }
+
+  long size = ftell(f);
+  fclose(f);
+
+  //1000 arguments of 15 bytes and 999 separators
+  ASSERT_EQ(1000*15 + 999, size);
+}
@@ -0,0 +1,162 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "TestBatchEncoder.h"
+#include "libargvcodec/BatchEncoder.h"
+#include "libargvcodec/CmdPromptArgumentCodec.h"
+#include "libargvcodec/CreateProcessArgumentCodec.h"
+#include "libargvcodec/TerminalArgumentCodec.h"
+#include "TestUtils.h"
+
+using namespace libargvcodec;
+
+void TestBatchEncoder::SetUp()
+{
+}
+
+void TestBatchEncoder::TearDown()
+{
+}
+
+/// <summary>Loads the arguments of both test files as argument lists, repeated until the given minimum number of lists is reached.</summary>
+bool loadArgumentLists(size_t iMinCount, std::vector<ArgumentList> & oArgumentLists)
+{
+  oArgumentLists.clear();
+
+  TEST_DATA_LIST items;
+  TEST_DATA_LIST linux_items;
+  if (!loadCommandLineTestFile("Test.CommandLines.Windows.txt", items) || !loadCommandLineTestFile("Test.CommandLines.Linux.txt", linux_items))
+    return false;
+  items.insert(items.end(), linux_items.begin(), linux_items.end());
+
+  while(oArgumentLists.size() < iMinCount)
+  {
+    for(size_t i=0; i<items.size(); i++)
+    {
+      ra::strings::StringVector arguments = items[i].arguments;
+      arguments.insert(arguments.begin(), "foo.exe");
+
+      ArgumentList arglist;
+      arglist.init(arguments);
+      oArgumentLists.push_back(arglist);
+    }
+  }
+  return true;
+}
+
+std::string encodeSequentially(IArgumentEncoder & iEncoder, const std::vector<ArgumentList> & iArgumentLists, char iSeparator)
+{
+  std::string output;
+  for(size_t i=0; i<iArgumentLists.size(); i++)
+  {
+    output.append(iEncoder.encodeCommandLine(iArgumentLists[i]));
+    output.append(1, iSeparator);
+  }
+  return output;
+}
+
+TEST_F(TestBatchEncoder, testEncodeBatch)
+{
+  std::vector<ArgumentList> arglists;
+  ASSERT_TRUE( loadArgumentLists(1000, arglists) );
+
+  CmdPromptArgumentCodec cmd;
+  CreateProcessArgumentCodec createprocess;
+  TerminalArgumentCodec terminal;
+  IArgumentEncoder * encoders[] = {&cmd, &createprocess, &terminal};
+
+  static const int NUM_THREADS[] = {1, 2, 3, 8, 0};
+  static const size_t NUM_NUM_THREADS = sizeof(NUM_THREADS)/sizeof(NUM_THREADS[0]);
+
+  for(size_t e=0; e<sizeof(encoders)/sizeof(encoders[0]); e++)
+  {
+    IArgumentEncoder & encoder = *encoders[e];
+    std::string expected = encodeSequentially(encoder, arglists, '\n');
+
+    for(size_t t=0; t<NUM_NUM_THREADS; t++)
+    {
+      std::string output;
+      ASSERT_TRUE( BatchEncoder::encodeBatch(encoder, &arglists[0], arglists.size(), '\n', output, NUM_THREADS[t]) );
+      ASSERT_EQ(expected, output) << "encoder: " << e << ", threads: " << NUM_THREADS[t];
+    }
+  }
+}
+
+TEST_F(TestBatchEncoder, testEncodeBatchAllDialects)
+{
+  std::vector<ArgumentList> arglists;
+  ASSERT_TRUE( loadArgumentLists(1000, arglists) );
+
+  CmdPromptArgumentCodec cmd;
+  CreateProcessArgumentCodec createprocess;
+  TerminalArgumentCodec terminal;
+
+  std::string expected_cmd           = encodeSequentially(cmd, arglists, '\0');
+  std::string expected_createprocess = encodeSequentially(createprocess, arglists, '\0');
+  std::string expected_terminal      = encodeSequentially(terminal, arglists, '\0');
+
+  static const int NUM_THREADS[] = {1, 2, 3, 8, 0};
+  static const size_t NUM_NUM_THREADS = sizeof(NUM_THREADS)/sizeof(NUM_THREADS[0]);
+
+  for(size_t t=0; t<NUM_NUM_THREADS; t++)
+  {
+    BatchEncoder::DialectCommandLines output;
+    ASSERT_TRUE( BatchEncoder::encodeBatchAllDialects(&arglists[0], arglists.size(), '\0', output, NUM_THREADS[t]) );
+    ASSERT_EQ(expected_cmd, output.cmdPrompt) << "threads: " << NUM_THREADS[t];
+    ASSERT_EQ(expected_createprocess, output.createProcess) << "threads: " << NUM_THREADS[t];
+    ASSERT_EQ(expected_terminal, output.terminal) << "threads: " << NUM_THREADS[t];
+  }
+}
+
+TEST_F(TestBatchEncoder, testEncodeAllDialects)
+{
+  ArgumentList arglist;
+  arglist.insert("foo.exe");
+  arglist.insert("hello world");
+  arglist.insert("a&b");
+  arglist.insert("");
+  arglist.insert("\"quoted\"\\");
+
+  BatchEncoder::DialectCommandLines cmdlines;
+  BatchEncoder::encodeAllDialects(arglist, cmdlines);
+
+  ASSERT_EQ(CmdPromptArgumentCodec().encodeCommandLine(arglist), cmdlines.cmdPrompt);
+  ASSERT_EQ(CreateProcessArgumentCodec().encodeCommandLine(arglist), cmdlines.createProcess);
+  ASSERT_EQ(TerminalArgumentCodec().encodeCommandLine(arglist), cmdlines.terminal);
+}
+
+TEST_F(TestBatchEncoder, testEmpty)
+{
+  TerminalArgumentCodec codec;
+  std::string output = "not empty";
+
+  ASSERT_FALSE( BatchEncoder::encodeBatch(codec, NULL, 3, '\n', output) );
+  ASSERT_TRUE( BatchEncoder::encodeBatch(codec, NULL, 0, '\n', output) );
+  ASSERT_TRUE( output.empty() );
+
+  BatchEncoder::DialectCommandLines cmdlines;
+  ASSERT_FALSE( BatchEncoder::encodeBatchAllDialects(NULL, 3, '\n', cmdlines) );
+  ASSERT_TRUE( BatchEncoder::encodeBatchAllDialects(NULL, 0, '\n', cmdlines) );
+  ASSERT_TRUE( cmdlines.terminal.empty() );
+}
@@ -24,6 +24,7 @@
 
 #include "TestCmdPromptArgumentCodec.h"
 #include "libargvcodec/CmdPromptArgumentCodec.h"
+#include "libargvcodec/CmdPromptStreamDecoder.h"
 #include "rapidassist/strings.h"
 #include "rapidassist/gtesthelp.h"
 #include "rapidassist/filesystem.h"
@@ -458,3 +459,65 @@ TEST_F(TestCmdPromptArgumentCodec, testEnvironmentVariables)
 #endif // _WIN32
   }
 }
+
+TEST_F(TestCmdPromptArgumentCodec, testStreamDecoder_testfile)
+{
+  //The objective of this unit test is to validate that CmdPromptStreamDecoder decodes the content of file 'Test.CommandLines.Windows.txt' regardless of the size of the chunks.
+
+  ArgumentCollector collector;
+  libargvcodec::CmdPromptStreamDecoder decoder(collector);
+
+  std::string test_file = "Test.CommandLines.Windows.txt";
+
+  TEST_DATA_LIST items;
+  bool file_loaded = loadCommandLineTestFile(test_file, items);
+  ASSERT_TRUE( file_loaded );
+
+  static const size_t CHUNK_SIZES[] = {1, 2, 3, 5, 8, 1024};
+  static const size_t NUM_CHUNK_SIZES = sizeof(CHUNK_SIZES)/sizeof(CHUNK_SIZES[0]);
+
+  for(size_t i=0; i<items.size(); i++)
+  {
+    const TEST_DATA & td = items[i];
+
+    //get command line and arguments from the file:
+    const std::string & file_cmdline = td.cmdline;
+    const ra::strings::StringVector & file_arguments = td.arguments;
+
+    for(size_t j=0; j<NUM_CHUNK_SIZES; j++)
+    {
+      //decode the command line in chunks
+      collector.arguments.clear();
+      bool decoded = decodeInChunks(decoder, file_cmdline, CHUNK_SIZES[j]);
+      ASSERT_TRUE( decoded );
+
+      //build a meaningful error message
+      std::string error_message = buildErrorString(file_cmdline, file_arguments, collector.arguments);
+
+      //assert decoded arguments are equals to file arguments
+      ASSERT_EQ(file_arguments.size(), collector.arguments.size()) << error_message << "chunk size: " << CHUNK_SIZES[j];
+      for(size_t k=0; k<file_arguments.size(); k++)
+      {
+        const std::string & expected_argument = file_arguments[k];
+        const std::string & decoded_argument  = collector.arguments[k];
+        ASSERT_EQ(expected_argument, decoded_argument) << error_message << "chunk size: " << CHUNK_SIZES[j];
+      }
+    }
+  }
+}
+
+TEST_F(TestCmdPromptArgumentCodec, testStreamDecoder_nullSeparated)
+{
+  //NULL characters are argument separators which allows decoding NULL separated streams
+  ArgumentCollector collector;
+  libargvcodec::CmdPromptStreamDecoder decoder(collector);
+
+  static const char stream[] = "a\0\"b c\"\0d\\\"e\0";
+  ASSERT_TRUE( decoder.feed(stream, sizeof(stream)-1) );
+  ASSERT_TRUE( decoder.finish() );
+
+  ASSERT_EQ(3, (int)collector.arguments.size());
+  ASSERT_EQ(std::string("a"),     collector.arguments[0]);
+  ASSERT_EQ(std::string("b c"),   collector.arguments[1]);
+  ASSERT_EQ(std::string("d\"e"), collector.arguments[2]);
+}
@@ -0,0 +1,199 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "TestCommandLineSplitter.h"
+#include "libargvcodec/CommandLineSplitter.h"
+#include "libargvcodec/ParallelSpawner.h"
+#include "libargvcodec/TerminalArgumentCodec.h"
+#include "libargvcodec/CreateProcessArgumentCodec.h"
+#include "TestUtils.h"
+
+#include <cstdio>
+#include <chrono>
+
+using namespace libargvcodec;
+
+void TestCommandLineSplitter::SetUp()
+{
+}
+
+void TestCommandLineSplitter::TearDown()
+{
+}
+
+ArgumentList buildFileList(int iNumFiles)
+{
+  ra::strings::StringVector args;
+  args.push_back("tool");
+  args.push_back("--verbose");
+  args.push_back("-o out dir");
+  for(int i=0; i<iNumFiles; i++)
+  {
+    char value[64];
+    sprintf(value, "file_%d.txt", i);
+    args.push_back(value);
+  }
+
+  ArgumentList arglist;
+  arglist.init(args);
+  return arglist;
+}
+
+TEST_F(TestCommandLineSplitter, testSplit)
+{
+  TerminalArgumentCodec codec;
+  CommandLineSplitter splitter(codec);
+
+  static const size_t MAX_LENGTH = 200;
+  ArgumentList arglist = buildFileList(1000);
+
+  CommandLineSplitter::ArgumentListVector batches;
+  ArgumentList::StringList cmdlines;
+  ASSERT_TRUE( splitter.split(arglist, 3, MAX_LENGTH, batches, cmdlines) );
+  ASSERT_EQ(batches.size(), cmdlines.size());
+  ASSERT_GT(batches.size(), 1u);
+
+  int next = 3;
+  for(size_t i=0; i<batches.size(); i++)
+  {
+    const ArgumentList & batch = batches[i];
+
+    //each command line fits and matches its batch
+    ASSERT_LE(cmdlines[i].size(), MAX_LENGTH);
+    ASSERT_EQ(codec.encodeCommandLine(batch), cmdlines[i]);
+
+    //leading arguments are repeated
+    ASSERT_EQ(std::string("tool"),       batch.getArgument(0));
+    ASSERT_EQ(std::string("--verbose"),  batch.getArgument(1));
+    ASSERT_EQ(std::string("-o out dir"), batch.getArgument(2));
+
+    //trailing arguments are distributed in order
+    ASSERT_GT(batch.getArgc(), 3);
+    for(int j=3; j<batch.getArgc(); j++)
+    {
+      ASSERT_EQ(std::string(arglist.getArgument(next)), batch.getArgument(j));
+      next++;
+    }
+
+    //the batch is full: the next argument would not fit (minimum number of batches)
+    if (i+1 < batches.size())
+    {
+      std::string longer = cmdlines[i] + " " + codec.encodeArgument(arglist.getArgument(next));
+      ASSERT_GT(longer.size(), MAX_LENGTH);
+    }
+  }
+  ASSERT_EQ(arglist.getArgc(), next);
+}
+
+TEST_F(TestCommandLineSplitter, testSingleBatch)
+{
+  CreateProcessArgumentCodec codec;
+  CommandLineSplitter splitter(codec);
+
+  ArgumentList arglist = buildFileList(10);
+
+  CommandLineSplitter::ArgumentListVector batches;
+  ArgumentList::StringList cmdlines;
+  ASSERT_TRUE( splitter.split(arglist, 3, 32767, batches, cmdlines) );
+  ASSERT_EQ(1u, batches.size());
+  ASSERT_TRUE( batches[0] == arglist );
+  ASSERT_EQ(codec.encodeCommandLine(arglist), cmdlines[0]);
+
+  //no trailing arguments
+  ASSERT_TRUE( splitter.split(arglist, arglist.getArgc(), 32767, batches, cmdlines) );
+  ASSERT_EQ(0u, batches.size());
+}
+
+TEST_F(TestCommandLineSplitter, testArgumentTooLong)
+{
+  TerminalArgumentCodec codec;
+  CommandLineSplitter splitter(codec);
+
+  ArgumentList arglist = buildFileList(10);
+  arglist.insert(std::string(100, 'x').c_str());
+
+  CommandLineSplitter::ArgumentListVector batches;
+  ArgumentList::StringList cmdlines;
+  ASSERT_FALSE( splitter.split(arglist, 3, 50, batches, cmdlines) );
+  ASSERT_EQ(0u, batches.size());
+
+  //leading arguments too long
+  ASSERT_FALSE( splitter.split(arglist, 3, 10, batches, cmdlines) );
+  ASSERT_FALSE( splitter.split(arglist, 0, 1000, batches, cmdlines) );
+}
+
+#ifndef _WIN32
+TEST_F(TestCommandLineSplitter, testParallelSpawner)
+{
+  ParallelSpawner::ArgumentListVector processes;
+  for(int i=0; i<8; i++)
+  {
+    char script[64];
+    sprintf(script, "exit %d", i);
+
+    ra::strings::StringVector args;
+    args.push_back("sh");
+    args.push_back("-c");
+    args.push_back(script);
+
+    processes.push_back(ArgumentList());
+    processes.back().init(args);
+  }
+
+  ParallelSpawner::ExitCodeList exit_codes;
+  ASSERT_TRUE( ParallelSpawner::run(processes, 3, exit_codes) );
+  ASSERT_EQ(processes.size(), exit_codes.size());
+  for(size_t i=0; i<exit_codes.size(); i++)
+  {
+    ASSERT_EQ((int)i, exit_codes[i]);
+  }
+}
+
+TEST_F(TestCommandLineSplitter, testParallelSpawnerLongProcess)
+{
+  //a long process must not prevent the other slots from starting new processes
+  ParallelSpawner::ArgumentListVector processes;
+  for(int i=0; i<5; i++)
+  {
+    ra::strings::StringVector args;
+    args.push_back("sleep");
+    args.push_back(i == 0 ? "2" : "0.5");
+
+    processes.push_back(ArgumentList());
+    processes.back().init(args);
+  }
+
+  //the short processes run one after the other in the second slot while the long process is running
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  ParallelSpawner::ExitCodeList exit_codes;
+  ASSERT_TRUE( ParallelSpawner::run(processes, 2, exit_codes) );
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  for(size_t i=0; i<exit_codes.size(); i++)
+  {
+    ASSERT_EQ(0, exit_codes[i]);
+  }
+  ASSERT_LT(elapsed, 2.5);
+}
+#endif //_WIN32
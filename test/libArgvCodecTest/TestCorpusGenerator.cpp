@@ -0,0 +1,138 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "TestCorpusGenerator.h"
+#include "CorpusGenerator.h"
+#include "libargvcodec/CreateProcessArgumentCodec.h"
+#include "libargvcodec/TerminalArgumentCodec.h"
+#include "TestUtils.h"
+
+using namespace libargvcodec;
+
+void TestCorpusGenerator::SetUp()
+{
+}
+
+void TestCorpusGenerator::TearDown()
+{
+}
+
+static size_t getTotalSize(const CorpusGenerator::StringList & iArguments)
+{
+  size_t size = 0;
+  for(size_t i=0; i<iArguments.size(); i++)
+  {
+    size += iArguments[i].size() + 1;
+  }
+  return size;
+}
+
+TEST_F(TestCorpusGenerator, testDeterministic)
+{
+  for(int k=0; k<CorpusGenerator::NUM_KINDS; k++)
+  {
+    const CorpusGenerator::Kind kind = (CorpusGenerator::Kind)k;
+
+    CorpusGenerator::StringListArray corpus1;
+    CorpusGenerator::StringListArray corpus2;
+    CorpusGenerator::StringListArray corpus3;
+
+    CorpusGenerator generator(42);
+    generator.generateCorpus(kind, 10, 1024, corpus1);
+    generator.setSeed(42);
+    generator.generateCorpus(kind, 10, 1024, corpus2);
+    generator.setSeed(43);
+    generator.generateCorpus(kind, 10, 1024, corpus3);
+
+    ASSERT_EQ(corpus1, corpus2) << CorpusGenerator::getKindName(kind);
+    ASSERT_NE(corpus1, corpus3) << CorpusGenerator::getKindName(kind);
+  }
+}
+
+TEST_F(TestCorpusGenerator, testKnownSequence)
+{
+  //the sequence must never change to keep benchmark results comparable
+  CorpusGenerator generator(1);
+  CorpusGenerator::StringList arguments;
+  generator.generate(CorpusGenerator::HUGE_ARGUMENT, 16, arguments);
+  ASSERT_EQ(1, arguments.size());
+  ASSERT_EQ(std::string("t fryhyips iobfq"), arguments[0]);
+}
+
+TEST_F(TestCorpusGenerator, testSize)
+{
+  CorpusGenerator generator(0);
+  for(int k=0; k<CorpusGenerator::NUM_KINDS; k++)
+  {
+    const CorpusGenerator::Kind kind = (CorpusGenerator::Kind)k;
+    for(size_t size = 16; size <= 64*1024; size *= 4)
+    {
+      CorpusGenerator::StringList arguments;
+      generator.generate(kind, size, arguments);
+      ASSERT_GE(getTotalSize(arguments), size) << CorpusGenerator::getKindName(kind);
+      if (kind == CorpusGenerator::HUGE_ARGUMENT)
+      {
+        ASSERT_EQ(1, arguments.size());
+        ASSERT_EQ(size, arguments[0].size());
+      }
+
+      //no unsupported characters
+      for(size_t i=0; i<arguments.size(); i++)
+      {
+        ASSERT_EQ(std::string::npos, arguments[i].find_first_of(std::string("\r\n\0", 3)));
+      }
+    }
+  }
+}
+
+template <typename Codec>
+void testRoundTrip(const char * iCodecName)
+{
+  const Codec codec;
+  CorpusGenerator generator(2023);
+  for(int k=0; k<CorpusGenerator::NUM_KINDS; k++)
+  {
+    const CorpusGenerator::Kind kind = (CorpusGenerator::Kind)k;
+
+    CorpusGenerator::StringListArray corpus;
+    generator.generateCorpus(kind, 20, 512, corpus);
+    for(size_t i=0; i<corpus.size(); i++)
+    {
+      CorpusGenerator::StringList arguments = corpus[i];
+      arguments.insert(arguments.begin(), "foo.exe");
+      ArgumentList arglist;
+      arglist.init(arguments);
+      std::string cmdline = codec.encodeCommandLine(arglist);
+
+      ArgumentList decoded = codec.decodeCommandLine(cmdline.c_str());
+      ASSERT_EQ(corpus[i], toStringList(decoded)) << iCodecName << " " << CorpusGenerator::getKindName(kind) << "\n" << buildErrorString(cmdline, corpus[i], toStringList(decoded));
+    }
+  }
+}
+
+TEST_F(TestCorpusGenerator, testRoundTrip)
+{
+  testRoundTrip<CreateProcessArgumentCodec>("CreateProcess");
+  testRoundTrip<TerminalArgumentCodec>("Terminal");
+}
@@ -0,0 +1,222 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "TestDecodedCommandLineCache.h"
+#include "libargvcodec/DecodedCommandLineCache.h"
+#include "libargvcodec/CmdPromptArgumentCodec.h"
+#include "libargvcodec/CreateProcessArgumentCodec.h"
+#include "libargvcodec/TerminalArgumentCodec.h"
+#include "TestUtils.h"
+
+#include <thread>
+#include <atomic>
+#include <cstdio>
+
+using namespace libargvcodec;
+
+void TestDecodedCommandLineCache::SetUp()
+{
+}
+
+void TestDecodedCommandLineCache::TearDown()
+{
+}
+
+TEST_F(TestDecodedCommandLineCache, testDisabledByDefault)
+{
+  TerminalArgumentCodec codec;
+  ASSERT_TRUE(codec.getDecodeCache() == NULL);
+
+  //decodeShared() still works without a cache
+  DecodedCommandLinesPtr decoded = codec.decodeShared("foo \"bar baz\"");
+  ASSERT_TRUE(decoded != NULL);
+  ASSERT_EQ(1, decoded->getNumCommandLines());
+  ASSERT_EQ(2, decoded->getArgc(0));
+  ASSERT_EQ(std::string("bar baz"), decoded->getArgument(0, 1));
+
+  ASSERT_TRUE(codec.decodeShared(NULL) == NULL);
+}
+
+TEST_F(TestDecodedCommandLineCache, testHitsAndMisses)
+{
+  TerminalArgumentCodec codec;
+  DecodedCommandLineCache cache;
+  codec.setDecodeCache(&cache);
+  ASSERT_EQ(&cache, codec.getDecodeCache());
+
+  DecodedCommandLinesPtr first = codec.decodeShared("foo 'bar baz'");
+  ASSERT_EQ(0, cache.getNumHits());
+  ASSERT_EQ(1, cache.getNumMisses());
+  ASSERT_EQ(1, cache.getNumEntries());
+  ASSERT_GT(cache.getNumBytes(), 0);
+
+  //a hit returns the same snapshot
+  DecodedCommandLinesPtr second = codec.decodeShared("foo 'bar baz'");
+  ASSERT_EQ(1, cache.getNumHits());
+  ASSERT_EQ(first.get(), second.get());
+
+  //the snapshot stays valid after the cache is cleared
+  cache.clear();
+  ASSERT_EQ(0, cache.getNumEntries());
+  ASSERT_EQ(0, cache.getNumBytes());
+  ASSERT_EQ(std::string("bar baz"), first->getArgument(0, 1));
+
+  //disable the cache
+  codec.setDecodeCache(NULL);
+  cache.resetStatistics();
+  codec.decodeShared("foo 'bar baz'");
+  ASSERT_EQ(0, cache.getNumHits());
+  ASSERT_EQ(0, cache.getNumMisses());
+}
+
+TEST_F(TestDecodedCommandLineCache, testDialects)
+{
+  //the same command line is decoded differently by each dialect
+  CmdPromptArgumentCodec cmd;
+  CreateProcessArgumentCodec createprocess;
+  DecodedCommandLineCache cache;
+  cmd.setDecodeCache(&cache);
+  createprocess.setDecodeCache(&cache);
+
+  const char * cmdline = "a^\"b c\"";
+  ArgumentList cmd_args = cmd.decodeCommandLine(cmdline);
+  ArgumentList createprocess_args = createprocess.decodeCommandLine(cmdline);
+  ASSERT_EQ(2, cache.getNumEntries());
+  ASSERT_NE(std::string(cmd_args.getArgument(1)), std::string(createprocess_args.getArgument(1)));
+
+  //another instance of the same codec shares the entries
+  CmdPromptArgumentCodec cmd2;
+  cmd2.setDecodeCache(&cache);
+  cache.resetStatistics();
+  ArgumentList cmd2_args = cmd2.decodeCommandLine(cmdline);
+  ASSERT_EQ(1, cache.getNumHits());
+  ASSERT_EQ(toStringList(cmd_args), toStringList(cmd2_args));
+
+  //a derived codec is a different dialect and never receives the snapshots of its base class
+  class DerivedArgumentCodec : public CmdPromptArgumentCodec
+  {
+  };
+  DerivedArgumentCodec derived;
+  derived.setDecodeCache(&cache);
+  cache.resetStatistics();
+  derived.decodeCommandLine(cmdline);
+  ASSERT_EQ(0, cache.getNumHits());
+  ASSERT_EQ(3, cache.getNumEntries());
+}
+
+TEST_F(TestDecodedCommandLineCache, testCommandLines)
+{
+  TEST_DATA_LIST items;
+  ASSERT_TRUE( loadCommandLineTestFile("Test.CommandLines.Windows.txt", items) );
+
+  CreateProcessArgumentCodec reference;
+  CreateProcessArgumentCodec codec;
+  DecodedCommandLineCache cache;
+  codec.setDecodeCache(&cache);
+
+  //decode twice to get hits
+  for(int pass=0; pass<2; pass++)
+  {
+    for(size_t i=0; i<items.size(); i++)
+    {
+      const char * cmdline = items[i].cmdline.c_str();
+      ra::strings::StringVector expected = toStringList(reference.decodeCommandLine(cmdline));
+      ra::strings::StringVector actual = toStringList(codec.decodeCommandLine(cmdline));
+      ASSERT_EQ(expected, actual) << buildErrorString(items[i].cmdline, expected, actual);
+    }
+  }
+  ASSERT_GE(cache.getNumHits(), items.size());
+}
+
+TEST_F(TestDecodedCommandLineCache, testMemoryLimit)
+{
+  TerminalArgumentCodec codec;
+  DecodedCommandLineCache cache(16 * 1024);
+  codec.setDecodeCache(&cache);
+
+  for(int i=0; i<1000; i++)
+  {
+    char cmdline[128];
+    sprintf(cmdline, "command --option=%d \"some quoted value\" 'another value %d'", i, i);
+    DecodedCommandLinesPtr decoded = codec.decodeShared(cmdline);
+    ASSERT_EQ(4, decoded->getArgc(0));
+  }
+
+  ASSERT_EQ(16 * 1024, cache.getMaxBytes());
+  ASSERT_LE(cache.getNumBytes(), cache.getMaxBytes());
+  ASSERT_GT(cache.getNumEvictions(), 0);
+  ASSERT_EQ(1000, cache.getNumMisses());
+
+  //a command line larger than the limit is not cached
+  std::string large(cache.getMaxBytes(), 'a');
+  cache.clear();
+  codec.decodeShared(large.c_str());
+  ASSERT_EQ(0, cache.getNumEntries());
+}
+
+void decodeWithSharedCache(const IArgumentDecoder * iDecoder, const IArgumentDecoder * iReference, const std::vector<std::string> * iCommandLines, std::atomic<int> * ioNumErrors)
+{
+  for(int iteration=0; iteration<20; iteration++)
+  {
+    for(size_t i=0; i<iCommandLines->size(); i++)
+    {
+      const char * cmdline = (*iCommandLines)[i].c_str();
+      if (toStringList(iDecoder->decodeCommandLine(cmdline)) != toStringList(iReference->decodeCommandLine(cmdline)))
+        (*ioNumErrors)++;
+    }
+  }
+}
+
+TEST_F(TestDecodedCommandLineCache, testConcurrentDecoders)
+{
+  static const int NUM_THREADS = 8;
+
+  //more distinct command lines than the capacity of the cache to force evictions
+  std::vector<std::string> cmdlines;
+  for(int i=0; i<500; i++)
+  {
+    char cmdline[128];
+    sprintf(cmdline, "\"foo bar\" \\\"%d\\\" baz^&%d", i % 250, i);
+    cmdlines.push_back(cmdline);
+  }
+
+  const CmdPromptArgumentCodec reference;
+  CmdPromptArgumentCodec codec;
+  DecodedCommandLineCache cache(DecodedCommandLineCache::DEFAULT_MAX_BYTES, 128);
+  codec.setDecodeCache(&cache);
+
+  std::atomic<int> num_errors(0);
+  std::vector<std::thread> threads;
+  for(int i=0; i<NUM_THREADS; i++)
+  {
+    threads.push_back(std::thread(decodeWithSharedCache, &codec, &reference, &cmdlines, &num_errors));
+  }
+  for(size_t i=0; i<threads.size(); i++)
+  {
+    threads[i].join();
+  }
+
+  ASSERT_EQ(0, num_errors.load());
+  ASSERT_EQ(NUM_THREADS * 20 * cmdlines.size(), cache.getNumHits() + cache.getNumMisses());
+}
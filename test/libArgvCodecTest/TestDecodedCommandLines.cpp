@@ -0,0 +1,170 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "TestDecodedCommandLines.h"
+#include "libargvcodec/DecodedCommandLines.h"
+#include "libargvcodec/CmdPromptArgumentCodec.h"
+#include "libargvcodec/CreateProcessArgumentCodec.h"
+#include "libargvcodec/TerminalArgumentCodec.h"
+#include "TestUtils.h"
+
+using namespace libargvcodec;
+
+void TestDecodedCommandLines::SetUp()
+{
+}
+
+void TestDecodedCommandLines::TearDown()
+{
+}
+
+/// <summary>Loads the command lines of a test file, repeated until the given minimum number of command lines is reached.</summary>
+bool loadRepeatedCommandLines(const std::string & iPath, size_t iMinCount, ra::strings::StringVector & oCommandLines)
+{
+  oCommandLines.clear();
+
+  TEST_DATA_LIST items;
+  if (!loadCommandLineTestFile(iPath, items) || items.empty())
+    return false;
+
+  while(oCommandLines.size() < iMinCount)
+  {
+    for(size_t i=0; i<items.size(); i++)
+    {
+      oCommandLines.push_back(items[i].cmdline);
+    }
+  }
+  return true;
+}
+
+/// <summary>Validates that decodeBatch() returns the same arguments as decodeCommandLine() for all command lines with multiple number of threads.</summary>
+void validateDecodeBatch(IArgumentDecoder & iDecoder, const ra::strings::StringVector & iCommandLines, bool (*iDecodeBatch)(IArgumentDecoder &, const char * const *, size_t, DecodedCommandLines &, int))
+{
+  std::vector<const char *> pointers;
+  for(size_t i=0; i<iCommandLines.size(); i++)
+  {
+    pointers.push_back(iCommandLines[i].c_str());
+  }
+
+  static const int NUM_THREADS[] = {1, 2, 3, 8, 0};
+  static const size_t NUM_NUM_THREADS = sizeof(NUM_THREADS)/sizeof(NUM_THREADS[0]);
+
+  for(size_t t=0; t<NUM_NUM_THREADS; t++)
+  {
+    DecodedCommandLines decoded;
+    bool success = iDecodeBatch(iDecoder, &pointers[0], pointers.size(), decoded, NUM_THREADS[t]);
+    ASSERT_TRUE( success );
+    ASSERT_EQ(iCommandLines.size(), decoded.getNumCommandLines());
+
+    for(size_t i=0; i<iCommandLines.size(); i++)
+    {
+      //decodeCommandLine() also adds the current executable as the first argument
+      ArgumentList expected = iDecoder.decodeCommandLine(iCommandLines[i].c_str());
+      ASSERT_EQ((size_t)expected.getArgc() - 1, decoded.getArgc(i)) << "cmdline: " << iCommandLines[i] << ", threads: " << NUM_THREADS[t];
+      for(size_t j=0; j<decoded.getArgc(i); j++)
+      {
+        const char * expected_argument = expected.getArgument((int)j + 1);
+        ASSERT_STREQ(expected_argument, decoded.getArgument(i, j)) << "cmdline: " << iCommandLines[i] << ", threads: " << NUM_THREADS[t];
+        ASSERT_EQ(strlen(expected_argument), decoded.getArgumentLength(i, j));
+      }
+    }
+  }
+}
+
+template <typename Codec>
+bool decodeBatchWith(IArgumentDecoder & iDecoder, const char * const * iCommandLines, size_t iCount, DecodedCommandLines & oResult, int iNumThreads)
+{
+  Codec & codec = dynamic_cast<Codec &>(iDecoder);
+  return codec.decodeBatch(iCommandLines, iCount, oResult, iNumThreads);
+}
+
+TEST_F(TestDecodedCommandLines, testDecodeBatch_cmdPrompt)
+{
+  ra::strings::StringVector cmdlines;
+  ASSERT_TRUE( loadRepeatedCommandLines("Test.CommandLines.Windows.txt", 2000, cmdlines) );
+
+  CmdPromptArgumentCodec codec;
+  validateDecodeBatch(codec, cmdlines, &decodeBatchWith<CmdPromptArgumentCodec>);
+}
+
+TEST_F(TestDecodedCommandLines, testDecodeBatch_createProcess)
+{
+  ra::strings::StringVector cmdlines;
+  ASSERT_TRUE( loadRepeatedCommandLines("Test.CommandLines.Windows.txt", 2000, cmdlines) );
+
+  CreateProcessArgumentCodec codec;
+  validateDecodeBatch(codec, cmdlines, &decodeBatchWith<CreateProcessArgumentCodec>);
+}
+
+TEST_F(TestDecodedCommandLines, testDecodeBatch_terminal)
+{
+  ra::strings::StringVector cmdlines;
+  ASSERT_TRUE( loadRepeatedCommandLines("Test.CommandLines.Linux.txt", 2000, cmdlines) );
+
+  TerminalArgumentCodec codec;
+  validateDecodeBatch(codec, cmdlines, &decodeBatchWith<TerminalArgumentCodec>);
+}
+
+TEST_F(TestDecodedCommandLines, testDecodeBatch_nullCommandLines)
+{
+  TerminalArgumentCodec codec;
+  DecodedCommandLines decoded;
+
+  //a NULL array is only valid when empty
+  ASSERT_FALSE( codec.decodeBatch(NULL, 3, decoded) );
+  ASSERT_TRUE( codec.decodeBatch(NULL, 0, decoded) );
+  ASSERT_EQ(0, decoded.getNumCommandLines());
+  ASSERT_EQ(0, decoded.getNumArguments());
+
+  //NULL command lines are decoded as empty command lines
+  const char * cmdlines[] = {"foo bar", NULL, "", "baz"};
+  ASSERT_TRUE( codec.decodeBatch(cmdlines, 4, decoded, 2) );
+  ASSERT_EQ(4, decoded.getNumCommandLines());
+  ASSERT_EQ(3, decoded.getNumArguments());
+  ASSERT_EQ(2, decoded.getArgc(0));
+  ASSERT_EQ(0, decoded.getArgc(1));
+  ASSERT_EQ(0, decoded.getArgc(2));
+  ASSERT_EQ(1, decoded.getArgc(3));
+  ASSERT_STREQ("bar", decoded.getArgument(0, 1));
+  ASSERT_STREQ("baz", decoded.getArgument(3, 0));
+}
+
+TEST_F(TestDecodedCommandLines, testOutOfBounds)
+{
+  DecodedCommandLines decoded;
+  decoded.onArgument("foo", 3);
+  decoded.endCommandLine();
+
+  ASSERT_EQ(1, decoded.getNumCommandLines());
+  ASSERT_EQ(1, decoded.getArgc(0));
+  ASSERT_EQ(0, decoded.getArgc(1));
+  ASSERT_TRUE( decoded.getArgument(0, 1) == NULL );
+  ASSERT_TRUE( decoded.getArgument(1, 0) == NULL );
+  ASSERT_EQ(0, decoded.getArgumentLength(0, 1));
+  ASSERT_EQ(3, decoded.getArgumentLength(0, 0));
+
+  decoded.clear();
+  ASSERT_EQ(0, decoded.getNumCommandLines());
+  ASSERT_EQ(0, decoded.getNumArguments());
+}
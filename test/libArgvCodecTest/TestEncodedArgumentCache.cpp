@@ -0,0 +1,192 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "TestEncodedArgumentCache.h"
+#include "libargvcodec/EncodedArgumentCache.h"
+#include "libargvcodec/CachingArgumentEncoder.h"
+#include "libargvcodec/CmdPromptArgumentCodec.h"
+#include "libargvcodec/TerminalArgumentCodec.h"
+#include "TestUtils.h"
+
+#include <thread>
+#include <atomic>
+#include <cstdio>
+
+using namespace libargvcodec;
+
+void TestEncodedArgumentCache::SetUp()
+{
+}
+
+void TestEncodedArgumentCache::TearDown()
+{
+}
+
+TEST_F(TestEncodedArgumentCache, testHitsAndMisses)
+{
+  TerminalArgumentCodec codec;
+  EncodedArgumentCache cache;
+  CachingArgumentEncoder encoder(codec, cache);
+
+  ASSERT_EQ(codec.encodeArgument("foo bar"), encoder.encodeArgument("foo bar"));
+  ASSERT_EQ(0, cache.getNumHits());
+  ASSERT_EQ(1, cache.getNumMisses());
+  ASSERT_EQ(1, cache.getNumEntries());
+
+  ASSERT_EQ(codec.encodeArgument("foo bar"), encoder.encodeArgument("foo bar"));
+  ASSERT_EQ(1, cache.getNumHits());
+  ASSERT_EQ(1, cache.getNumMisses());
+
+  cache.resetStatistics();
+  ASSERT_EQ(0, cache.getNumHits());
+  ASSERT_EQ(0, cache.getNumMisses());
+  ASSERT_EQ(1, cache.getNumEntries());
+
+  cache.clear();
+  ASSERT_EQ(0, cache.getNumEntries());
+}
+
+TEST_F(TestEncodedArgumentCache, testDialects)
+{
+  //the same argument is encoded differently by each dialect
+  CmdPromptArgumentCodec cmd;
+  TerminalArgumentCodec terminal;
+  EncodedArgumentCache cache;
+  CachingArgumentEncoder cached_cmd(cmd, cache);
+  CachingArgumentEncoder cached_terminal(terminal, cache);
+
+  const char * value = "a&b";
+  ASSERT_EQ(cmd.encodeArgument(value), cached_cmd.encodeArgument(value));
+  ASSERT_EQ(terminal.encodeArgument(value), cached_terminal.encodeArgument(value));
+  ASSERT_NE(cached_cmd.encodeArgument(value), cached_terminal.encodeArgument(value));
+  ASSERT_EQ(2, cache.getNumEntries());
+
+  //another instance of the same codec shares the entries
+  CmdPromptArgumentCodec cmd2;
+  CachingArgumentEncoder cached_cmd2(cmd2, cache);
+  cache.resetStatistics();
+  ASSERT_EQ(cmd.encodeArgument(value), cached_cmd2.encodeArgument(value));
+  ASSERT_EQ(1, cache.getNumHits());
+
+  //a derived codec is a different dialect even if it shares the encoding functions of its base class
+  class PrefixedArgumentCodec : public TerminalArgumentCodec
+  {
+  public:
+    virtual std::string encodeArgument(const char * iValue) const { return "prefix:" + TerminalArgumentCodec::encodeArgument(iValue); }
+  };
+  PrefixedArgumentCodec prefixed;
+  CachingArgumentEncoder cached_prefixed(prefixed, cache);
+  ASSERT_EQ(prefixed.encodeArgument(value), cached_prefixed.encodeArgument(value));
+  ASSERT_EQ(terminal.encodeArgument(value), cached_terminal.encodeArgument(value));
+  ASSERT_EQ(3, cache.getNumEntries());
+}
+
+TEST_F(TestEncodedArgumentCache, testEviction)
+{
+  TerminalArgumentCodec codec;
+  EncodedArgumentCache cache(32);
+  CachingArgumentEncoder encoder(codec, cache);
+
+  for(int i=0; i<1000; i++)
+  {
+    char value[64];
+    sprintf(value, "argument #%d", i);
+    ASSERT_EQ(codec.encodeArgument(value), encoder.encodeArgument(value));
+  }
+
+  ASSERT_EQ(32, cache.getMaxEntries());
+  ASSERT_LE(cache.getNumEntries(), cache.getMaxEntries());
+  ASSERT_GT(cache.getNumEvictions(), 0);
+  ASSERT_EQ(1000, cache.getNumMisses());
+}
+
+TEST_F(TestEncodedArgumentCache, testCommandLines)
+{
+  TEST_DATA_LIST items;
+  ASSERT_TRUE( loadCommandLineTestFile("Test.CommandLines.Windows.txt", items) );
+
+  CmdPromptArgumentCodec codec;
+  EncodedArgumentCache cache(64);
+  CachingArgumentEncoder encoder(codec, cache);
+
+  //encode twice to get hits
+  for(int pass=0; pass<2; pass++)
+  {
+    for(size_t i=0; i<items.size(); i++)
+    {
+      ra::strings::StringVector arguments = items[i].arguments;
+      arguments.insert(arguments.begin(), "foo.exe");
+      ArgumentList arglist;
+      arglist.init(arguments);
+
+      ASSERT_EQ(codec.encodeCommandLine(arglist), encoder.encodeCommandLine(arglist));
+    }
+  }
+  ASSERT_GT(cache.getNumHits(), 0);
+}
+
+void encodeWithSharedCache(const IArgumentEncoder * iEncoder, const IArgumentEncoder * iReference, const std::vector<std::string> * iValues, std::atomic<int> * ioNumErrors)
+{
+  for(int iteration=0; iteration<20; iteration++)
+  {
+    for(size_t i=0; i<iValues->size(); i++)
+    {
+      const char * value = (*iValues)[i].c_str();
+      if (iEncoder->encodeArgument(value) != iReference->encodeArgument(value))
+        (*ioNumErrors)++;
+    }
+  }
+}
+
+TEST_F(TestEncodedArgumentCache, testConcurrentEncoders)
+{
+  static const int NUM_THREADS = 8;
+
+  //more distinct values than the capacity of the cache to force evictions
+  std::vector<std::string> values;
+  for(int i=0; i<500; i++)
+  {
+    char value[64];
+    sprintf(value, "\"value\" & %d", i % 250);
+    values.push_back(value);
+  }
+
+  const CmdPromptArgumentCodec codec;
+  EncodedArgumentCache cache(128);
+  const CachingArgumentEncoder encoder(codec, cache);
+
+  std::atomic<int> num_errors(0);
+  std::vector<std::thread> threads;
+  for(int i=0; i<NUM_THREADS; i++)
+  {
+    threads.push_back(std::thread(encodeWithSharedCache, &encoder, &codec, &values, &num_errors));
+  }
+  for(size_t i=0; i<threads.size(); i++)
+  {
+    threads[i].join();
+  }
+
+  ASSERT_EQ(0, num_errors.load());
+  ASSERT_EQ(NUM_THREADS * 20 * values.size(), cache.getNumHits() + cache.getNumMisses());
+}
@@ -0,0 +1,176 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "TestFrozenArgumentList.h"
+#include "libargvcodec/FrozenArgumentList.h"
+#include "libargvcodec/ArgumentListPublisher.h"
+
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <cstdio>
+
+using namespace libargvcodec;
+
+void TestFrozenArgumentList::SetUp()
+{
+}
+
+void TestFrozenArgumentList::TearDown()
+{
+}
+
+TEST_F(TestFrozenArgumentList, testLookups)
+{
+  ArgumentList arglist;
+  arglist.insert("foo.exe");
+  arglist.insert("--verbose");
+  arglist.insert("/count=5");
+  arglist.insert("-name");
+  arglist.insert("bar");
+  arglist.addOptionPrefix("--");
+  arglist.addOptionPrefix("/");
+  arglist.addOptionPrefix("-");
+
+  FrozenArgumentList frozen(arglist);
+
+  //the source can be modified without affecting the snapshot
+  arglist.insert("--other");
+  arglist.clearOptionPrefixes();
+
+  ASSERT_EQ(5, frozen.getArgc());
+  ASSERT_STREQ("foo.exe", frozen.getArgument(0));
+  ASSERT_STREQ("bar", frozen.getArgv()[4]);
+  ASSERT_TRUE( frozen.getArgv()[5] == NULL );
+  ASSERT_EQ(3, (int)frozen.getOptionPrefixes().size());
+
+  ASSERT_EQ(1, frozen.findIndex("--verbose"));
+  ASSERT_TRUE( frozen.contains("-NAME", false) );
+  ASSERT_FALSE( frozen.contains("--other") );
+
+  int index = -1;
+  ASSERT_TRUE( frozen.findOption("/verbose", index) ); //using prefixes
+  ASSERT_EQ(1, index);
+
+  int count = 0;
+  ASSERT_TRUE( frozen.findValue("count", index, count) );
+  ASSERT_EQ(5, count);
+
+  std::string name;
+  ASSERT_TRUE( frozen.findNextValue("--name", index, name) );
+  ASSERT_EQ("bar", name);
+  ASSERT_EQ(3, index);
+
+  //a modifiable copy keeps the prefixes
+  ArgumentList copy = frozen.toArgumentList();
+  ASSERT_EQ(5, copy.getArgc());
+  ASSERT_EQ(3, (int)copy.getOptionPrefixes().size());
+  ASSERT_TRUE( copy.extractOption("/verbose") );
+  ASSERT_EQ(4, copy.getArgc());
+  ASSERT_EQ(5, frozen.getArgc());
+}
+
+TEST_F(TestFrozenArgumentList, testEmpty)
+{
+  ArgumentListPublisher publisher;
+  FrozenArgumentListPtr snapshot = publisher.getSnapshot();
+  ASSERT_TRUE( snapshot.get() != NULL );
+  ASSERT_EQ(0, snapshot->getArgc());
+  ASSERT_TRUE( snapshot->getArgv() == NULL || snapshot->getArgv()[0] == NULL );
+
+  ASSERT_FALSE( publisher.publish(FrozenArgumentListPtr()) );
+  ASSERT_TRUE( publisher.getSnapshot().get() != NULL );
+}
+
+static ArgumentList buildGeneration(int iGeneration)
+{
+  char value[64];
+  ArgumentList arglist;
+  arglist.insert("foo.exe");
+  sprintf(value, "--generation=%d", iGeneration);
+  arglist.insert(value);
+  arglist.insert("--check");
+  sprintf(value, "%d", iGeneration);
+  arglist.insert(value);
+  arglist.addOptionPrefix("--");
+  return arglist;
+}
+
+void readSnapshots(const ArgumentListPublisher * iPublisher, const std::atomic<bool> * iDone, std::atomic<int> * ioNumErrors)
+{
+  int previous_generation = -1;
+  while(!iDone->load())
+  {
+    FrozenArgumentListPtr snapshot = iPublisher->getSnapshot();
+    if (snapshot->getArgc() == 0)
+      continue; //initial empty snapshot
+
+    //both values of a snapshot must always be from the same generation
+    int index = -1;
+    int generation = -1;
+    int check = -2;
+    if (!snapshot->findValue("generation", index, generation) || !snapshot->findNextValue("check", index, check) || generation != check)
+      (*ioNumErrors)++;
+
+    //generations are published in order
+    if (generation < previous_generation)
+      (*ioNumErrors)++;
+    previous_generation = generation;
+  }
+}
+
+TEST_F(TestFrozenArgumentList, testConcurrentReaders)
+{
+  static const int NUM_READERS = 8;
+  static const int NUM_GENERATIONS = 2000;
+
+  ArgumentListPublisher publisher;
+  std::atomic<bool> done(false);
+  std::atomic<int> num_errors(0);
+
+  std::vector<std::thread> readers;
+  for(int i=0; i<NUM_READERS; i++)
+  {
+    readers.push_back(std::thread(readSnapshots, &publisher, &done, &num_errors));
+  }
+
+  //the writer builds a new snapshot and replaces the current one
+  for(int i=0; i<NUM_GENERATIONS; i++)
+  {
+    publisher.publish(buildGeneration(i));
+  }
+
+  done = true;
+  for(size_t i=0; i<readers.size(); i++)
+  {
+    readers[i].join();
+  }
+
+  ASSERT_EQ(0, num_errors.load());
+
+  int index = -1;
+  int generation = -1;
+  ASSERT_TRUE( publisher.getSnapshot()->findValue("generation", index, generation) );
+  ASSERT_EQ(NUM_GENERATIONS - 1, generation);
+}
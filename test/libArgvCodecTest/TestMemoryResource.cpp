@@ -0,0 +1,236 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "TestMemoryResource.h"
+#include "libargvcodec/MonotonicMemoryResource.h"
+#include "libargvcodec/DecodedCommandLines.h"
+#include "libargvcodec/ArgumentStreamEncoder.h"
+#include "libargvcodec/CallbackOutputSink.h"
+#include "libargvcodec/CmdPromptArgumentCodec.h"
+#include "libargvcodec/CmdPromptStreamDecoder.h"
+#include "libargvcodec/CreateProcessArgumentCodec.h"
+#include "libargvcodec/CreateProcessStreamDecoder.h"
+#include "libargvcodec/TerminalArgumentCodec.h"
+#include "libargvcodec/TerminalStreamDecoder.h"
+
+#include <string>
+#include <cstring> //for strlen()
+#include <new> //for std::bad_alloc
+
+using namespace libargvcodec;
+
+/// <summary>Resource which counts the allocations made from the global heap.</summary>
+class CountingMemoryResource : public virtual IMemoryResource
+{
+public:
+  CountingMemoryResource() : numAllocations(0), numDeallocations(0)
+  {
+  }
+
+  virtual void * allocate(size_t iSize, size_t iAlignment)
+  {
+    numAllocations++;
+    return getDefaultMemoryResource()->allocate(iSize, iAlignment);
+  }
+
+  virtual void deallocate(void * iPointer, size_t iSize, size_t iAlignment)
+  {
+    numDeallocations++;
+    getDefaultMemoryResource()->deallocate(iPointer, iSize, iAlignment);
+  }
+
+  size_t numAllocations;
+  size_t numDeallocations;
+};
+
+static bool appendToScratch(const char * iBuffer, size_t iLength, void * iUserData)
+{
+  std::string * str = (std::string *)iUserData;
+  str->append(iBuffer, iLength);
+  return true;
+}
+
+void TestMemoryResource::SetUp()
+{
+}
+
+void TestMemoryResource::TearDown()
+{
+}
+
+TEST_F(TestMemoryResource, testMonotonicBuffer)
+{
+  CountingMemoryResource upstream;
+  char buffer[256];
+  MonotonicMemoryResource arena(buffer, sizeof(buffer), &upstream);
+
+  //allocations are served from the initial buffer
+  void * a = arena.allocate(3, 1);
+  void * b = arena.allocate(8, 8);
+  ASSERT_TRUE(a >= (void*)buffer && a < (void*)(buffer + sizeof(buffer)));
+  ASSERT_TRUE(b >= (void*)buffer && b < (void*)(buffer + sizeof(buffer)));
+  ASSERT_EQ(0, (size_t)b % 8);
+  ASSERT_EQ(0, upstream.numAllocations);
+  ASSERT_EQ(0, arena.getNumChunks());
+
+  //deallocate does nothing
+  arena.deallocate(b, 8, 8);
+  void * c = arena.allocate(8, 8);
+  ASSERT_NE(b, c);
+
+  //a chunk is allocated from upstream once the buffer is full
+  void * d = arena.allocate(1000, 16);
+  ASSERT_EQ(0, (size_t)d % 16);
+  ASSERT_EQ(1, upstream.numAllocations);
+  ASSERT_EQ(1, arena.getNumChunks());
+  ASSERT_GE(arena.getNumBytes(), 1000 + 3 + 8 + 8);
+
+  //release() returns the chunks and reuses the buffer
+  arena.release();
+  ASSERT_EQ(1, upstream.numDeallocations);
+  ASSERT_EQ(0, arena.getNumBytes());
+  ASSERT_EQ(a, arena.allocate(3, 1));
+}
+
+TEST_F(TestMemoryResource, testMonotonicChunks)
+{
+  CountingMemoryResource upstream;
+  {
+    MonotonicMemoryResource arena(&upstream);
+    for(size_t i=0; i<1000; i++)
+    {
+      arena.allocate(100, 8);
+    }
+
+    //chunk sizes grow geometrically
+    ASSERT_LE(arena.getNumChunks(), 6);
+    ASSERT_EQ(arena.getNumChunks(), upstream.numAllocations);
+  }
+
+  //the destructor releases all chunks
+  ASSERT_EQ(upstream.numAllocations, upstream.numDeallocations);
+}
+
+TEST_F(TestMemoryResource, testMonotonicHugeAllocation)
+{
+  CountingMemoryResource upstream;
+  MonotonicMemoryResource arena(&upstream);
+
+  //a chunk can not be large enough without overflowing its size
+  const size_t huge = (size_t)-1 / 2 + 1;
+  ASSERT_THROW(arena.allocate(huge, 1), std::bad_alloc);
+  ASSERT_THROW(arena.allocate((size_t)-1 - 64, 8), std::bad_alloc);
+  ASSERT_EQ(0, upstream.numAllocations);
+
+  //the arena is still usable
+  ASSERT_TRUE(arena.allocate(100, 8) != NULL);
+  ASSERT_EQ(1, upstream.numAllocations);
+}
+
+TEST_F(TestMemoryResource, testAllocator)
+{
+  MonotonicMemoryResource arena;
+  ResourceAllocator<char> a(&arena);
+  ResourceAllocator<size_t> b(a);
+  ResourceAllocator<char> c;
+  ASSERT_TRUE(a == b);
+  ASSERT_TRUE(a != c);
+  ASSERT_EQ(getDefaultMemoryResource(), c.getResource());
+  ASSERT_EQ(getDefaultMemoryResource(), ResourceAllocator<char>(NULL).getResource());
+
+  //copies of a container use the default resource
+  DecodedCommandLines decoded(&arena);
+  decoded.onArgument("foo", 3);
+  decoded.endCommandLine();
+  ASSERT_EQ(&arena, decoded.getArena().get_allocator().getResource());
+  DecodedCommandLines copy = decoded;
+  ASSERT_EQ(getDefaultMemoryResource(), copy.getArena().get_allocator().getResource());
+  ASSERT_STREQ("foo", copy.getArgument(0, 0));
+}
+
+template <typename StreamDecoder>
+static void testDecodeOnArena(const char * iCmdLine, size_t iExpectedArgc)
+{
+  //the upstream counts any allocation which does not fit in the buffer
+  CountingMemoryResource upstream;
+  static char buffer[65536];
+  MonotonicMemoryResource arena(buffer, sizeof(buffer), &upstream);
+
+  DecodedCommandLines decoded(&arena);
+  {
+    StreamDecoder decoder(decoded, &arena);
+    ASSERT_TRUE(decoder.feed(iCmdLine, strlen(iCmdLine)));
+    ASSERT_TRUE(decoder.finish());
+    decoded.endCommandLine();
+  }
+
+  ASSERT_EQ(1, decoded.getNumCommandLines());
+  ASSERT_EQ(iExpectedArgc, decoded.getArgc(0));
+  ASSERT_GT(arena.getNumBytes(), 0);
+  ASSERT_EQ(0, upstream.numAllocations);
+}
+
+TEST_F(TestMemoryResource, testDecodeOnArena)
+{
+  //arguments longer than the small string buffer of std::string
+  static const char * cmdLine = "\"a long argument which requires an allocation\" \"another long argument with \\\" quotes\" foo";
+  testDecodeOnArena<CmdPromptStreamDecoder>(cmdLine, 3);
+  testDecodeOnArena<CreateProcessStreamDecoder>(cmdLine, 3);
+  testDecodeOnArena<TerminalStreamDecoder>(cmdLine, 3);
+}
+
+static void testEncodeOnArena(const IArgumentEncoder & iEncoder)
+{
+  ArgumentList arglist;
+  ArgumentList::StringList args;
+  args.push_back("foo.exe");
+  args.push_back("a long argument which requires an allocation");
+  args.push_back("with \"quotes\" and \\backslashes\\");
+  args.push_back("");
+  args.push_back("bar");
+  arglist.init(args);
+
+  CountingMemoryResource upstream;
+  static char buffer[65536];
+  MonotonicMemoryResource arena(buffer, sizeof(buffer), &upstream);
+
+  std::string actual;
+  {
+    CallbackOutputSink sink(&appendToScratch, &actual, 16);
+    ArgumentStreamEncoder encoder(iEncoder, sink, &arena);
+    ASSERT_TRUE(encoder.encodeCommandLine(arglist));
+    ASSERT_TRUE(encoder.flush());
+  }
+
+  ASSERT_EQ(iEncoder.encodeCommandLine(arglist), actual);
+  ASSERT_GT(arena.getNumBytes(), 0);
+  ASSERT_EQ(0, upstream.numAllocations);
+}
+
+TEST_F(TestMemoryResource, testEncodeOnArena)
+{
+  testEncodeOnArena(CmdPromptArgumentCodec());
+  testEncodeOnArena(CreateProcessArgumentCodec());
+  testEncodeOnArena(TerminalArgumentCodec());
+}
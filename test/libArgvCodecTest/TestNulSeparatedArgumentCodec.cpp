@@ -0,0 +1,215 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "TestNulSeparatedArgumentCodec.h"
+#include "libargvcodec/NulSeparatedArgumentCodec.h"
+#include "libargvcodec/ProcessCommandLineReader.h"
+#include "libargvcodec/DecodedCommandLines.h"
+#include "rapidassist/process.h"
+#include "TestUtils.h"
+
+#ifdef __linux__
+#include <unistd.h> //for getpid(), pipe(), read(), close()
+#include <spawn.h> //for posix_spawn()
+#include <sys/wait.h> //for waitpid()
+extern char ** environ;
+#endif
+
+using namespace libargvcodec;
+
+void TestNulSeparatedArgumentCodec::SetUp()
+{
+}
+
+void TestNulSeparatedArgumentCodec::TearDown()
+{
+}
+
+TEST_F(TestNulSeparatedArgumentCodec, testEncodeCommandLine)
+{
+  NulSeparatedArgumentCodec codec;
+
+  ArgumentList arglist;
+  arglist.insert("foo.exe");
+  arglist.insert("a b");
+  arglist.insert("\"quoted\"");
+  arglist.insert("$HOME");
+
+  std::string cmdline = codec.encodeCommandLine(arglist);
+  ASSERT_EQ(std::string("a b\0\"quoted\"\0$HOME\0", 19), cmdline);
+
+  //arguments are not escaped
+  ASSERT_EQ(std::string("a \"b\" c"), codec.encodeArgument("a \"b\" c"));
+}
+
+TEST_F(TestNulSeparatedArgumentCodec, testDecodeCommandLine)
+{
+  NulSeparatedArgumentCodec codec;
+
+  //the list is terminated by an empty argument
+  ArgumentList arglist = codec.decodeCommandLine(std::string("a b\0c\0\0ignored\0", 16).c_str());
+  ASSERT_EQ(3, arglist.getArgc());
+  ASSERT_EQ(ra::process::getCurrentProcessPath(), std::string(arglist.getArgument(0)));
+  ASSERT_EQ(std::string("a b"), std::string(arglist.getArgument(1)));
+  ASSERT_EQ(std::string("c"), std::string(arglist.getArgument(2)));
+
+  //encoded command lines are decoded with c_str()
+  ArgumentList expected;
+  expected.insert("foo.exe");
+  expected.insert("\\\"");
+  expected.insert("'&|<>'");
+  expected.insert("tab\tnewline\n");
+  std::string cmdline = codec.encodeCommandLine(expected);
+  ArgumentList decoded = codec.decodeCommandLine(cmdline.c_str());
+  ASSERT_EQ(expected.getArgc(), decoded.getArgc());
+  for(int i=1; i<expected.getArgc(); i++)
+  {
+    ASSERT_EQ(std::string(expected.getArgument(i)), std::string(decoded.getArgument(i)));
+  }
+
+  //empty command line
+  ASSERT_EQ(1, codec.decodeCommandLine("").getArgc());
+}
+
+TEST_F(TestNulSeparatedArgumentCodec, testDecodeArgumentVector)
+{
+  NulSeparatedArgumentCodec codec;
+
+  //empty arguments and a last argument without a NULL terminator
+  const std::string blob("/bin/ls\0\0-l\0last", 16);
+  ArgumentList arglist;
+  ASSERT_TRUE( codec.decodeArgumentVector(blob.data(), blob.size(), arglist) );
+  ASSERT_EQ(4, arglist.getArgc());
+  ASSERT_EQ(std::string("/bin/ls"), std::string(arglist.getArgument(0)));
+  ASSERT_EQ(std::string(""), std::string(arglist.getArgument(1)));
+  ASSERT_EQ(std::string("-l"), std::string(arglist.getArgument(2)));
+  ASSERT_EQ(std::string("last"), std::string(arglist.getArgument(3)));
+
+  DecodedCommandLines decoded;
+  ASSERT_TRUE( codec.decodeArgumentVector(blob.data(), blob.size(), decoded) );
+  decoded.endCommandLine();
+  ASSERT_EQ(1, decoded.getNumCommandLines());
+  ASSERT_EQ(4, decoded.getArgc(0));
+  for(int i=0; i<arglist.getArgc(); i++)
+  {
+    ASSERT_EQ(std::string(arglist.getArgument(i)), std::string(decoded.getArgument(0, i)));
+  }
+
+  //empty blob
+  ASSERT_TRUE( codec.decodeArgumentVector("", 0, arglist) );
+  ASSERT_EQ(0, arglist.getArgc());
+
+  ASSERT_FALSE( codec.decodeArgumentVector(NULL, 0, arglist) );
+}
+
+#ifdef __linux__
+TEST_F(TestNulSeparatedArgumentCodec, testProcessCommandLineReader)
+{
+  ASSERT_TRUE( ProcessCommandLineReader::isSupported() );
+
+  ProcessCommandLineReader reader;
+
+  //read the arguments of the current process
+  ArgumentList arguments;
+  ASSERT_TRUE( reader.read((int)getpid(), arguments) );
+  ASSERT_GE(arguments.getArgc(), 1);
+  ASSERT_NE(std::string::npos, std::string(arguments.getArgument(0)).find("libargvcodec_unittest"));
+
+  //read all processes
+  std::vector<int> pids;
+  DecodedCommandLines cmdlines;
+  ASSERT_TRUE( reader.readAll(pids, cmdlines) );
+  ASSERT_EQ(pids.size(), cmdlines.getNumCommandLines());
+
+  bool found = false;
+  for(size_t i=0; i<pids.size(); i++)
+  {
+    if (i > 0)
+    {
+      ASSERT_LT(pids[i-1], pids[i]);
+    }
+    if (pids[i] == (int)getpid())
+    {
+      found = true;
+      ASSERT_EQ((size_t)arguments.getArgc(), cmdlines.getArgc(i));
+      for(int j=0; j<arguments.getArgc(); j++)
+      {
+        ASSERT_EQ(std::string(arguments.getArgument(j)), std::string(cmdlines.getArgument(i, j)));
+      }
+    }
+  }
+  ASSERT_TRUE( found );
+
+  //process that does not exist
+  ASSERT_FALSE( reader.read(-1, arguments) );
+}
+
+TEST_F(TestNulSeparatedArgumentCodec, testProcessCommandLineReaderLargeArguments)
+{
+  //spawn a shell which waits on its standard input with an argument larger than the default buffer
+  const std::string large_argument(ProcessCommandLineReader::DEFAULT_BUFFER_SIZE + 1000, 'x');
+
+  int input[2];
+  int output[2];
+  ASSERT_EQ(0, pipe(input));
+  ASSERT_EQ(0, pipe(output));
+
+  posix_spawn_file_actions_t actions;
+  posix_spawn_file_actions_init(&actions);
+  posix_spawn_file_actions_adddup2(&actions, input[0], STDIN_FILENO);
+  posix_spawn_file_actions_adddup2(&actions, output[1], STDOUT_FILENO);
+  posix_spawn_file_actions_addclose(&actions, input[0]);
+  posix_spawn_file_actions_addclose(&actions, input[1]);
+  posix_spawn_file_actions_addclose(&actions, output[0]);
+  posix_spawn_file_actions_addclose(&actions, output[1]);
+
+  char * argv[] = {(char*)"/bin/sh", (char*)"-c", (char*)"echo; read line", (char*)"sh", (char*)large_argument.c_str(), (char*)"last", NULL};
+  pid_t pid = 0;
+  int error = posix_spawn(&pid, "/bin/sh", &actions, NULL, argv, environ);
+  posix_spawn_file_actions_destroy(&actions);
+  close(input[0]);
+  close(output[1]);
+  ASSERT_EQ(0, error);
+
+  //the arguments of the shell are only visible once its execution has started
+  char ready = 0;
+  bool started = (read(output[0], &ready, 1) == 1);
+  close(output[0]);
+
+  ProcessCommandLineReader reader;
+  ArgumentList arguments;
+  bool success = started && reader.read((int)pid, arguments);
+
+  //closing the standard input of the shell ends it
+  close(input[1]);
+  int status = 0;
+  waitpid(pid, &status, 0);
+
+  ASSERT_TRUE( started );
+  ASSERT_TRUE( success );
+  ASSERT_EQ(6, arguments.getArgc());
+  ASSERT_EQ(large_argument, std::string(arguments.getArgument(4)));
+  ASSERT_EQ(std::string("last"), std::string(arguments.getArgument(5)));
+}
+#endif //__linux__
@@ -0,0 +1,236 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "TestResponseFiles.h"
+#include "libargvcodec/CmdPromptArgumentCodec.h"
+#include "libargvcodec/CreateProcessArgumentCodec.h"
+#include "libargvcodec/TerminalArgumentCodec.h"
+#include "libargvcodec/ResponseFileEncoder.h"
+#include "TestUtils.h"
+
+#include <cstdio>
+
+using namespace libargvcodec;
+
+static const char * gResponseFiles[] = {
+  "TestResponseFiles.a.rsp",
+  "TestResponseFiles.b.rsp",
+  "TestResponseFiles.c.rsp",
+};
+static const size_t gNumResponseFiles = sizeof(gResponseFiles)/sizeof(gResponseFiles[0]);
+
+void TestResponseFiles::SetUp()
+{
+}
+
+void TestResponseFiles::TearDown()
+{
+  for(size_t i=0; i<gNumResponseFiles; i++)
+  {
+    remove(gResponseFiles[i]);
+  }
+}
+
+bool writeTextFile(const char * iPath, const char * iContent)
+{
+  FILE * f = fopen(iPath, "wb");
+  if (f == NULL)
+    return false;
+  fputs(iContent, f);
+  fclose(f);
+  return true;
+}
+
+ArgumentList buildArgumentList(const char * iArg1, const char * iArg2, const char * iArg3)
+{
+  ra::strings::StringVector args;
+  args.push_back("foo.exe");
+  args.push_back(iArg1);
+  args.push_back(iArg2);
+  args.push_back(iArg3);
+
+  ArgumentList arglist;
+  arglist.init(args);
+  return arglist;
+}
+
+TEST_F(TestResponseFiles, testExpandResponseFiles)
+{
+  ASSERT_TRUE( writeTextFile(gResponseFiles[0], "a \"b c\"\r\nd\n\n e") );
+
+  CmdPromptArgumentCodec codec;
+  ArgumentList arglist = buildArgumentList("first", "@TestResponseFiles.a.rsp", "last");
+  ASSERT_TRUE( codec.expandResponseFiles(arglist) );
+
+  ASSERT_EQ(7, arglist.getArgc());
+  ASSERT_EQ(std::string("foo.exe"), arglist.getArgument(0));
+  ASSERT_EQ(std::string("first"),   arglist.getArgument(1));
+  ASSERT_EQ(std::string("a"),       arglist.getArgument(2));
+  ASSERT_EQ(std::string("b c"),     arglist.getArgument(3));
+  ASSERT_EQ(std::string("d"),       arglist.getArgument(4));
+  ASSERT_EQ(std::string("e"),       arglist.getArgument(5));
+  ASSERT_EQ(std::string("last"),    arglist.getArgument(6));
+}
+
+TEST_F(TestResponseFiles, testCodecQuotingRules)
+{
+  ASSERT_TRUE( writeTextFile(gResponseFiles[0], "'a b' c\\ d \"e\\\\f\"") );
+
+  //Linux terminal quoting rules
+  {
+    TerminalArgumentCodec codec;
+    ArgumentList arglist = buildArgumentList("@TestResponseFiles.a.rsp", "", "@");
+    ASSERT_TRUE( codec.expandResponseFiles(arglist) );
+
+    ASSERT_EQ(6, arglist.getArgc());
+    ASSERT_EQ(std::string("a b"), arglist.getArgument(1));
+    ASSERT_EQ(std::string("c d"), arglist.getArgument(2));
+    ASSERT_EQ(std::string("e\\f"), arglist.getArgument(3));
+    ASSERT_EQ(std::string(""),    arglist.getArgument(4));
+    ASSERT_EQ(std::string("@"),   arglist.getArgument(5)); //not a response file
+  }
+
+  //CreateProcess quoting rules
+  {
+    CreateProcessArgumentCodec codec;
+    ArgumentList arglist = buildArgumentList("@TestResponseFiles.a.rsp", "x", "y");
+    ASSERT_TRUE( codec.expandResponseFiles(arglist) );
+
+    ASSERT_EQ(8, arglist.getArgc());
+    ASSERT_EQ(std::string("'a"),    arglist.getArgument(1));
+    ASSERT_EQ(std::string("b'"),    arglist.getArgument(2));
+    ASSERT_EQ(std::string("c\\"),   arglist.getArgument(3));
+    ASSERT_EQ(std::string("d"),     arglist.getArgument(4));
+    ASSERT_EQ(std::string("e\\\\f"), arglist.getArgument(5));
+    ASSERT_EQ(std::string("x"),     arglist.getArgument(6));
+  }
+}
+
+TEST_F(TestResponseFiles, testNestedResponseFiles)
+{
+  ASSERT_TRUE( writeTextFile(gResponseFiles[0], "a @TestResponseFiles.b.rsp d") );
+  ASSERT_TRUE( writeTextFile(gResponseFiles[1], "b\n@TestResponseFiles.c.rsp") );
+  ASSERT_TRUE( writeTextFile(gResponseFiles[2], "c") );
+
+  TerminalArgumentCodec codec;
+  ArgumentList arglist = buildArgumentList("@TestResponseFiles.a.rsp", "@TestResponseFiles.c.rsp", "e");
+  ASSERT_TRUE( codec.expandResponseFiles(arglist) );
+
+  ASSERT_EQ(7, arglist.getArgc());
+  ASSERT_EQ(std::string("a"), arglist.getArgument(1));
+  ASSERT_EQ(std::string("b"), arglist.getArgument(2));
+  ASSERT_EQ(std::string("c"), arglist.getArgument(3));
+  ASSERT_EQ(std::string("d"), arglist.getArgument(4));
+  ASSERT_EQ(std::string("c"), arglist.getArgument(5)); //a file can be expanded multiple times
+  ASSERT_EQ(std::string("e"), arglist.getArgument(6));
+}
+
+TEST_F(TestResponseFiles, testCycles)
+{
+  ASSERT_TRUE( writeTextFile(gResponseFiles[0], "a @TestResponseFiles.b.rsp") );
+  ASSERT_TRUE( writeTextFile(gResponseFiles[1], "b @./TestResponseFiles.a.rsp") );
+
+  TerminalArgumentCodec codec;
+  ArgumentList arglist = buildArgumentList("x", "@TestResponseFiles.a.rsp", "y");
+  ArgumentList original = arglist;
+  ASSERT_FALSE( codec.expandResponseFiles(arglist) );
+  ASSERT_TRUE( arglist == original ); //unchanged on failure
+}
+
+TEST_F(TestResponseFiles, testMissingAndEmptyFiles)
+{
+  TerminalArgumentCodec codec;
+
+  ArgumentList arglist = buildArgumentList("x", "@TestResponseFiles.missing.rsp", "y");
+  ASSERT_FALSE( codec.expandResponseFiles(arglist) );
+
+  ASSERT_TRUE( writeTextFile(gResponseFiles[0], "") );
+  arglist = buildArgumentList("x", "@TestResponseFiles.a.rsp", "y");
+  ASSERT_TRUE( codec.expandResponseFiles(arglist) );
+  ASSERT_EQ(3, arglist.getArgc());
+  ASSERT_EQ(std::string("x"), arglist.getArgument(1));
+  ASSERT_EQ(std::string("y"), arglist.getArgument(2));
+}
+
+void testResponseFileEncoder(IArgumentEncoder & iEncoder, IArgumentDecoder & iDecoder)
+{
+  //build a long list of arguments
+  ra::strings::StringVector args;
+  args.push_back("foo.exe");
+  for(int i=0; i<500; i++)
+  {
+    char value[64];
+    sprintf(value, "file %03d \"name\".txt", i);
+    args.push_back(value);
+  }
+  ArgumentList arglist;
+  arglist.init(args);
+
+  ResponseFileEncoder encoder(iEncoder);
+  static const size_t MAX_LENGTH = 1000;
+  std::string cmdline;
+  std::string response_file;
+  ASSERT_TRUE( encoder.encodeCommandLine(arglist, MAX_LENGTH, gResponseFiles[0], cmdline, response_file) );
+  ASSERT_EQ(std::string(gResponseFiles[0]), response_file);
+  ASSERT_LE(cmdline.size(), MAX_LENGTH);
+
+  //decode and expand the generated command line
+  ArgumentList actual = iDecoder.decodeCommandLine(cmdline.c_str());
+  actual.replace(0, "foo.exe");
+  ASSERT_TRUE( actual.getArgc() < arglist.getArgc() );
+  ASSERT_EQ(std::string("@") + gResponseFiles[0], actual.getArgument(actual.getArgc()-1));
+
+  CmdPromptArgumentCodec * cmdprompt = dynamic_cast<CmdPromptArgumentCodec *>(&iDecoder);
+  TerminalArgumentCodec * terminal = dynamic_cast<TerminalArgumentCodec *>(&iDecoder);
+  if (cmdprompt)
+  {
+    ASSERT_TRUE( cmdprompt->expandResponseFiles(actual) );
+  }
+  if (terminal)
+  {
+    ASSERT_TRUE( terminal->expandResponseFiles(actual) );
+  }
+
+  ASSERT_TRUE( actual == arglist );
+
+  //short command lines do not need a response file
+  ASSERT_TRUE( encoder.encodeCommandLine(arglist, 1000000, gResponseFiles[1], cmdline, response_file) );
+  ASSERT_TRUE( response_file.empty() );
+  ASSERT_EQ(iEncoder.encodeCommandLine(arglist), cmdline);
+
+  //the response file argument must fit
+  ASSERT_FALSE( encoder.encodeCommandLine(arglist, 10, gResponseFiles[1], cmdline, response_file) );
+}
+
+TEST_F(TestResponseFiles, testResponseFileEncoder)
+{
+  CmdPromptArgumentCodec cmdprompt;
+  testResponseFileEncoder(cmdprompt, cmdprompt);
+
+  CreateProcessArgumentCodec createprocess;
+  testResponseFileEncoder(createprocess, createprocess);
+
+  TerminalArgumentCodec terminal;
+  testResponseFileEncoder(terminal, terminal);
+}
@@ -0,0 +1,119 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "TestStats.h"
+#include "libargvcodec/Stats.h"
+#include "libargvcodec/ArgumentList.h"
+#include "libargvcodec/TerminalArgumentCodec.h"
+
+#include <string>
+#include <thread>
+
+using namespace libargvcodec;
+
+void TestStats::SetUp()
+{
+  stats::resetCounters();
+}
+
+void TestStats::TearDown()
+{
+}
+
+TEST_F(TestStats, testDisabled)
+{
+  if (stats::isEnabled())
+    return; //nothing to test
+
+  TerminalArgumentCodec codec;
+  ArgumentList arglist = codec.decodeCommandLine("foo bar baz");
+  ASSERT_EQ(4, arglist.getArgc());
+
+  stats::Counters counters;
+  stats::getCounters(counters);
+  ASSERT_EQ(0, counters.calls);
+  ASSERT_EQ(0, counters.allocations);
+  ASSERT_EQ(0, counters.bytes);
+  ASSERT_EQ(0, counters.argvRebuilds);
+}
+
+TEST_F(TestStats, testCounters)
+{
+  if (!stats::isEnabled())
+    return; //the library is not instrumented
+
+  TerminalArgumentCodec codec;
+  ArgumentList arglist = codec.decodeCommandLine("foo \"a long argument which is not a small string\" baz");
+  ASSERT_EQ(4, arglist.getArgc());
+
+  stats::Counters counters;
+  stats::getLastCallCounters(counters);
+  ASSERT_EQ(1, counters.calls);
+  ASSERT_GT(counters.allocations, 0);
+  ASSERT_GT(counters.bytes, 0);
+  ASSERT_GE(counters.argvRebuilds, 1);
+
+  //findValue() delegates to other public methods but counts as a single call
+  int index = 0;
+  std::string value;
+  arglist.findValue("--missing=", index, value);
+  stats::getCounters(counters);
+  ASSERT_EQ(2, counters.calls);
+
+  //allocations outside of the library are not counted
+  stats::Counters before;
+  stats::getCounters(before);
+  std::string * s = new std::string(100, 'a');
+  delete s;
+  stats::getCounters(counters);
+  ASSERT_EQ(before.allocations, counters.allocations);
+
+  stats::resetCounters();
+  stats::getCounters(counters);
+  ASSERT_EQ(0, counters.calls);
+  ASSERT_EQ(0, counters.allocations);
+}
+
+static void decodeInThread(stats::Counters * oCounters)
+{
+  TerminalArgumentCodec codec;
+  codec.decodeCommandLine("foo bar");
+  stats::getCounters(*oCounters);
+}
+
+TEST_F(TestStats, testPerThread)
+{
+  if (!stats::isEnabled())
+    return; //the library is not instrumented
+
+  stats::Counters threadCounters;
+  std::thread t(decodeInThread, &threadCounters);
+  t.join();
+  ASSERT_EQ(1, threadCounters.calls);
+
+  //the counters of the current thread are unchanged
+  stats::Counters counters;
+  stats::getCounters(counters);
+  ASSERT_EQ(0, counters.calls);
+}
@@ -24,12 +24,14 @@
 
 #include "TestTerminalArgumentCodec.h"
 #include "libargvcodec/TerminalArgumentCodec.h"
+#include "libargvcodec/TerminalStreamDecoder.h"
 #include "rapidassist/strings.h"
 #include "rapidassist/gtesthelp.h"
 #include "rapidassist/filesystem.h"
 #include "rapidassist/process.h"
 #include "rapidassist/cppencoder.h"
 #include "TestUtils.h"
+#include "CorpusGenerator.h"
 
 using namespace libargvcodec;
 
@@ -708,3 +710,202 @@ TEST_F(TestTerminalArgumentCodec, testPrintableCharacters)
 #endif // __linux__
   }
 }
+
+TEST_F(TestTerminalArgumentCodec, testStreamDecoder_testfile)
+{
+  //The objective of this unit test is to validate that TerminalStreamDecoder decodes the content of file 'Test.CommandLines.Linux.txt' regardless of the size of the chunks.
+
+  ArgumentCollector collector;
+  libargvcodec::TerminalStreamDecoder decoder(collector);
+
+  std::string test_file = "Test.CommandLines.Linux.txt";
+
+  TEST_DATA_LIST items;
+  bool file_loaded = loadCommandLineTestFile(test_file, items);
+  ASSERT_TRUE( file_loaded );
+
+  static const size_t CHUNK_SIZES[] = {1, 2, 3, 5, 8, 1024};
+  static const size_t NUM_CHUNK_SIZES = sizeof(CHUNK_SIZES)/sizeof(CHUNK_SIZES[0]);
+
+  for(size_t i=0; i<items.size(); i++)
+  {
+    const TEST_DATA & td = items[i];
+
+    //get command line and arguments from the file:
+    const std::string & file_cmdline = td.cmdline;
+    const ra::strings::StringVector & file_arguments = td.arguments;
+
+    for(size_t j=0; j<NUM_CHUNK_SIZES; j++)
+    {
+      //decode the command line in chunks
+      collector.arguments.clear();
+      bool decoded = decodeInChunks(decoder, file_cmdline, CHUNK_SIZES[j]);
+      ASSERT_TRUE( decoded );
+
+      //build a meaningful error message
+      std::string error_message = buildErrorString(file_cmdline, file_arguments, collector.arguments);
+
+      //assert decoded arguments are equals to file arguments
+      ASSERT_EQ(file_arguments.size(), collector.arguments.size()) << error_message << "chunk size: " << CHUNK_SIZES[j];
+      for(size_t k=0; k<file_arguments.size(); k++)
+      {
+        const std::string & expected_argument = file_arguments[k];
+        const std::string & decoded_argument  = collector.arguments[k];
+        ASSERT_EQ(expected_argument, decoded_argument) << error_message << "chunk size: " << CHUNK_SIZES[j];
+      }
+    }
+  }
+}
+
+#ifdef __linux__
+TEST_F(TestTerminalArgumentCodec, testShowArgsServer_testfile)
+{
+  //The objective of this unit test is to validate that the persistent showargs server
+  //evaluates each command line of file 'Test.CommandLines.Linux.txt' exactly like a freshly spawned shell.
+
+  std::string test_file = "Test.CommandLines.Linux.txt";
+
+  TEST_DATA_LIST items;
+  bool file_loaded = loadCommandLineTestFile(test_file, items);
+  ASSERT_TRUE( file_loaded );
+
+  for(size_t i=0; i<items.size(); i++)
+  {
+    const std::string & file_cmdline = items[i].cmdline;
+
+    ra::strings::StringVector shell_arguments;
+    bool shell_success = getArgumentsFromShell(file_cmdline, shell_arguments);
+    ASSERT_TRUE( shell_success );
+
+    ra::strings::StringVector server_arguments;
+    bool server_success = getArgumentsFromShowArgsServer(file_cmdline, server_arguments);
+    ASSERT_TRUE( server_success );
+
+    //build a meaningful error message
+    std::string error_message = buildErrorString(file_cmdline, shell_arguments, server_arguments);
+
+    ASSERT_EQ(shell_arguments, server_arguments) << error_message;
+  }
+}
+
+TEST_F(TestTerminalArgumentCodec, testShowArgsNulFormat)
+{
+  //The objective of this unit test is to validate that showargs reports arguments
+  //containing newlines, spaces or nothing at all exactly when asked for the nul format.
+
+  ra::strings::StringVector arguments;
+  arguments.push_back("foo\nbar");
+  arguments.push_back("");
+  arguments.push_back("\n");
+  arguments.push_back(" spaced out ");
+  arguments.push_back("tab\there\r\n");
+  arguments.push_back("--showargs-format=text");
+
+  ra::strings::StringVector system_arguments;
+  ASSERT_TRUE( getArgumentsFromShowArgs(arguments, system_arguments) );
+  ASSERT_EQ(arguments, system_arguments);
+}
+
+TEST_F(TestTerminalArgumentCodec, testShowArgsServer_isolation)
+{
+  //The objective of this unit test is to validate that a command line evaluated by the showargs server
+  //does not affect the following command lines: background jobs are completed before the command line's status
+  //is returned and the shell state (variables, options, directory) is not shared between command lines.
+
+  ra::strings::StringVector arguments;
+
+  //background job
+  ASSERT_TRUE( getArgumentsFromShowArgsServer("a & sleep 0", arguments) );
+  ASSERT_EQ(1, arguments.size());
+  ASSERT_EQ("a", arguments[0]);
+  ASSERT_TRUE( getArgumentsFromShowArgsServer("c d", arguments) );
+  ASSERT_EQ(2, arguments.size());
+  ASSERT_EQ("c", arguments[0]);
+  ASSERT_EQ("d", arguments[1]);
+
+  //variable assignment
+  ASSERT_TRUE( getArgumentsFromShowArgsServer("showargs_test_value=leaked; x", arguments) );
+  ASSERT_TRUE( getArgumentsFromShowArgsServer("\"$showargs_test_value\"", arguments) );
+  ASSERT_EQ(1, arguments.size());
+  ASSERT_EQ("", arguments[0]);
+
+  //shell options
+  ASSERT_TRUE( getArgumentsFromShowArgsServer("set -f; x", arguments) );
+  ASSERT_TRUE( getArgumentsFromShowArgsServer("/bi[n]", arguments) );
+  ASSERT_EQ(1, arguments.size());
+  ASSERT_EQ("/bin", arguments[0]);
+
+  //current directory
+  ASSERT_TRUE( getArgumentsFromShowArgsServer("cd /; x", arguments) );
+  ASSERT_TRUE( getArgumentsFromShowArgsServer("\"$PWD\"", arguments) );
+  ASSERT_EQ(1, arguments.size());
+  ASSERT_NE("/", arguments[0]);
+}
+
+TEST_F(TestTerminalArgumentCodec, testShowArgsServer_shellState)
+{
+  //The objective of this unit test is to validate that a command line evaluated by the showargs server
+  //sees the same variables, positional parameters and redirections as a freshly spawned shell.
+
+  ra::strings::StringVector command_lines;
+  command_lines.push_back("\"$showargs_seq\" \"$showargs_line\" \"$1\" \"$#\" \"$0\"");
+  command_lines.push_back("showargs_seq=1 showargs_line=2; \"$showargs_seq\" \"$showargs_line\"");
+  command_lines.push_back("a > showargs.redirect.tmp");
+  command_lines.push_back("a; b");
+
+  for(size_t i=0; i<command_lines.size(); i++)
+  {
+    const std::string & cmdline = command_lines[i];
+
+    ra::strings::StringVector shell_arguments;
+    bool shell_success = getArgumentsFromShell(cmdline, shell_arguments);
+    ASSERT_TRUE( shell_success );
+
+    ra::strings::StringVector server_arguments;
+    bool server_success = getArgumentsFromShowArgsServer(cmdline, server_arguments);
+    ASSERT_TRUE( server_success );
+
+    //build a meaningful error message
+    std::string error_message = buildErrorString(cmdline, shell_arguments, server_arguments);
+
+    ASSERT_EQ(shell_arguments, server_arguments) << error_message;
+  }
+
+  remove("showargs.redirect.tmp");
+}
+
+TEST_F(TestTerminalArgumentCodec, testEncodeCommandLine_corpus)
+{
+  //The objective of this unit test is to validate TerminalArgumentCodec::encodeCommandLine()
+  //against the system's shell on a generated corpus. The persistent showargs server makes
+  //evaluating thousands of command lines affordable.
+  //The adversarial kinds are skipped: the codec does not escape ';' and escapes '$' and '`' within single quotes.
+
+  libargvcodec::TerminalArgumentCodec codec;
+
+  CorpusGenerator generator(2023);
+  for(int k=0; k<CorpusGenerator::NUM_KINDS; k++)
+  {
+    const CorpusGenerator::Kind kind = (CorpusGenerator::Kind)k;
+    if (kind == CorpusGenerator::ADVERSARIAL || kind == CorpusGenerator::MIXED)
+      continue;
+
+    CorpusGenerator::StringListArray corpus;
+    generator.generateCorpus(kind, 200, 256, corpus);
+    for(size_t i=0; i<corpus.size(); i++)
+    {
+      CorpusGenerator::StringList arguments = corpus[i];
+      arguments.insert(arguments.begin(), "foo.exe");
+      ArgumentList arglist;
+      arglist.init(arguments);
+      std::string cmdline = codec.encodeCommandLine(arglist);
+
+      ra::strings::StringVector system_arguments;
+      bool system_success = getArgumentsFromShowArgsServer(cmdline, system_arguments);
+      ASSERT_TRUE( system_success ) << CorpusGenerator::getKindName(kind) << "\n" << cmdline;
+
+      ASSERT_EQ(corpus[i], system_arguments) << CorpusGenerator::getKindName(kind) << "\n" << buildErrorString(cmdline, corpus[i], system_arguments);
+    }
+  }
+}
+#endif //__linux__
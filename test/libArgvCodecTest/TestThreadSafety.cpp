@@ -0,0 +1,183 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "TestThreadSafety.h"
+#include "libargvcodec/CmdPromptArgumentCodec.h"
+#include "libargvcodec/CreateProcessArgumentCodec.h"
+#include "libargvcodec/TerminalArgumentCodec.h"
+#include "TestUtils.h"
+
+#include <thread>
+#include <atomic>
+
+using namespace libargvcodec;
+
+static const int NUM_WORKER_THREADS = 8;
+static const int NUM_ITERATIONS = 20;
+
+void TestThreadSafety::SetUp()
+{
+}
+
+void TestThreadSafety::TearDown()
+{
+}
+
+/// <summary>Expected results of a codec for the command lines of a test file, computed on a single thread.</summary>
+struct SharedCodecWorkload
+{
+  ra::strings::StringVector cmdlines;     //command lines of the test file
+  std::vector<ArgumentList> decoded;      //decoded command lines
+  std::vector<ArgumentList> arglists;     //arguments of the test file
+  ra::strings::StringVector encoded;      //encoded arguments of the test file
+};
+
+bool loadSharedCodecWorkload(const std::string & iTestFile, const IArgumentEncoder & iEncoder, const IArgumentDecoder & iDecoder, SharedCodecWorkload & oWorkload)
+{
+  TEST_DATA_LIST items;
+  if (!loadCommandLineTestFile(iTestFile, items))
+    return false;
+
+  for(size_t i=0; i<items.size(); i++)
+  {
+    ra::strings::StringVector arguments = items[i].arguments;
+    arguments.insert(arguments.begin(), "foo.exe");
+    ArgumentList arglist;
+    arglist.init(arguments);
+
+    oWorkload.cmdlines.push_back(items[i].cmdline);
+    oWorkload.decoded.push_back(iDecoder.decodeCommandLine(items[i].cmdline.c_str()));
+    oWorkload.arglists.push_back(arglist);
+    oWorkload.encoded.push_back(iEncoder.encodeCommandLine(arglist));
+  }
+  return true;
+}
+
+bool isIdentical(const ArgumentList & iLeft, const ArgumentList & iRight)
+{
+  if (iLeft.getArgc() != iRight.getArgc())
+    return false;
+  for(int i=0; i<iLeft.getArgc(); i++)
+  {
+    if (std::string(iLeft.getArgument(i)) != iRight.getArgument(i))
+      return false;
+  }
+  return true;
+}
+
+/// <summary>Encodes and decodes all items of the workload with the shared codec and counts the results which are not identical to the expected results.</summary>
+void runSharedCodecWorkload(const IArgumentEncoder * iEncoder, const IArgumentDecoder * iDecoder, const SharedCodecWorkload * iWorkload, std::atomic<int> * ioNumErrors)
+{
+  for(int iteration=0; iteration<NUM_ITERATIONS; iteration++)
+  {
+    for(size_t i=0; i<iWorkload->cmdlines.size(); i++)
+    {
+      std::string encoded = iEncoder->encodeCommandLine(iWorkload->arglists[i]);
+      if (encoded != iWorkload->encoded[i])
+        (*ioNumErrors)++;
+
+      ArgumentList decoded = iDecoder->decodeCommandLine(iWorkload->cmdlines[i].c_str());
+      if (!isIdentical(decoded, iWorkload->decoded[i]))
+        (*ioNumErrors)++;
+    }
+  }
+}
+
+template <typename Codec>
+void testSharedCodec(const std::string & iTestFile)
+{
+  //a single immutable codec shared by all threads
+  const Codec codec;
+
+  SharedCodecWorkload workload;
+  ASSERT_TRUE( loadSharedCodecWorkload(iTestFile, codec, codec, workload) );
+
+  std::atomic<int> num_errors(0);
+  std::vector<std::thread> threads;
+  for(int i=0; i<NUM_WORKER_THREADS; i++)
+  {
+    threads.push_back(std::thread(runSharedCodecWorkload, &codec, &codec, &workload, &num_errors));
+  }
+  for(size_t i=0; i<threads.size(); i++)
+  {
+    threads[i].join();
+  }
+
+  ASSERT_EQ(0, num_errors.load());
+}
+
+TEST_F(TestThreadSafety, testSharedCmdPromptArgumentCodec)
+{
+  testSharedCodec<CmdPromptArgumentCodec>("Test.CommandLines.Windows.txt");
+}
+
+TEST_F(TestThreadSafety, testSharedCreateProcessArgumentCodec)
+{
+  testSharedCodec<CreateProcessArgumentCodec>("Test.CommandLines.Windows.txt");
+}
+
+TEST_F(TestThreadSafety, testSharedTerminalArgumentCodec)
+{
+  testSharedCodec<TerminalArgumentCodec>("Test.CommandLines.Linux.txt");
+}
+
+TEST_F(TestThreadSafety, testConcurrentDecodeBatch)
+{
+  //decodeBatch() starts its own threads. Calling it from multiple threads on the same codec must also be safe.
+  const TerminalArgumentCodec codec;
+
+  SharedCodecWorkload workload;
+  ASSERT_TRUE( loadSharedCodecWorkload("Test.CommandLines.Linux.txt", codec, codec, workload) );
+
+  std::vector<const char *> cmdlines;
+  for(size_t i=0; i<workload.cmdlines.size(); i++)
+  {
+    cmdlines.push_back(workload.cmdlines[i].c_str());
+  }
+
+  DecodedCommandLines results[NUM_WORKER_THREADS];
+  std::vector<std::thread> threads;
+  for(int i=0; i<NUM_WORKER_THREADS; i++)
+  {
+    threads.push_back(std::thread(&TerminalArgumentCodec::decodeBatch, &codec, &cmdlines[0], cmdlines.size(), std::ref(results[i]), 2));
+  }
+  for(size_t i=0; i<threads.size(); i++)
+  {
+    threads[i].join();
+  }
+
+  for(int t=0; t<NUM_WORKER_THREADS; t++)
+  {
+    ASSERT_EQ(workload.cmdlines.size(), results[t].getNumCommandLines());
+    for(size_t i=0; i<workload.cmdlines.size(); i++)
+    {
+      const ArgumentList & expected = workload.decoded[i];
+      ASSERT_EQ((size_t)expected.getArgc() - 1, results[t].getArgc(i));
+      for(size_t j=0; j<results[t].getArgc(i); j++)
+      {
+        ASSERT_STREQ(expected.getArgument((int)j + 1), results[t].getArgument(i, j));
+      }
+    }
+  }
+}
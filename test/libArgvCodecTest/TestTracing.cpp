@@ -0,0 +1,184 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "TestTracing.h"
+#include "libargvcodec/Tracing.h"
+#include "libargvcodec/ArgumentList.h"
+#include "libargvcodec/TerminalArgumentCodec.h"
+#include "libargvcodec/CreateProcessArgumentCodec.h"
+
+#include <string>
+#include <thread>
+
+using namespace libargvcodec;
+
+struct EventSummary
+{
+  size_t numEvents[tracing::NUM_PHASES];
+  size_t numArguments[tracing::NUM_PHASES];
+  size_t numBytes[tracing::NUM_PHASES];
+};
+
+static void onEvent(const tracing::Event & iEvent, void * iUserData)
+{
+  EventSummary * summary = (EventSummary*)iUserData;
+  summary->numEvents[iEvent.phase]++;
+  summary->numArguments[iEvent.phase] += iEvent.numArguments;
+  summary->numBytes[iEvent.phase] += iEvent.numBytes;
+}
+
+void TestTracing::SetUp()
+{
+  //discard the events of previous tests
+  std::vector<tracing::Event> events;
+  tracing::collectEvents(events);
+}
+
+void TestTracing::TearDown()
+{
+  tracing::setCallback(NULL, NULL);
+  tracing::setRingBufferEnabled(false);
+  tracing::setSamplingInterval(1);
+}
+
+TEST_F(TestTracing, testPhaseNames)
+{
+  ASSERT_STREQ("classify", tracing::getPhaseName(tracing::PHASE_CLASSIFY));
+  ASSERT_STREQ("escape", tracing::getPhaseName(tracing::PHASE_ESCAPE));
+  ASSERT_STREQ("accumulate", tracing::getPhaseName(tracing::PHASE_ACCUMULATE));
+  ASSERT_STREQ("argumentlist_init", tracing::getPhaseName(tracing::PHASE_ARGUMENT_LIST_INIT));
+}
+
+TEST_F(TestTracing, testDisabled)
+{
+  if (tracing::isEnabled())
+    return; //nothing to test
+
+  EventSummary summary = {};
+  tracing::setCallback(&onEvent, &summary);
+  tracing::setRingBufferEnabled(true);
+
+  TerminalArgumentCodec codec;
+  ArgumentList arglist = codec.decodeCommandLine("foo bar baz");
+  ASSERT_EQ(4, arglist.getArgc());
+
+  ASSERT_EQ(0, summary.numEvents[tracing::PHASE_ACCUMULATE]);
+  std::vector<tracing::Event> events;
+  ASSERT_EQ(0, tracing::collectEvents(events));
+  ASSERT_TRUE(events.empty());
+}
+
+TEST_F(TestTracing, testCallback)
+{
+  if (!tracing::isEnabled())
+    return; //the library has no trace points
+
+  EventSummary summary = {};
+  tracing::setCallback(&onEvent, &summary);
+
+  TerminalArgumentCodec codec;
+  ArgumentList arglist = codec.decodeCommandLine("foo bar baz");
+  ASSERT_EQ(4, arglist.getArgc());
+  ASSERT_EQ(1, summary.numEvents[tracing::PHASE_ACCUMULATE]);
+  ASSERT_EQ(3, summary.numArguments[tracing::PHASE_ACCUMULATE]);
+  ASSERT_EQ(11, summary.numBytes[tracing::PHASE_ACCUMULATE]);
+  //copying the list also initializes an ArgumentList
+  ASSERT_GE(summary.numEvents[tracing::PHASE_ARGUMENT_LIST_INIT], 1);
+  ASSERT_EQ(4*summary.numEvents[tracing::PHASE_ARGUMENT_LIST_INIT], summary.numArguments[tracing::PHASE_ARGUMENT_LIST_INIT]);
+
+  //one event per phase for the whole command line
+  CreateProcessArgumentCodec encoder;
+  std::string cmdLine = encoder.encodeCommandLine(arglist);
+  ASSERT_EQ(1, summary.numEvents[tracing::PHASE_CLASSIFY]);
+  ASSERT_EQ(3, summary.numArguments[tracing::PHASE_CLASSIFY]);
+  ASSERT_EQ(9, summary.numBytes[tracing::PHASE_CLASSIFY]);
+  ASSERT_EQ(1, summary.numEvents[tracing::PHASE_ESCAPE]);
+  ASSERT_EQ(3, summary.numArguments[tracing::PHASE_ESCAPE]);
+  ASSERT_EQ(9, summary.numBytes[tracing::PHASE_ESCAPE]);
+
+  //no more events once the callback is removed
+  tracing::setCallback(NULL, NULL);
+  encoder.encodeCommandLine(arglist);
+  ASSERT_EQ(1, summary.numEvents[tracing::PHASE_CLASSIFY]);
+}
+
+TEST_F(TestTracing, testSampling)
+{
+  if (!tracing::isEnabled())
+    return; //the library has no trace points
+
+  EventSummary summary = {};
+  tracing::setCallback(&onEvent, &summary);
+  tracing::setSamplingInterval(4);
+
+  CreateProcessArgumentCodec codec;
+  for(size_t i=0; i<100; i++)
+  {
+    codec.encodeArgument("foo bar");
+  }
+
+  ASSERT_EQ(25, summary.numEvents[tracing::PHASE_CLASSIFY]);
+  ASSERT_EQ(25, summary.numEvents[tracing::PHASE_ESCAPE]);
+}
+
+static void encodeInThread(size_t iCount)
+{
+  TerminalArgumentCodec codec;
+  for(size_t i=0; i<iCount; i++)
+  {
+    codec.encodeArgument("foo");
+  }
+}
+
+TEST_F(TestTracing, testRingBuffer)
+{
+  if (!tracing::isEnabled())
+    return; //the library has no trace points
+
+  tracing::setRingBufferEnabled(true);
+
+  //the events of a thread are kept after the thread is terminated
+  std::thread t(encodeInThread, 10);
+  t.join();
+
+  std::vector<tracing::Event> events;
+  ASSERT_EQ(0, tracing::collectEvents(events));
+  ASSERT_EQ(20, events.size());
+  for(size_t i=0; i<events.size(); i++)
+  {
+    ASSERT_EQ(1, events[i].numArguments);
+    ASSERT_EQ(3, events[i].numBytes);
+  }
+
+  //events are dropped when the ring buffer is full
+  events.clear();
+  encodeInThread(tracing::RING_BUFFER_CAPACITY);
+  ASSERT_EQ(tracing::RING_BUFFER_CAPACITY, tracing::collectEvents(events));
+  ASSERT_EQ(tracing::RING_BUFFER_CAPACITY, events.size());
+
+  //collecting again returns nothing
+  events.clear();
+  ASSERT_EQ(0, tracing::collectEvents(events));
+  ASSERT_TRUE(events.empty());
+}
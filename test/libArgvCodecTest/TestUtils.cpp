@@ -39,6 +39,14 @@
 #       define WIN32_LEAN_AND_MEAN // Exclude rarely-used stuff from Windows headers
 #   endif /* WIN32_LEAN_AND_MEAN */
 #   include <Windows.h>
+#else
+#   include <spawn.h>     //for posix_spawn()
+#   include <sys/wait.h>  //for waitpid()
+#   include <unistd.h>    //for pipe()
+#   include <fcntl.h>     //for fcntl()
+#   include <signal.h>    //for signal()
+#   include <errno.h>
+extern char ** environ;
 #endif
 
 DynamicStringList gStrings;
@@ -102,6 +110,24 @@ std::string getShowArgsExecutablePath()
   return path;
 }
 
+std::string getToolExecutablePath(const char * iName)
+{
+  std::string path = ra::process::getCurrentProcessPath();
+  ra::strings::replace(path, "libargvcodec_unittest", iName);
+  return path;
+}
+
+bool writeBinaryFile(const std::string & iPath, const std::string & iContent)
+{
+  FILE * f = fopen(iPath.c_str(), "wb");
+  if (f == NULL)
+    return false;
+  bool success = (fwrite(iContent.data(), 1, iContent.size(), f) == iContent.size());
+  success = (fclose(f) == 0) && success;
+  return success;
+}
+
+#ifdef _WIN32
 bool getArgumentsFromSystem(const std::string & iCmdLineString, ra::strings::StringVector & oArguments)
 {
   oArguments.clear();
@@ -113,9 +139,6 @@ bool getArgumentsFromSystem(const std::string & iCmdLineString, ra::strings::Str
 
   //build command line
   std::string cmdline;
-#ifdef __linux__
-  cmdline += "./";
-#endif
   cmdline += getShowArgsExecutablePath();
   cmdline += " ";
   cmdline += iCmdLineString;
@@ -139,18 +162,6 @@ bool getArgumentsFromSystem(const std::string & iCmdLineString, ra::strings::Str
 
   //execute the command line
   int return_code = system(cmdline.c_str());
-#ifdef __linux__
-  if (return_code != 0)
-  {
-    //Verify for the following error: "sh: 1: Syntax error: Unterminated quoted string"
-    //These tests should be ignored since Linux bash does not support unterminated quoted string.
-    //Endding the quoted command line string
-    cmdline.append("\"");
-
-    //and try again
-    return_code = system(cmdline.c_str());
-  }
-#endif
 
   //undefine environment variable to prevent issues when other functions calls showargs executable.
   ra::environment::setEnvironmentVariable(env_var_name, env_var_value);
@@ -205,6 +216,459 @@ bool getArgumentsFromSystem(const std::string & iCmdLineString, ra::strings::Str
   oArguments = system_arguments;
   return true;
 }
+#else
+/// <summary>Builds a copy of the environment of the current process with the given showargs variable.</summary>
+/// <param name="iVariable">The showargs variable in the 'name=value' format. Can be NULL.</param>
+/// <param name="oEnvironment">The NULL terminated list of variables.</param>
+static void buildShowArgsEnvironment(const char * iVariable, std::vector<char*> & oEnvironment)
+{
+  oEnvironment.clear();
+  for(char ** e = environ; *e != NULL; e++)
+  {
+    if (strncmp(*e, "showargs_", 9) != 0 && strncmp(*e, "SHOWARGS_", 9) != 0)
+      oEnvironment.push_back(*e);
+  }
+  if (iVariable)
+    oEnvironment.push_back((char*)iVariable);
+  oEnvironment.push_back(NULL);
+}
+
+/// <summary>Spawns a process and reads its standard output from a pipe.</summary>
+/// <param name="iPath">The path of the executable.</param>
+/// <param name="iArgv">The NULL terminated list of arguments of the process.</param>
+/// <param name="iVariable">The showargs variable in the 'name=value' format given to the process. Can be NULL.</param>
+/// <param name="oOutput">The standard output of the process.</param>
+/// <param name="oExitCode">The exit code of the process.</param>
+/// <returns>Returns true if the process was run. Returns false otherwise.</returns>
+static bool runProcess(const char * iPath, char * const iArgv[], const char * iVariable, std::string & oOutput, int & oExitCode)
+{
+  oOutput.clear();
+  oExitCode = -1;
+
+  //set the showargs variable without changing the environment of the current process
+  std::vector<char*> env;
+  buildShowArgsEnvironment(iVariable, env);
+
+  int fds[2];
+  if (pipe(fds) != 0)
+    return false;
+
+  posix_spawn_file_actions_t actions;
+  posix_spawn_file_actions_init(&actions);
+  posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+  posix_spawn_file_actions_addclose(&actions, fds[0]);
+  posix_spawn_file_actions_addclose(&actions, fds[1]);
+
+  pid_t pid = 0;
+  int error = posix_spawn(&pid, iPath, &actions, NULL, iArgv, &env[0]);
+  posix_spawn_file_actions_destroy(&actions);
+  close(fds[1]);
+  if (error != 0)
+  {
+    close(fds[0]);
+    return false;
+  }
+
+  char buffer[4096];
+  for(;;)
+  {
+    ssize_t count = read(fds[0], buffer, sizeof(buffer));
+    if (count > 0)
+      oOutput.append(buffer, (size_t)count);
+    else if (count == 0 || errno != EINTR)
+      break;
+  }
+  close(fds[0]);
+
+  int status = 0;
+  while (waitpid(pid, &status, 0) < 0)
+  {
+    if (errno != EINTR)
+      return false;
+  }
+  oExitCode = (WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+  return true;
+}
+
+/// <summary>Runs a command line with '/bin/sh -c' and reads the standard output of the shell from a pipe.</summary>
+/// <param name="iCmdLine">The command line to run.</param>
+/// <param name="oOutput">The standard output of the command.</param>
+/// <param name="oExitCode">The exit code of the shell.</param>
+/// <returns>Returns true if the shell was run. Returns false otherwise.</returns>
+static bool runShellCommand(const std::string & iCmdLine, std::string & oOutput, int & oExitCode)
+{
+  //ask showargs for its binary output format
+  char * argv[] = {(char*)"/bin/sh", (char*)"-c", (char*)iCmdLine.c_str(), NULL};
+  return runProcess("/bin/sh", argv, "showargs_format=lenprefix", oOutput, oExitCode);
+}
+
+/// <summary>Parses the binary output of showargs. Each argument is a 32 bits little-endian length followed by the bytes of the argument.</summary>
+static bool parseLengthPrefixedArguments(const std::string & iOutput, ra::strings::StringVector & oArguments)
+{
+  oArguments.clear();
+
+  size_t offset = 0;
+  while (offset < iOutput.size())
+  {
+    if (iOutput.size() - offset < 4)
+      return false;
+    size_t length = 0;
+    for(int j=0; j<4; j++)
+    {
+      length |= ((size_t)(unsigned char)iOutput[offset + j]) << (8*j);
+    }
+    offset += 4;
+
+    if (iOutput.size() - offset < length)
+      return false;
+    oArguments.push_back(iOutput.substr(offset, length));
+    offset += length;
+  }
+  return true;
+}
+
+bool getArgumentsFromShowArgs(const ra::strings::StringVector & iArguments, ra::strings::StringVector & oArguments)
+{
+  oArguments.clear();
+
+  //spawn showargs without a shell and select the nul format with the first argument.
+  //The environment asks for another format to validate that the argument has precedence.
+  const std::string path = "./" + getShowArgsExecutablePath();
+  std::vector<char*> argv;
+  argv.push_back((char*)path.c_str());
+  argv.push_back((char*)"--showargs-format=nul");
+  for(size_t i=0; i<iArguments.size(); i++)
+  {
+    argv.push_back((char*)iArguments[i].c_str());
+  }
+  argv.push_back(NULL);
+
+  std::string output;
+  int return_code = -1;
+  if (!runProcess(path.c_str(), &argv[0], "showargs_format=lenprefix", output, return_code) || return_code != 0)
+    return false;
+
+  //parse 'showargs' output: each argument is followed by a NUL character
+  ra::strings::StringVector system_arguments;
+  size_t offset = 0;
+  while (offset < output.size())
+  {
+    size_t end = output.find('\0', offset);
+    if (end == std::string::npos)
+      return false;
+    system_arguments.push_back(output.substr(offset, end - offset));
+    offset = end + 1;
+  }
+
+  //remove arg[0] from the list
+  if (system_arguments.size() > 0)
+  {
+    system_arguments.erase(system_arguments.begin());
+  }
+
+  oArguments = system_arguments;
+  return true;
+}
+
+bool runTool(const char * iName, const ra::strings::StringVector & iArguments, std::string & oOutput, int & oExitCode)
+{
+  const std::string path = "./" + getToolExecutablePath(iName);
+  std::vector<char*> argv;
+  argv.push_back((char*)path.c_str());
+  for(size_t i=0; i<iArguments.size(); i++)
+  {
+    argv.push_back((char*)iArguments[i].c_str());
+  }
+  argv.push_back(NULL);
+
+  return runProcess(path.c_str(), &argv[0], NULL, oOutput, oExitCode);
+}
+
+bool getArgumentsFromShell(const std::string & iCmdLineString, ra::strings::StringVector & oArguments)
+{
+  oArguments.clear();
+
+  //build command line
+  //the shell replaces itself with showargs instead of forking again
+  std::string cmdline;
+  cmdline += "exec ./";
+  cmdline += getShowArgsExecutablePath();
+  cmdline += " ";
+  cmdline += iCmdLineString;
+
+  //execute the command line
+  std::string output;
+  int return_code = -1;
+  bool success = runShellCommand(cmdline, output, return_code);
+  if (success && return_code != 0)
+  {
+    //Verify for the following error: "sh: 1: Syntax error: Unterminated quoted string"
+    //These tests should be ignored since Linux bash does not support unterminated quoted string.
+    //Endding the quoted command line string
+    cmdline.append("\"");
+
+    //and try again
+    success = runShellCommand(cmdline, output, return_code);
+  }
+
+  if (!success || return_code != 0)
+  {
+    printf("Failed executing command line:%s\n", cmdline.c_str());
+    return false;
+  }
+
+  //parse 'showargs' output
+  ra::strings::StringVector system_arguments;
+  if (!parseLengthPrefixedArguments(output, system_arguments))
+  {
+    printf("Command line '%s' produced an invalid output\n", cmdline.c_str());
+    return false;
+  }
+
+  //remove arg[0] from the list
+  if (system_arguments.size() > 0)
+  {
+    system_arguments.erase(system_arguments.begin());
+  }
+
+  oArguments = system_arguments;
+  return true;
+}
+
+/// <summary>
+/// Client of a showargs process running in server mode.
+/// The server is a long-lived shell which evaluates each command line as the arguments of a showargs shell function.
+/// </summary>
+class ShowArgsServer
+{
+public:
+  ShowArgsServer() :
+    mPid(0),
+    mInput(NULL),
+    mOutput(NULL),
+    mSequence(0)
+  {
+  }
+
+  ~ShowArgsServer()
+  {
+    stop();
+  }
+
+  bool isRunning() const
+  {
+    return mPid != 0;
+  }
+
+  bool start()
+  {
+    stop();
+
+    //a dead server must not kill the test process when a command line is written
+    signal(SIGPIPE, SIG_IGN);
+
+    std::vector<char*> env;
+    buildShowArgsEnvironment("showargs_mode=server", env);
+
+    int input[2];
+    int output[2];
+    if (pipe(input) != 0)
+      return false;
+    if (pipe(output) != 0)
+    {
+      close(input[0]);
+      close(input[1]);
+      return false;
+    }
+
+    //the processes spawned later must not inherit the ends of the current process
+    fcntl(input[1], F_SETFD, FD_CLOEXEC);
+    fcntl(output[0], F_SETFD, FD_CLOEXEC);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, input[0], STDIN_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, output[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addclose(&actions, input[0]);
+    posix_spawn_file_actions_addclose(&actions, output[1]);
+
+    const std::string path = "./" + getShowArgsExecutablePath();
+    char * argv[] = {(char*)path.c_str(), NULL};
+    pid_t pid = 0;
+    int error = posix_spawn(&pid, path.c_str(), &actions, NULL, argv, &env[0]);
+    posix_spawn_file_actions_destroy(&actions);
+    close(input[0]);
+    close(output[1]);
+    if (error != 0)
+    {
+      close(input[1]);
+      close(output[0]);
+      return false;
+    }
+
+    mPid = pid;
+    mInput = fdopen(input[1], "w");
+    mOutput = fdopen(output[0], "r");
+    return true;
+  }
+
+  void stop()
+  {
+    //closing the input ends the loop of the shell
+    if (mInput)
+      fclose(mInput);
+    if (mOutput)
+      fclose(mOutput);
+    if (mPid != 0)
+    {
+      int status = 0;
+      while (waitpid(mPid, &status, 0) < 0 && errno == EINTR)
+      {
+      }
+    }
+    mInput = NULL;
+    mOutput = NULL;
+    mPid = 0;
+  }
+
+  /// <summary>Evaluates a command line.</summary>
+  /// <remarks>Each request is tagged with a sequence number. Records of other requests are skipped.</remarks>
+  /// <param name="iCmdLine">The command line. Must not contain newline characters.</param>
+  /// <param name="oArguments">The arguments of the first call to showargs.</param>
+  /// <param name="oCalled">True if showargs was called.</param>
+  /// <param name="oStatus">The exit status of the command line.</param>
+  /// <returns>Returns true if the server answered. Returns false if the server is dead or if the output of the command line could not be parsed.</returns>
+  bool run(const std::string & iCmdLine, ra::strings::StringVector & oArguments, bool & oCalled, int & oStatus)
+  {
+    oArguments.clear();
+    oCalled = false;
+    oStatus = -1;
+
+    const unsigned long sequence = ++mSequence;
+    if (fprintf(mInput, "%lu %s\n", sequence, iCmdLine.c_str()) < 0 || fflush(mInput) != 0)
+    {
+      stop();
+      return false;
+    }
+
+    std::string record;
+    bool unexpected = false;
+    for(;;)
+    {
+      if (!readRecord(record))
+      {
+        stop();
+        return false;
+      }
+
+      //records are separated by an empty record
+      if (record.empty())
+        continue;
+
+      //the record type is followed by the sequence number and a value
+      const char type = record[0];
+      if (type != 'A' && type != 'S')
+      {
+        //the command line wrote to its standard output.
+        //A spawned showargs would mix this output with its own.
+        printf("Command line '%s' wrote an unexpected output to the showargs server: '%s'\n", iCmdLine.c_str(), record.c_str());
+        unexpected = true;
+        continue;
+      }
+      char * value = NULL;
+      const unsigned long record_sequence = strtoul(record.c_str() + 1, &value, 10);
+      const bool current = (record_sequence == sequence);
+      const int number = atoi(value);
+
+      if (type == 'S')
+      {
+        if (current)
+        {
+          oStatus = number;
+          return !unexpected;
+        }
+        continue;
+      }
+
+      //'A' record followed by the arguments
+      for(int i=0; i<number; i++)
+      {
+        if (!readRecord(record))
+        {
+          stop();
+          return false;
+        }
+        if (current && !oCalled)
+          oArguments.push_back(record);
+      }
+      if (current)
+        oCalled = true;
+    }
+  }
+
+private:
+  bool readRecord(std::string & oRecord)
+  {
+    oRecord.clear();
+    for(;;)
+    {
+      int c = getc(mOutput);
+      if (c == EOF)
+        return false;
+      if (c == '\0')
+        return true;
+      oRecord.push_back((char)c);
+    }
+  }
+
+  pid_t mPid;
+  FILE * mInput;
+  FILE * mOutput;
+  unsigned long mSequence;
+};
+
+static ShowArgsServer gShowArgsServer;
+
+bool getArgumentsFromShowArgsServer(const std::string & iCmdLineString, ra::strings::StringVector & oArguments)
+{
+  oArguments.clear();
+
+  //the server reads one command line per line
+  if (iCmdLineString.find_first_of("\r\n") != std::string::npos)
+    return false;
+
+  if (!gShowArgsServer.isRunning() && !gShowArgsServer.start())
+    return false;
+
+  bool called = false;
+  int status = 0;
+  if (!gShowArgsServer.run(iCmdLineString, oArguments, called, status))
+    return false;
+
+  if (status != 0)
+  {
+    //Verify for the following error: "sh: 1: Syntax error: Unterminated quoted string"
+    //These tests should be ignored since Linux bash does not support unterminated quoted string.
+    //Endding the quoted command line string and try again
+    if (!gShowArgsServer.run(iCmdLineString + "\"", oArguments, called, status))
+      return false;
+  }
+
+  //same as getArgumentsFromShell(): a command line which does not call showargs gives no arguments
+  return (status == 0);
+}
+
+bool getArgumentsFromSystem(const std::string & iCmdLineString, ra::strings::StringVector & oArguments)
+{
+  //evaluating the command line in a running shell is much faster than spawning a shell and showargs
+  if (getArgumentsFromShowArgsServer(iCmdLineString, oArguments))
+    return true;
+
+  //a divergence between the server and a spawned shell must not go unnoticed
+  printf("Command line '%s' failed in the showargs server, spawning a shell instead\n", iCmdLineString.c_str());
+  return getArgumentsFromShell(iCmdLineString, oArguments);
+}
+#endif //_WIN32
 
 bool getArgumentsFromCreateProcess(const std::string & iCmdline, ra::strings::StringVector & oArguments)
 {
@@ -355,6 +819,24 @@ ra::strings::StringVector toStringList(const libargvcodec::ArgumentList & argume
   return list;
 }
 
+void ArgumentCollector::onArgument(const char * iValue, size_t iLength)
+{
+  arguments.push_back(std::string(iValue, iLength));
+}
+
+bool decodeInChunks(libargvcodec::IArgumentStreamDecoder & iDecoder, const std::string & iCmdLine, size_t iChunkSize)
+{
+  for(size_t offset=0; offset<iCmdLine.size(); offset+=iChunkSize)
+  {
+    size_t length = iCmdLine.size() - offset;
+    if (length > iChunkSize)
+      length = iChunkSize;
+    if (!iDecoder.feed(iCmdLine.data() + offset, length))
+      return false;
+  }
+  return iDecoder.finish();
+}
+
 std::string buildErrorString(const std::string & iVar1, const ra::strings::StringVector & iList1, const std::string & iVar2, const ra::strings::StringVector & iList2)
 {
   std::string desc;
@@ -29,6 +29,7 @@
 #include <vector>
 
 #include "libargvcodec/ArgumentList.h"
+#include "libargvcodec/IArgumentStreamDecoder.h"
 
 #include "rapidassist/strings.h"
 
@@ -41,11 +42,28 @@ bool isDashedLine(const std::string & iLine);
 std::string getSequencedFile(const char * iPrefix, int iValue, const char * iPostfix, int iValueLength);
 
 std::string getShowArgsExecutablePath();
+std::string getToolExecutablePath(const char * iName);
+bool writeBinaryFile(const std::string & iPath, const std::string & iContent);
 bool getArgumentsFromSystem(const std::string & iCmdline, ra::strings::StringVector & oArguments);
+#ifndef _WIN32
+bool getArgumentsFromShowArgs(const ra::strings::StringVector & iArguments, ra::strings::StringVector & oArguments);
+bool runTool(const char * iName, const ra::strings::StringVector & iArguments, std::string & oOutput, int & oExitCode);
+bool getArgumentsFromShell(const std::string & iCmdline, ra::strings::StringVector & oArguments);
+bool getArgumentsFromShowArgsServer(const std::string & iCmdline, ra::strings::StringVector & oArguments);
+#endif
 bool getArgumentsFromCreateProcess(const std::string & iCmdline, ra::strings::StringVector & oArguments);
 
 ra::strings::StringVector toStringList(const libargvcodec::ArgumentList & arguments);
 
+//stream decoders support
+class ArgumentCollector : public libargvcodec::IArgumentHandler
+{
+public:
+  virtual void onArgument(const char * iValue, size_t iLength);
+  ra::strings::StringVector arguments;
+};
+bool decodeInChunks(libargvcodec::IArgumentStreamDecoder & iDecoder, const std::string & iCmdLine, size_t iChunkSize);
+
 //error string builders for ASSERT macro.
 std::string buildErrorString(const std::string & iVar1, const ra::strings::StringVector & iList1, const std::string & iVar2, const ra::strings::StringVector & iList2);
 std::string buildErrorString(const std::string & iCmdLine, const ra::strings::StringVector & iExpectedArguments, const ra::strings::StringVector & iActualArguments);